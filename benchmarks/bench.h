@@ -0,0 +1,107 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Minimal benchmark harness for the engine-independent cores.
+// Each case is timed over a number of samples; every sample runs the case
+// enough times to last roughly min_time_ms / samples.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Keeps the optimizer from deleting the benchmarked work
+template <typename T>
+inline void do_not_optimize(T const &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(p_value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &p_value;
+#endif
+}
+
+struct Options {
+    int samples = 30;
+    double min_time_ms = 300.0;
+    std::string filter;
+};
+
+struct Result {
+    std::string name;
+    uint64_t ops_per_call = 1;
+    uint64_t calls_per_sample = 0;
+    std::vector<double> ns_per_op; // one entry per sample, sorted
+
+    double percentile(double p_fraction) const {
+        if (ns_per_op.empty()) return 0.0;
+        size_t index = (size_t)(p_fraction * (ns_per_op.size() - 1) + 0.5);
+        return ns_per_op[std::min(index, ns_per_op.size() - 1)];
+    }
+
+    double mean() const {
+        double sum = 0.0;
+        for (double v : ns_per_op) sum += v;
+        return ns_per_op.empty() ? 0.0 : sum / ns_per_op.size();
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsed_ns(Clock::time_point p_start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - p_start).count();
+}
+
+// p_fn performs p_ops_per_call operations per invocation
+template <typename F>
+Result run(const Options &p_options, const std::string &p_name, uint64_t p_ops_per_call, F p_fn) {
+    Result result;
+    result.name = p_name;
+    result.ops_per_call = p_ops_per_call;
+
+    // Calibrate: double the call count until one sample is long enough
+    const double sample_ns = p_options.min_time_ms * 1e6 / p_options.samples;
+    uint64_t calls = 1;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < calls; i++) p_fn();
+        if (elapsed_ns(start) >= sample_ns || calls >= (1ull << 30)) break;
+        calls *= 2;
+    }
+    result.calls_per_sample = calls;
+
+    for (int s = 0; s < p_options.samples; s++) {
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < calls; i++) p_fn();
+        result.ns_per_op.push_back(elapsed_ns(start) / (double)(calls * p_ops_per_call));
+    }
+    std::sort(result.ns_per_op.begin(), result.ns_per_op.end());
+    return result;
+}
+
+inline std::string to_json(const std::vector<Result> &p_results) {
+    std::string out = "{\n  \"benchmarks\": [\n";
+    char line[512];
+    for (size_t i = 0; i < p_results.size(); i++) {
+        const Result &r = p_results[i];
+        double mean = r.mean();
+        snprintf(line, sizeof(line),
+                "    {\"name\": \"%s\", \"ops_per_call\": %llu, \"samples\": %zu, \"ns_per_op\": %.3f, "
+                "\"ops_per_sec\": %.1f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"min\": %.3f, \"max\": %.3f}%s\n",
+                r.name.c_str(), (unsigned long long)r.ops_per_call, r.ns_per_op.size(), mean,
+                mean > 0.0 ? 1e9 / mean : 0.0, r.percentile(0.50), r.percentile(0.95), r.percentile(0.99),
+                r.ns_per_op.empty() ? 0.0 : r.ns_per_op.front(), r.ns_per_op.empty() ? 0.0 : r.ns_per_op.back(),
+                i + 1 < p_results.size() ? "," : "");
+        out += line;
+    }
+    out += "  ]\n}\n";
+    return out;
+}
+
+} // namespace bench
+
+#endif // BENCH_H
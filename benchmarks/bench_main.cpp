@@ -0,0 +1,258 @@
+// Headless benchmarks for the engine-independent cores in src/.
+// Build and run with `scons benchmarks` (writes benchmarks/results.json), or run
+// benchmarks/bin/run_benchmarks [--filter name] [--samples N] [--min-time ms] [--out file].
+
+#include "bench.h"
+
+#include "ai_core.h"
+#include "frame_arena.h"
+#include "loose_quadtree.h"
+#include "minimap_core.h"
+#include "orbit_force.h"
+#include "orbit_predictor.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+
+using namespace godot;
+
+namespace {
+
+const int BATCH = 1024;
+
+struct Case {
+    const char *name;
+    std::function<bench::Result(const bench::Options &)> run;
+};
+
+bench::Result bench_ai_decision(const bench::Options &p_options) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(0.0f, 40.0f), hp(0.0f, 100.0f), unit(0.0f, 1.0f);
+    std::vector<float> distances(BATCH), hps(BATCH), randoms(BATCH);
+    std::vector<int> traits(BATCH), prev(BATCH);
+    const int states[] = { AI_IDLE, AI_WANDER, AI_CHASE, AI_CHARGE, AI_SPELL };
+    for (int i = 0; i < BATCH; i++) {
+        distances[i] = dist(rng);
+        hps[i] = hp(rng);
+        randoms[i] = unit(rng);
+        traits[i] = (int)(rng() % 2);
+        prev[i] = states[rng() % 5];
+    }
+
+    AttackStats stats;
+    for (int i = 0; i < AttackStats::CAPACITY; i++) stats.add(i % 3 ? AI_ATTACK_MELEE : AI_ATTACK_RANGED);
+
+    return bench::run(p_options, "ai_decide_state", BATCH, [&]() {
+        int acc = 0;
+        for (int i = 0; i < BATCH; i++) {
+            acc += ai_decide_state(prev[i], distances[i], hps[i], traits[i], 20.0f, 5.0f,
+                    stats.melee_ratio(), stats.ranged_ratio(), randoms[i]);
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+bench::Result bench_attack_stats(const bench::Options &p_options) {
+    std::mt19937 rng(99);
+    std::vector<int> attacks(BATCH);
+    for (int i = 0; i < BATCH; i++) attacks[i] = (rng() & 1) ? AI_ATTACK_MELEE : AI_ATTACK_RANGED;
+
+    AttackStats stats;
+    return bench::run(p_options, "attack_stats_add_and_ratio", BATCH, [&]() {
+        float acc = 0.0f;
+        for (int i = 0; i < BATCH; i++) {
+            stats.add(attacks[i]);
+            acc += stats.melee_ratio() - stats.ranged_ratio();
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+bench::Result bench_orbit_force(const bench::Options &p_options) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> offset(-350.0f, 350.0f);
+    std::vector<float> dx(BATCH), dy(BATCH), fx(BATCH), fy(BATCH);
+    for (int i = 0; i < BATCH; i++) {
+        dx[i] = offset(rng);
+        dy[i] = offset(rng);
+    }
+    OrbitParams params;
+
+    return bench::run(p_options, "orbit_force", BATCH, [&]() {
+        for (int i = 0; i < BATCH; i++) {
+            compute_orbit_force(dx[i], dy[i], params, fx[i], fy[i]);
+        }
+        bench::do_not_optimize(fx.data());
+        bench::do_not_optimize(fy.data());
+    });
+}
+
+// Whole trajectory preview workload: bodies * steps integration steps
+bench::Result bench_orbit_predict(const bench::Options &p_options) {
+    const int bodies = 300, steps = 120;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> offset(-250.0f, 250.0f);
+    std::vector<OrbitPredictor::BodyState> states(bodies);
+    for (OrbitPredictor::BodyState &b : states) {
+        b.px = offset(rng);
+        b.py = offset(rng);
+        b.vx = offset(rng) * 0.1f;
+        b.vy = offset(rng) * 0.1f;
+        b.gy = 9.8f;
+        b.linear_damp = 0.1f;
+    }
+    std::vector<float> segments;
+
+    return bench::run(p_options, "orbit_predict_300x120", (uint64_t)bodies * steps, [&]() {
+        OrbitPredictor::predict(states, steps, 1.0f / 60.0f, segments);
+        bench::do_not_optimize(segments.data());
+    });
+}
+
+bench::Result bench_minimap_project(const bench::Options &p_options) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> world(-100.0f, 100.0f);
+    std::vector<float> wx(BATCH), wz(BATCH), mx(BATCH), my(BATCH);
+    for (int i = 0; i < BATCH; i++) {
+        wx[i] = world(rng);
+        wz[i] = world(rng);
+    }
+
+    MinimapProjection projection;
+    projection.player_x = 3.0f;
+    projection.player_z = -4.0f;
+    projection.scale = 200.0f / 50.0f;
+    projection.center_x = projection.center_y = 100.0f;
+    projection.width = projection.height = 200.0f;
+
+    return bench::run(p_options, "minimap_project", BATCH, [&]() {
+        for (int i = 0; i < BATCH; i++) {
+            minimap_project(projection, wx[i], wz[i], mx[i], my[i]);
+        }
+        bench::do_not_optimize(mx.data());
+        bench::do_not_optimize(my.data());
+    });
+}
+
+bench::Result bench_minimap_cull(const bench::Options &p_options) {
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<float> world(-100.0f, 100.0f);
+    std::vector<float> wx(BATCH), wz(BATCH), mx(BATCH), my(BATCH);
+    std::vector<int> visible(BATCH);
+    for (int i = 0; i < BATCH; i++) {
+        wx[i] = world(rng);
+        wz[i] = world(rng);
+    }
+
+    MinimapProjection projection;
+    projection.scale = 200.0f / 50.0f;
+    projection.center_x = projection.center_y = 100.0f;
+    projection.width = projection.height = 200.0f;
+
+    return bench::run(p_options, "minimap_cull_markers", BATCH, [&]() {
+        int count = minimap_cull_markers(projection, wx.data(), wz.data(), BATCH, visible.data(), mx.data(), my.data());
+        bench::do_not_optimize(count);
+    });
+}
+
+// DebugVisualizer view query against 4096 scattered shapes
+bench::Result bench_quadtree_query(const bench::Options &p_options) {
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> pos(-8000.0f, 8000.0f), size(4.0f, 200.0f);
+    LooseQuadtree tree;
+    for (int i = 0; i < 4096; i++) {
+        LooseQuadtree::Box box;
+        box.min_x = pos(rng);
+        box.min_y = pos(rng);
+        box.max_x = box.min_x + size(rng);
+        box.max_y = box.min_y + size(rng);
+        tree.insert(box, i);
+    }
+
+    std::vector<LooseQuadtree::Box> views(64);
+    for (LooseQuadtree::Box &view : views) {
+        view.min_x = pos(rng);
+        view.min_y = pos(rng);
+        view.max_x = view.min_x + 1280.0f;
+        view.max_y = view.min_y + 720.0f;
+    }
+    std::vector<int> hits;
+    size_t next = 0;
+
+    return bench::run(p_options, "quadtree_view_query", 1, [&]() {
+        hits.clear();
+        tree.query(views[next++ % views.size()], hits);
+        bench::do_not_optimize(hits.data());
+    });
+}
+
+// MiniMap3D-style scratch arrays, one frame per call
+bench::Result bench_frame_arena(const bench::Options &p_options) {
+    FrameArena arena;
+    uint64_t frame = 0;
+
+    return bench::run(p_options, "frame_arena_scratch", 6, [&]() {
+        arena.begin_frame(frame++);
+        FrameAllocator<float> floats(arena);
+        FrameVector<float> a(BATCH, 0.0f, floats), b(BATCH, 0.0f, floats), c(BATCH, 0.0f, floats);
+        FrameVector<float> d(BATCH, 0.0f, floats), e(BATCH, 0.0f, floats), f(BATCH, 0.0f, floats);
+        bench::do_not_optimize(a.data());
+        bench::do_not_optimize(f.data());
+    });
+}
+
+const Case CASES[] = {
+    { "ai_decide_state", bench_ai_decision },
+    { "attack_stats_add_and_ratio", bench_attack_stats },
+    { "orbit_force", bench_orbit_force },
+    { "orbit_predict_300x120", bench_orbit_predict },
+    { "minimap_project", bench_minimap_project },
+    { "minimap_cull_markers", bench_minimap_cull },
+    { "quadtree_view_query", bench_quadtree_query },
+    { "frame_arena_scratch", bench_frame_arena },
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Options options;
+    const char *out_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (!strcmp(argv[i], "--samples") && i + 1 < argc) {
+            options.samples = std::max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            options.min_time_ms = std::max(1.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--filter name] [--samples N] [--min-time ms] [--out file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<bench::Result> results;
+    for (const Case &c : CASES) {
+        if (!options.filter.empty() && !strstr(c.name, options.filter.c_str())) continue;
+        results.push_back(c.run(options));
+        fprintf(stderr, "%-28s %10.3f ns/op  (p99 %.3f)\n", c.name, results.back().mean(), results.back().percentile(0.99));
+    }
+
+    std::string json = bench::to_json(results);
+    if (out_path) {
+        FILE *file = fopen(out_path, "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", out_path);
+            return 1;
+        }
+        fputs(json.c_str(), file);
+        fclose(file);
+    } else {
+        fputs(json.c_str(), stdout);
+    }
+    return 0;
+}
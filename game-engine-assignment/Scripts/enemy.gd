@@ -69,14 +69,10 @@ func deal_with_damage():
 					# Check global settings if available
 					if "Global" in get_node("/root") and Global.has_method("apply_luck_to_chance"):
 						var drop_chance = Global.apply_luck_to_chance(drop_gem_chance)
-						var rng = RandomNumberGenerator.new()
-						rng.randomize()
-						should_spawn_gem = rng.randf() <= drop_chance
+						should_spawn_gem = randf() <= drop_chance
 					else:
 						# Default chance if Global isn't available
-						var rng = RandomNumberGenerator.new()
-						rng.randomize()
-						should_spawn_gem = rng.randf() <= drop_gem_chance
+						should_spawn_gem = randf() <= drop_gem_chance
 				
 				# Always drop gems for special enemies
 				if name.to_lower().contains("boss") or name.to_lower().contains("elite"):
@@ -139,9 +135,7 @@ func spawn_gem():
 			gem_type = fixed_gem_type - 1  # Adjust for enum offset (Random is 0)
 		else:
 			# Randomize gem type with weighted probabilities
-			var rng = RandomNumberGenerator.new()
-			rng.randomize()
-			var rarity_roll = rng.randf()
+			var rarity_roll = randf()
 			
 			if rarity_roll < 0.45:  # 45% chance for purple (magic)
 				gem_type = 0
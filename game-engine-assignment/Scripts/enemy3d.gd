@@ -72,6 +72,9 @@ var decided_already = false
 
 # Called when the node enters the scene tree for the first time
 func _ready():
+	# Wander, timers and loot repeat in an InputReplay replay
+	if Engine.has_singleton("InputReplay") and Engine.get_singleton("InputReplay").is_active():
+		rng.seed = Engine.get_singleton("InputReplay").take_seed()
 	
 	# duplicate the shader
 	$skeleton_mage/Rig/Skeleton3D/Skeleton_Mage_Body.mesh.surface_set_material(
@@ -603,6 +606,7 @@ func take_damage(amount: float):
 	
 	# Reduce health
 	current_health -= amount
+	push_event(&"EVENT_DAMAGE", 0, get_instance_id(), amount)
 	
 	# Show hit effect if it exists
 	if hit_effect_scene:
@@ -634,6 +638,20 @@ func take_damage(amount: float):
 		current_health = 0
 		die()
 
+# GameEventBus event ids by constant name, looked up once; the class is only
+# referenced by name so the script still loads without the extension
+static var event_bus_types = {}
+
+# Raise a gameplay event on the native GameEventBus, when the extension is loaded
+func push_event(event_name: StringName, source_id: int, target_id: int, value: float):
+	if not Engine.has_singleton("GameEventBus"):
+		return
+	var type = event_bus_types.get(event_name, -1)
+	if type < 0:
+		type = ClassDB.class_get_integer_constant("GameEventBus", event_name)
+		event_bus_types[event_name] = type
+	Engine.get_singleton("GameEventBus").push(type, source_id, target_id, value, global_position)
+
 func update_health_bar():
 	if not health_bar or not health_bar.has_node("Viewport"):
 		return
@@ -751,6 +769,8 @@ func play_animation(anim_name: String):
 		print("Animation not found: ", actual_anim)
 
 func die():
+	push_event(&"EVENT_DEATH", get_instance_id(), 0, 0.0)
+
 	# Disable collision and physics
 	set_physics_process(false)
 	if has_node("CollisionShape3D"):
@@ -773,13 +793,9 @@ func die():
 			var drop_chance = Global.apply_luck_to_chance(drop_gem_chance)
 			
 			# Random roll for gem drop
-			var rng = RandomNumberGenerator.new()
-			rng.randomize()
 			should_spawn_gem = rng.randf() <= drop_chance
 		else:
 			# Default drop chance if Global singleton is missing or method not found
-			var rng = RandomNumberGenerator.new()
-			rng.randomize()
 			should_spawn_gem = rng.randf() <= drop_gem_chance
 	
 	# Always drop from bosses or special enemies
@@ -926,8 +942,12 @@ func spawn_gem():
 	if gem_scene:
 		print("Gem scene loaded successfully")
 		
-		# Instance the gem
-		var gem = gem_scene.instantiate()
+		# Reuse a collected gem when the pool has one; instance otherwise
+		var gem
+		if Engine.has_singleton("CollectiblePool"):
+			gem = Engine.get_singleton("CollectiblePool").acquire(gem_scene)
+		else:
+			gem = gem_scene.instantiate()
 		print("Gem instance created")
 		
 		# Use the scene as parent instead of relying on enemy's transform
@@ -946,9 +966,6 @@ func spawn_gem():
 		print("Target spawn position: " + str(spawn_position))
 		
 		# Determine gem type - weighted random selection
-		var rng = RandomNumberGenerator.new()
-		rng.randomize()
-		
 		var gem_type = 0  # Default to purple (magic)
 		
 		# Use fixed gem type if specified, otherwise use random
@@ -1016,32 +1033,31 @@ func spawn_gem():
 
 func create_gem_spawn_particles(position):
 	# This function creates particles when a gem spawns to make it more noticeable
-	var particles = CPUParticles3D.new()
-	particles.emitting = true
-	particles.one_shot = true
-	particles.explosiveness = 0.8
-	particles.amount = 16
-	particles.lifetime = 1.0
-	particles.mesh = SphereMesh.new()
-	particles.mesh.radius = 0.1
-	particles.mesh.height = 0.2
-	particles.direction = Vector3(0, 1, 0)
-	particles.spread = 45.0
-	particles.gravity = Vector3(0, -9.8, 0)
-	particles.initial_velocity_min = 2.0
-	particles.initial_velocity_max = 5.0
+	var pool = Engine.get_singleton("CollectiblePool") if Engine.has_singleton("CollectiblePool") else null
+	var particles = pool.acquire_named(&"GemSpawnParticles") if pool else null
+	if particles == null:
+		particles = CPUParticles3D.new()
+		particles.one_shot = true
+		particles.explosiveness = 0.8
+		particles.amount = 16
+		particles.lifetime = 1.0
+		particles.mesh = SphereMesh.new()
+		particles.mesh.radius = 0.1
+		particles.mesh.height = 0.2
+		particles.direction = Vector3(0, 1, 0)
+		particles.spread = 45.0
+		particles.gravity = Vector3(0, -9.8, 0)
+		particles.initial_velocity_min = 2.0
+		particles.initial_velocity_max = 5.0
 	
 	# Add to scene
 	get_tree().current_scene.add_child(particles)
 	particles.global_position = position
+	particles.restart()
 	
-	# Auto-delete after particles finish
-	var timer = Timer.new()
-	timer.wait_time = 2.0
-	timer.one_shot = true
-	timer.timeout.connect(func(): particles.queue_free())
-	particles.add_child(timer)
-	timer.start()
+	# Back to the pool (or freed) after the particles finish; this enemy may be gone by then
+	var done = pool.release_id.bind(particles.get_instance_id(), &"GemSpawnParticles") if pool else particles.queue_free
+	get_tree().create_timer(2.0).timeout.connect(done)
 
 func _handle_obstacle_collision():
 	# Debug message
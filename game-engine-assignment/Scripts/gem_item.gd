@@ -8,7 +8,12 @@ extends Area3D
 @export var hover_height: float = 0.5
 @export var hover_speed: float = 1.0
 @export var pickup_range: float = 2.0
-@export var auto_pickup: bool = false
+# Pulled in and picked up by the player's GemMagnet3D (or by this script without one)
+@export var auto_pickup: bool = false:
+	set(value):
+		auto_pickup = value
+		if is_inside_tree():
+			get_tree().call_group("GemMagnet", "add_gem" if value else "remove_gem", self)
 @export var pickup_sound: AudioStream
 
 # Gem type properties
@@ -54,6 +59,12 @@ var starting_scale = Vector3(1, 1, 1)
 var is_being_picked_up = false
 var main_material = null
 var inner_material = null
+var hover_system = null  # native HoverSystem singleton while it animates this gem
+var floor_marker: MeshInstance3D = null
+var reuse_pending = false  # parked by CollectiblePool, set up again on the next spawn
+
+const PICKUP_PARTICLES_POOL = &"GemPickupParticles"
+static var pickup_particle_materials = {}  # gem_type -> ParticleProcessMaterial
 
 func _ready():
 	# Connect signals
@@ -106,20 +117,113 @@ func _ready():
 		add_to_group("Interactable")
 	if not is_in_group("Item"):
 		add_to_group("Item")
+	
+	# Let the player's GemMagnet3D pull this gem in (and do its auto pickup)
+	add_to_group("Gem")
+	get_tree().call_group("GemMagnet", "add_gem", self)
+	
+	# Spawners move the gem after adding it; keep the native hover base in sync
+	set_notify_transform(true)
+	start_hover()
+
+func _enter_tree():
+	# _ready only runs once; a gem coming back from the pool redoes the per-spawn part
+	# after the spawner has placed and typed it
+	if reuse_pending:
+		reuse_pending = false
+		_reuse.call_deferred()
+
+func _exit_tree():
+	stop_hover()
+	get_tree().call_group("GemMagnet", "remove_gem", self)
+
+func _notification(what):
+	if what == NOTIFICATION_TRANSFORM_CHANGED:
+		if hover_system != null:
+			hover_system.refresh_item(self)
+		if auto_pickup:
+			get_tree().call_group("GemMagnet", "refresh_gem", self)
+	elif what == NOTIFICATION_PREDELETE and is_instance_valid(floor_marker):
+		floor_marker.queue_free()
+
+# CollectiblePool reset hook, called once the gem is out of the tree
+func _pool_reset():
+	is_being_picked_up = false
+	player = null
+	highlighted = false
+	hover_time = 0.0
+	scale = starting_scale
+	set_outline(false)
+	if is_instance_valid(floor_marker):
+		floor_marker.visible = false
+	reuse_pending = true
+
+func _reuse():
+	start_y_pos = global_position.y
+	time_offset = randf() * 10.0
+	item_data.gem_type = gem_type
+	item_data.effect_power = effect_power
+	update_gem_properties()
+	apply_gem_material()
+	
+	if has_node("GemLight"):
+		$GemLight.light_color = gem_colors[gem_type]
+	var beam = get_node_or_null("VerticalBeam")
+	if beam and beam.mesh.material is StandardMaterial3D:
+		beam.mesh.material.emission = gem_colors[gem_type]
+	if is_instance_valid(floor_marker):
+		floor_marker.global_position = find_floor_position()
+		floor_marker.mesh.material.emission = gem_colors[gem_type]
+		floor_marker.visible = true
+	
+	start_hover()
+	get_tree().call_group("GemMagnet", "add_gem", self)
+
+# Back to the pool when the extension is loaded, freed otherwise
+func despawn():
+	if Engine.has_singleton("CollectiblePool"):
+		Engine.get_singleton("CollectiblePool").release(self)
+	else:
+		queue_free()
+
+# Bobbing and spinning run natively when the extension is loaded: only the
+# meshes move, through the RenderingServer, and this node stays put
+func start_hover():
+	if not Engine.has_singleton("HoverSystem"):
+		return
+	var visuals = []
+	for mesh_name in ["MeshInstance3D", "InnerGem"]:
+		if has_node(mesh_name):
+			visuals.append(get_node(mesh_name))
+	if visuals.is_empty():
+		return
+	hover_system = Engine.get_singleton("HoverSystem")
+	hover_system.add_item_3d(self, visuals, hover_height, hover_speed, 0.5, time_offset)
+
+func stop_hover():
+	if hover_system != null:
+		hover_system.remove_item(self)
+		hover_system = null
+	set_physics_process(true)
+
+# HoverSystem puts gems far from the player to sleep; no auto pickup check then
+func _hover_wake_changed(awake):
+	set_physics_process(awake)
 
 func _physics_process(delta):
 	if is_being_picked_up:
 		return
 		
-	# Hovering animation
-	hover_time += delta * hover_speed
-	global_position.y = start_y_pos + sin(hover_time) * hover_height
-	
-	# Slow rotation
-	rotate_y(delta * 0.5)
+	# Hovering animation (fallback without the native HoverSystem)
+	if hover_system == null:
+		hover_time += delta * hover_speed
+		global_position.y = start_y_pos + sin(hover_time) * hover_height
+		
+		# Slow rotation
+		rotate_y(delta * 0.5)
 	
-	# Handle auto pickup if enabled
-	if auto_pickup and player != null:
+	# Handle auto pickup if enabled; a GemMagnet3D on the player does it for every gem
+	if auto_pickup and player != null and not get_tree().has_group("GemMagnet"):
 		var distance = global_position.distance_to(player.global_position)
 		if distance <= pickup_range * 2:  # Double range for auto pickup
 			pickup_item(player)
@@ -215,6 +319,7 @@ func pickup_item(player):
 		
 	is_being_picked_up = true
 	self.player = player
+	stop_hover()
 	
 	# Check if player can pick up (has inventory system)
 	if player.has_method("add_to_inventory"):
@@ -260,50 +365,61 @@ func pickup_item(player):
 			await get_tree().create_timer(0.5).timeout
 			
 			# Remove the gem from the scene
-			queue_free()
-			print("Gem successfully added to inventory and removed from scene")
+			despawn()
 		else:
 			# Failed to add to inventory
-			is_being_picked_up = false
+			_pickup_failed()
 			print("Failed to add gem to inventory - inventory might be full")
 	else:
 		# Player does not have method to add to inventory
-		is_being_picked_up = false
+		_pickup_failed()
 		print("Player does not have add_to_inventory method")
 
+# The magnet dropped this gem before asking for the pickup; hand it back so it
+# is tried again instead of being left hovering at the player
+func _pickup_failed():
+	is_being_picked_up = false
+	start_hover()
+	get_tree().call_group("GemMagnet", "add_gem", self)
+
 # Creates particle effects for gem pickup
 func create_pickup_particles(position):
 	var main_scene = get_tree().current_scene
+	var pool = Engine.get_singleton("CollectiblePool") if Engine.has_singleton("CollectiblePool") else null
+	
+	# Reuse an emitter from an earlier pickup if there is one
+	var particles = pool.acquire_named(PICKUP_PARTICLES_POOL) if pool else null
+	if particles == null:
+		particles = GPUParticles3D.new()
+		particles.name = "GemPickupParticles"
+		particles.one_shot = true
+		particles.explosiveness = 0.8
+		particles.amount = 24
+		particles.lifetime = 1.0
+		
+		# Add a mesh to particles - simple sphere
+		var mesh = SphereMesh.new()
+		mesh.radius = 0.05
+		mesh.height = 0.1
+		particles.draw_pass_1 = mesh
 	
-	# Create the particle node
-	var particles = GPUParticles3D.new()
-	particles.name = "GemPickupParticles"
-	particles.emitting = true
-	particles.one_shot = true
-	particles.explosiveness = 0.8
-	particles.global_position = position
-	particles.amount = 24
-	particles.lifetime = 1.0
-	
-	# Particles automatically remove themselves when done
-	particles.process_material = create_particle_material()
-	
-	# Add a mesh to particles - simple sphere
-	var mesh = SphereMesh.new()
-	mesh.radius = 0.05
-	mesh.height = 0.1
-	particles.draw_pass_1 = mesh
+	particles.process_material = get_particle_material()
 	
 	# Add to scene
 	main_scene.add_child(particles)
+	particles.global_position = position
+	particles.restart()
 	
-	# Self-destruct after particles finish
-	var timer = Timer.new()
-	timer.wait_time = 2.0
-	timer.one_shot = true
-	timer.autostart = true
-	particles.add_child(timer)
-	timer.timeout.connect(func(): particles.queue_free())
+	# Hand the emitter back once the burst is over. The gem may be gone by then,
+	# so the callback must not belong to it
+	var done = pool.release_id.bind(particles.get_instance_id(), PICKUP_PARTICLES_POOL) if pool else particles.queue_free
+	get_tree().create_timer(2.0).timeout.connect(done)
+
+# One process material per gem type, shared by every pickup
+func get_particle_material():
+	if not pickup_particle_materials.has(gem_type):
+		pickup_particle_materials[gem_type] = create_particle_material()
+	return pickup_particle_materials[gem_type]
 
 # Creates a particle material based on gem type
 func create_particle_material():
@@ -341,12 +457,23 @@ func get_player_in_range():
 			return body
 	return null
 
+# Outline in the gem's color through the shared OutlineManager material
+func set_outline(enable: bool):
+	if not Engine.has_singleton("OutlineManager") or not has_node("MeshInstance3D"):
+		return
+	var outlines = Engine.get_singleton("OutlineManager")
+	if enable:
+		outlines.add_outline($MeshInstance3D, gem_colors[gem_type], 1.5)
+	else:
+		outlines.remove_outline($MeshInstance3D)
+
 # Optional method to highlight when player is near
 func highlight(enable: bool = true):
 	if highlighted == enable:
 		return
 	
 	highlighted = enable
+	set_outline(enable)
 	
 	if enable:
 		# Scale up slightly
@@ -436,26 +563,11 @@ func create_floor_marker():
 	circle.material = material
 	marker.mesh = circle
 	
-	# Cast ray to find floor position
-	var space_state = get_world_3d().direct_space_state
-	var ray_origin = global_position
-	var ray_end = ray_origin + Vector3(0, -50, 0)  # Cast ray downward
-	
-	var query = PhysicsRayQueryParameters3D.create(ray_origin, ray_end)
-	query.collide_with_areas = false
-	query.collide_with_bodies = true
-	
-	var result = space_state.intersect_ray(query)
-	
-	if result:
-		# Place marker at hit position, slightly above to prevent z-fighting
-		marker.global_position = result.position + Vector3(0, 0.05, 0)
-	else:
-		# If no floor found, place marker at a fixed distance below
-		marker.global_position = global_position + Vector3(0, -5, 0)
+	marker.global_position = find_floor_position()
 	
 	# Add marker to scene (not as child of gem)
 	get_tree().current_scene.add_child(marker)
+	floor_marker = marker
 	
 	# Animate the marker to pulse
 	var tween = create_tween()
@@ -485,3 +597,21 @@ func create_beacon_effect():
 		var beam_material = beam.mesh.material
 		tween.tween_property(beam_material, "emission_energy_multiplier", 5.0, 1.0)
 		tween.tween_property(beam_material, "emission_energy_multiplier", 2.0, 1.0) 
+
+# Cast a ray down to find where the floor marker goes
+func find_floor_position():
+	var space_state = get_world_3d().direct_space_state
+	var ray_origin = global_position
+	var ray_end = ray_origin + Vector3(0, -50, 0)  # Cast ray downward
+	
+	var query = PhysicsRayQueryParameters3D.create(ray_origin, ray_end)
+	query.collide_with_areas = false
+	query.collide_with_bodies = true
+	
+	var result = space_state.intersect_ray(query)
+	
+	if result:
+		# Slightly above the hit position to prevent z-fighting
+		return result.position + Vector3(0, 0.05, 0)
+	# If no floor found, a fixed distance below
+	return global_position + Vector3(0, -5, 0)
@@ -9,7 +9,18 @@ extends Area3D
 var direction: Vector3 = Vector3.FORWARD
 var shooter = null
 
+# Counted by the native FrameRecorder
+func _enter_tree():
+	if Engine.has_singleton("FrameRecorder"):
+		Engine.get_singleton("FrameRecorder").add_projectiles(1)
+
+func _exit_tree():
+	if Engine.has_singleton("FrameRecorder"):
+		Engine.get_singleton("FrameRecorder").add_projectiles(-1)
+
 func _ready():
+	add_to_group("Projectile")
+	
 	# Set visual effects
 	if has_node("MeshInstance3D"):
 		# Add emission to make it glow
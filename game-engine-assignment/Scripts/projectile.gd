@@ -6,7 +6,18 @@ extends RayCast3D
 
 @onready var remote_transform = RemoteTransform3D.new()
 
+# Counted by the native FrameRecorder
+func _enter_tree():
+	if Engine.has_singleton("FrameRecorder"):
+		Engine.get_singleton("FrameRecorder").add_projectiles(1)
+
+func _exit_tree():
+	if Engine.has_singleton("FrameRecorder"):
+		Engine.get_singleton("FrameRecorder").add_projectiles(-1)
+
 func _ready():
+	add_to_group("Projectile")
+	
 	# Set collision mask to properly detect enemies (layer 2)
 	set_collision_mask_value(1, true)  # Default layer (world)
 	set_collision_mask_value(2, true)  # Enemy layer
@@ -66,6 +66,24 @@ var inventory_system
 var pickup_range: float = 2.5
 var interactable_items = []
 
+# Native input snapshot (InputSnapshot), polled once per physics tick for everyone;
+# null when the extension isn't loaded and Input is read directly
+var input_snapshot
+var move_vector: int = -1
+var sprint_action: int = -1
+var crouch_action: int = -1
+var jump_action: int = -1
+var shoot_action: int = -1
+# Native InputLatency, told when input arrives and when it moved us
+var input_latency
+var latency_moving := false
+# Native InputReplay; while it replays, look and the inventory/interact keys come
+# from the recorded per-tick commands instead of _unhandled_input
+var input_replay
+var input_buffer
+var inventory_action: int = -1
+var interact_action: int = -1
+
 func _ready() -> void:
 	Input.mouse_mode = Input.MOUSE_MODE_CAPTURED
 	
@@ -93,6 +111,12 @@ func _ready() -> void:
 	if not is_in_group("Player"):
 		add_to_group("Player")
 	
+	# Native gem magnet: pulls nearby gems in and picks them up
+	if !has_node("GemMagnet3D") and ClassDB.class_exists("GemMagnet3D"):
+		var magnet = ClassDB.instantiate("GemMagnet3D")
+		magnet.name = "GemMagnet3D"
+		add_child(magnet)
+	
 	# Set up inventory system
 	setup_inventory()
 	
@@ -112,13 +136,18 @@ func _ready() -> void:
 		
 	# Set up input actions
 	ensure_input_actions_exist()
+	setup_input_snapshot()
 
 func _unhandled_input(event):
+	if is_replaying():
+		return
 	if event is InputEventMouseMotion:
 		if can_move:
-			rotate_y(-event.relative.x * .005)
-			$Head.rotate_x(-event.relative.y * .005)
-			$Head.rotation.x = clamp($Head.rotation.x, -PI/2, PI/2)
+			if input_latency:
+				input_latency.mark_input()
+			apply_look(event.relative)
+			if input_latency:
+				input_latency.mark_motion()
 	
 	# Toggle inventory with key press but only on press, not release
 	if event.is_action_pressed(input_inventory) and not event.is_echo():
@@ -130,7 +159,28 @@ func _unhandled_input(event):
 	if event.is_action_pressed(input_interact):
 		interact_with_nearby_object()
 
+func apply_look(relative: Vector2):
+	rotate_y(-relative.x * .005)
+	$Head.rotate_x(-relative.y * .005)
+	$Head.rotation.x = clamp($Head.rotation.x, -PI/2, PI/2)
+
+func is_replaying() -> bool:
+	return input_replay != null and input_replay.is_replaying()
+
+# What _unhandled_input does live, from the recorded command for this tick
+func apply_replayed_input():
+	var look = input_buffer.get_look()
+	if can_move and look != Vector2.ZERO:
+		apply_look(look)
+	if action_just_pressed(inventory_action, input_inventory):
+		toggle_inventory()
+	if action_just_pressed(interact_action, input_interact):
+		interact_with_nearby_object()
+
 func _physics_process(delta):
+	if is_replaying():
+		apply_replayed_input()
+
 	if health_bar and crosshair_ui:
 		update_health_ui()
 	
@@ -143,11 +193,11 @@ func _physics_process(delta):
 	
 	if can_move:
 		# Get the input direction
-		var input_dir = Input.get_vector(input_left, input_right, input_forward, input_backward)
+		var input_dir = get_move_vector()
 		var direction = (transform.basis * Vector3(input_dir.x, 0, input_dir.y)).normalized()
 		
 		# Sprinting
-		if Input.is_action_pressed(input_sprint) and can_sprint and sprint_meter > 0 and not is_crouching:
+		if action_pressed(sprint_action, input_sprint) and can_sprint and sprint_meter > 0 and not is_crouching:
 			is_sprinting = true
 			sprint_meter -= sprint_cost * delta
 			if sprint_meter < 0:
@@ -161,7 +211,7 @@ func _physics_process(delta):
 				sprint_meter = 100
 		
 		# Crouching
-		if Input.is_action_pressed(input_crouch) and can_crouch:
+		if action_pressed(crouch_action, input_crouch) and can_crouch:
 			is_crouching = true
 			cur_height = -crouch_height
 		else:
@@ -186,6 +236,8 @@ func _physics_process(delta):
 			cur_speed = forward_speed * side_speed_multiplier * cur_speed_multiplier
 		
 		# Apply movement
+		if input_latency:
+			latency_moving = input_latency.mark_movement(latency_moving, direction.length())
 		if direction:
 			velocity.x = direction.x * cur_speed
 			velocity.z = direction.z * cur_speed
@@ -194,18 +246,56 @@ func _physics_process(delta):
 			velocity.z = move_toward(velocity.z, 0, cur_speed)
 	
 		# Jumping
-		if Input.is_action_just_pressed(input_jump) and is_on_floor() and can_jump:
+		if action_just_pressed(jump_action, input_jump) and is_on_floor() and can_jump:
 			velocity.y = jump_strength
 	
 	move_and_slide()
 	
 	# Handle shooting
-	if Input.is_action_pressed(input_shoot):
+	if action_pressed(shoot_action, input_shoot):
 		shoot()
 		
 	# Check for nearby interactables
 	check_for_interactables()
 
+# Registers the actions read every tick, after ensure_input_actions_exist has made them
+func setup_input_snapshot():
+	# Key events get stamped for InputLatency by the buffer's listener
+	if Engine.has_singleton("InputLatency"):
+		input_latency = Engine.get_singleton("InputLatency")
+	if Engine.has_singleton("InputBuffer"):
+		input_buffer = Engine.get_singleton("InputBuffer")
+		input_buffer.listen()
+		if Engine.has_singleton("InputReplay"):
+			input_replay = Engine.get_singleton("InputReplay")
+
+	if not Engine.has_singleton("InputSnapshot"):
+		return
+	input_snapshot = Engine.get_singleton("InputSnapshot")
+	move_vector = input_snapshot.register_vector(input_left, input_right, input_forward, input_backward)
+	sprint_action = input_snapshot.register_action(input_sprint)
+	crouch_action = input_snapshot.register_action(input_crouch)
+	jump_action = input_snapshot.register_action(input_jump)
+	shoot_action = input_snapshot.register_action(input_shoot)
+	# Only read from the snapshot under replay, but registered so recordings carry them
+	inventory_action = input_snapshot.register_action(input_inventory)
+	interact_action = input_snapshot.register_action(input_interact)
+
+func get_move_vector() -> Vector2:
+	if input_snapshot and move_vector >= 0:
+		return input_snapshot.get_vector(move_vector)
+	return Input.get_vector(input_left, input_right, input_forward, input_backward)
+
+func action_pressed(index: int, action: String) -> bool:
+	if input_snapshot and index >= 0:
+		return input_snapshot.is_pressed_index(index)
+	return Input.is_action_pressed(action)
+
+func action_just_pressed(index: int, action: String) -> bool:
+	if input_snapshot and index >= 0:
+		return input_snapshot.is_just_pressed_index(index)
+	return Input.is_action_just_pressed(action)
+
 func setup_inventory():
 	# Create inventory system if it doesn't exist
 	if !has_node("InventorySystem"):
@@ -769,6 +859,11 @@ func apply_shield(amount):
 		tween.tween_property(effect, "color", Color(0.2, 0.4, 1.0, 0.3), 0.2)
 		tween.tween_property(effect, "color", Color(0.2, 0.4, 1.0, 0), 0.5)
 
+# Speed and Luck boosts also widen the gem pickup radius while they last
+func scale_magnet_radius(factor):
+	if has_node("GemMagnet3D"):
+		$GemMagnet3D.radius_multiplier *= factor
+
 # Apply temporary speed boost
 func apply_speed_boost(multiplier, duration):
 	# Store original speed
@@ -776,6 +871,7 @@ func apply_speed_boost(multiplier, duration):
 	
 	# Apply speed boost
 	forward_speed *= multiplier
+	scale_magnet_radius(multiplier)
 	
 	# Visual effect
 	if has_node("PlayerUI"):
@@ -798,6 +894,7 @@ func apply_speed_boost(multiplier, duration):
 	timer.timeout.connect(func():
 		# Reset speed
 		forward_speed = original_speed
+		scale_magnet_radius(1.0 / multiplier)
 		
 		# Hide speed effect
 		if has_node("PlayerUI") and $PlayerUI.has_node("SpeedEffect"):
@@ -809,6 +906,7 @@ func apply_luck_boost(multiplier, duration):
 	# Set a global luck multiplier
 	# This would be checked when determining loot drops
 	Global.luck_multiplier = multiplier
+	scale_magnet_radius(multiplier)
 	
 	# Visual effect
 	if has_node("PlayerUI"):
@@ -835,6 +933,7 @@ func apply_luck_boost(multiplier, duration):
 	timer.timeout.connect(func():
 		# Reset luck multiplier
 		Global.luck_multiplier = 1.0
+		scale_magnet_radius(1.0 / multiplier)
 		
 		# Hide luck indicator
 		if has_node("PlayerUI") and $PlayerUI.has_node("LuckIndicator"):
@@ -0,0 +1,132 @@
+#ifndef AI_CORE_H
+#define AI_CORE_H
+
+// Engine-independent AI decision logic used by AIOrchestrator.
+// Kept free of Godot types so the benchmarks can run it without the engine.
+
+namespace godot {
+
+// Enemy states (values match AIOrchestrator's bound constants)
+enum AIState {
+    AI_IDLE = 0,
+    AI_WANDER = 1,
+    AI_CHASE = 2,
+    AI_CHARGE = 4,
+    AI_SPELL = 8,
+    AI_FLEE = 16
+};
+
+// Player attack types
+enum AIAttack {
+    AI_ATTACK_MELEE = 1,
+    AI_ATTACK_RANGED = 2
+};
+
+// Cyclic buffer of the player's last attacks. Counts are kept up to date on
+// insert, so the ratios are O(1) instead of a scan per decision.
+class AttackStats {
+public:
+    static const int CAPACITY = 20;
+
+    // Returns false for an unknown attack type
+    bool add(int p_attack_type) {
+        if (p_attack_type != AI_ATTACK_MELEE && p_attack_type != AI_ATTACK_RANGED) {
+            return false;
+        }
+
+        // Overwriting the oldest entry once full
+        if (count == CAPACITY) {
+            _forget(buffer[index]);
+        } else {
+            count++;
+        }
+        buffer[index] = p_attack_type;
+        if (p_attack_type == AI_ATTACK_MELEE) melee_count++;
+        else ranged_count++;
+
+        index = (index + 1) % CAPACITY;
+        return true;
+    }
+
+    void clear() {
+        for (int i = 0; i < CAPACITY; i++) buffer[i] = 0;
+        index = 0;
+        count = 0;
+        melee_count = 0;
+        ranged_count = 0;
+    }
+
+    // Smoothed towards 0.5 while there is little data
+    float melee_ratio() const {
+        if (count == 0) return 0.5f;
+        return static_cast<float>(melee_count + 5.0) / (count + 10.0);
+    }
+
+    float ranged_ratio() const {
+        if (count == 0) return 0.5f;
+        return static_cast<float>(ranged_count + 5.0) / (count + 10.0);
+    }
+
+    int size() const { return count; }
+
+private:
+    void _forget(int p_attack_type) {
+        if (p_attack_type == AI_ATTACK_MELEE) melee_count--;
+        else if (p_attack_type == AI_ATTACK_RANGED) ranged_count--;
+    }
+
+    int buffer[CAPACITY] = {};
+    int index = 0;
+    int count = 0;
+    int melee_count = 0;
+    int ranged_count = 0;
+};
+
+// Picks the next enemy state. p_random is a uniform value in [0, 1].
+inline int ai_decide_state(int prev_state, float dist_to_player, float hp, int trait,
+        float chase_range, float attack_range, float melee_ratio, float ranged_ratio, float p_random) {
+    if (prev_state == AI_FLEE) {
+        return AI_FLEE;
+    }
+
+    // Base probabilities for different states
+    float p_idle = 0.0f;
+    float p_wander = 0.0f;
+    float p_chase = 0.0f;
+    float p_charge = 0.0f;
+    float p_spell = 0.0f;
+    float p_flee = 0.0f;
+
+    // trait == 1 has ability to flee
+    if (trait == 1 && hp < 50) {
+        p_flee = 1.0f;
+    } else if (dist_to_player > chase_range) {
+        p_wander = 1.0f;
+    } else if (dist_to_player < attack_range) {
+        p_charge = ranged_ratio * 0.4f;         // more charges against ranged players
+        p_spell = 0.3f + (melee_ratio * 0.3f);  // default attack, more likely against melee
+    } else {
+        p_chase = 1.0f;
+    }
+
+    // Walk the cumulative distribution without normalizing every entry
+    const float total = p_idle + p_wander + p_chase + p_charge + p_spell + p_flee;
+    const float target = p_random * total;
+    const int state_values[] = { AI_IDLE, AI_WANDER, AI_CHASE, AI_CHARGE, AI_SPELL, AI_FLEE };
+    const float probs[] = { p_idle, p_wander, p_chase, p_charge, p_spell, p_flee };
+
+    float cumulative = 0.0f;
+    for (int i = 0; i < 6; i++) {
+        cumulative += probs[i];
+        if (target <= cumulative) {
+            return state_values[i];
+        }
+    }
+
+    // Rounding fallback
+    return AI_SPELL;
+}
+
+} // namespace godot
+
+#endif // AI_CORE_H
@@ -3,6 +3,10 @@
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/random_number_generator.hpp>
 
+#include "input_replay.h"
+#include "native_stats.h"
+#include "profile_zone.h"
+
 using namespace godot;
 
 // Register methods and properties for the class
@@ -28,16 +32,14 @@ void AIOrchestrator::_bind_methods() {
 
 // Constructor
 AIOrchestrator::AIOrchestrator() {
-    // Initialize the attack buffer with zeros
-    for (int i = 0; i < MAX_ATTACK_BUFFER_SIZE; i++) {
-        player_attack_buffer[i] = 0;
-    }
-    attack_buffer_index = 0;
-    attack_buffer_count = 0;
-    
     // Initialize random number generator
     rng.instantiate();
-    rng->randomize(); // Use a different seed each time
+    InputReplay *replay = InputReplay::get_singleton();
+    if (replay && replay->is_active()) {
+        rng->set_seed((uint64_t)replay->take_seed()); // Same decisions when the input is replayed
+    } else {
+        rng->randomize(); // Use a different seed each time
+    }
 }
 
 // Destructor
@@ -48,118 +50,32 @@ AIOrchestrator::~AIOrchestrator() {
 // Add a player attack to the cyclic buffer
 void AIOrchestrator::add_player_attack(int attack_type) {
     // Only accept valid attack types (1 for melee, 2 for ranged)
-    if (attack_type != ATTACK_MELEE && attack_type != ATTACK_RANGED) {
+    if (!attack_stats.add(attack_type)) {
         UtilityFunctions::printerr("Invalid attack type! Use 1 for melee or 2 for ranged.");
-        return;
-    }
-    
-    // Add to buffer
-    player_attack_buffer[attack_buffer_index] = attack_type;
-    
-    // Update index and count
-    attack_buffer_index = (attack_buffer_index + 1) % MAX_ATTACK_BUFFER_SIZE;
-    if (attack_buffer_count < MAX_ATTACK_BUFFER_SIZE) {
-        attack_buffer_count++;
     }
 }
 
 // Clear the attack buffer
 void AIOrchestrator::clear_attack_buffer() {
-    for (int i = 0; i < MAX_ATTACK_BUFFER_SIZE; i++) {
-        player_attack_buffer[i] = 0;
-    }
-    attack_buffer_index = 0;
-    attack_buffer_count = 0;
+    attack_stats.clear();
 }
 
-// Calculate the ratio of melee attacks in the buffer
+// Ratio of melee attacks in the buffer
 float AIOrchestrator::get_melee_ratio() const {
-    if (attack_buffer_count == 0) return 0.5f; // Default to balanced if no data
-    
-    int melee_count = 0;
-    for (int i = 0; i < attack_buffer_count; i++) {
-        if (player_attack_buffer[i] == ATTACK_MELEE) {
-            melee_count++;
-        }
-    }
-    
-    return static_cast<float>(melee_count + 5.0) / (attack_buffer_count + 10.0);
+    return attack_stats.melee_ratio();
 }
 
-// Calculate the ratio of ranged attacks in the buffer
+// Ratio of ranged attacks in the buffer
 float AIOrchestrator::get_ranged_ratio() const {
-    if (attack_buffer_count == 0) return 0.5f; // Default to balanced if no data
-    
-    int ranged_count = 0;
-    for (int i = 0; i < attack_buffer_count; i++) {
-        if (player_attack_buffer[i] == ATTACK_RANGED) {
-            ranged_count++;
-        }
-    }
-    
-    return static_cast<float>(ranged_count + 5.0) / (attack_buffer_count + 10.0);
+    return attack_stats.ranged_ratio();
 }
 
 // Determine the next enemy state based on various factors
 int AIOrchestrator::next_enemy_state(int prev_state, float dist_to_player, float hp, int trait, float chase_range, float attack_range) const {
-    // Get attack ratios
-    float ranged_ratio = get_ranged_ratio();
-    float melee_ratio = get_melee_ratio();
-    
-    // Base probabilities for different states
-    float p_idle = 0.00f;
-    float p_wander = 0.00f;
-    float p_chase = 0.0f;
-    float p_charge = 0.0f;
-    float p_spell = 0.0f;
-    float p_flee = 0.0f;
+    PROFILE_ZONE("AIOrchestrator::next_enemy_state");
+    NativeStats::add(NativeStats::AI_DECISIONS);
+    ScopedStatTimer decision_timer(NativeStats::AI_DECISION_NSEC);
 
-    if (prev_state == FLEE) {
-        return FLEE;
-    }
-    // trait == 1 has ability to flee
-    if (trait == 1 && hp < 50) {
-        p_flee = 1.0f;
-        // p_charge = 0.0f + (ranged_ratio * 0.1f); // Increase chance of charge if player uses ranged attacks
-        // p_spell = 0.3f + (melee_ratio * 0.3f);   // Default attack, slightly more likely if player uses melee
-    } else if (trait == 1 && hp < 25) {
-        p_flee = 1.0f;
-    } else if (dist_to_player > chase_range) {
-        p_wander = 1.0f;
-    } else if (dist_to_player < attack_range) {
-        p_charge = 0.0f + (ranged_ratio * 0.4f); // Increase chance of charge if player uses ranged attacks
-        p_spell = 0.3f + (melee_ratio * 0.3f);   // Default attack, slightly more likely if player uses melee
-    } else {
-        // chase
-        p_chase = 1.0f;
-    }
-    
-    
-    // Normalize probabilities to sum to 1.0
-    float total = p_idle + p_wander + p_chase + p_charge + p_spell + p_flee;
-    p_idle /= total;
-    p_wander /= total;
-    p_chase /= total;
-    p_charge /= total;
-    p_spell /= total;
-    p_flee /= total;
-    
-    // Create a probability table for state selection
-    float cumulative_prob = 0.0f;
-    float random_val = rng->randf(); // Generate random value between 0 and 1
-    
-    // State values in order
-    const int state_values[] = {IDLE, WANDER, CHASE, CHARGE, SPELL, FLEE};
-    const float probs[] = {p_idle, p_wander, p_chase, p_charge, p_spell, p_flee};
-    
-    // Select state based on probability
-    for (int i = 0; i < 6; i++) {
-        cumulative_prob += probs[i];
-        if (random_val <= cumulative_prob) {
-            return state_values[i];
-        }
-    }
-    
-    // Fallback (should rarely happen due to normalized probabilities)
-    return SPELL;
-}
\ No newline at end of file
+    return ai_decide_state(prev_state, dist_to_player, hp, trait, chase_range, attack_range,
+            attack_stats.melee_ratio(), attack_stats.ranged_ratio(), rng->randf());
+}
@@ -4,16 +4,16 @@
 #include <godot_cpp/classes/node3d.hpp>
 #include <godot_cpp/classes/random_number_generator.hpp>
 
+#include "ai_core.h"
+
 namespace godot {
 
 class AIOrchestrator : public Node3D {
     GDCLASS(AIOrchestrator, Node3D)
 
 private:
-    static const int MAX_ATTACK_BUFFER_SIZE = 20;
-    int player_attack_buffer[MAX_ATTACK_BUFFER_SIZE];
-    int attack_buffer_index;
-    int attack_buffer_count;
+    // Last player attacks; the decision logic itself lives in ai_core.h
+    AttackStats attack_stats;
     
     // Godot's random number generator
     mutable Ref<RandomNumberGenerator> rng;
@@ -24,18 +24,18 @@ protected:
 public:
     // Enemy states
     enum {
-        IDLE = 0,
-        WANDER = 1,
-        CHASE = 2,
-        CHARGE = 4,
-        SPELL = 8,
-        FLEE = 16
+        IDLE = AI_IDLE,
+        WANDER = AI_WANDER,
+        CHASE = AI_CHASE,
+        CHARGE = AI_CHARGE,
+        SPELL = AI_SPELL,
+        FLEE = AI_FLEE
     };
     
     // Player attack types
     enum {
-        ATTACK_MELEE = 1,
-        ATTACK_RANGED = 2
+        ATTACK_MELEE = AI_ATTACK_MELEE,
+        ATTACK_RANGED = AI_ATTACK_RANGED
     };
 
     AIOrchestrator();
@@ -1,6 +1,6 @@
 #include "automover.h"
 #include <godot_cpp/core/class_db.hpp>
-#include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/input.hpp>
 #include <godot_cpp/classes/viewport.hpp>
 #include <godot_cpp/classes/area2d.hpp>
@@ -8,10 +8,18 @@
 #include <godot_cpp/classes/scene_tree.hpp>
 #include <godot_cpp/classes/node.hpp>
 
+#include "game_event_bus.h"
+#include "mover_server.h"
+
 using namespace godot;
 
 void AutoMover::_bind_methods() {
     ClassDB::bind_method(D_METHOD("_on_area_entered", "other_area"), &AutoMover::_on_area_entered);
+    ClassDB::bind_method(D_METHOD("_on_game_won", "type", "source_id", "target_id", "value", "position"), &AutoMover::_on_game_won);
+
+    ClassDB::bind_method(D_METHOD("set_use_mover_server", "use"), &AutoMover::set_use_mover_server);
+    ClassDB::bind_method(D_METHOD("get_use_mover_server"), &AutoMover::get_use_mover_server);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_mover_server"), "set_use_mover_server", "get_use_mover_server");
 }
 
 AutoMover::AutoMover() {
@@ -20,9 +28,55 @@ AutoMover::AutoMover() {
 AutoMover::~AutoMover() {
 }
 
+void AutoMover::set_use_mover_server(bool p_use) {
+    use_mover_server = p_use;
+}
+
+bool AutoMover::get_use_mover_server() const {
+    return use_mover_server;
+}
+
 void AutoMover::_ready() {
     // Connect the built-in "area_entered" signal
     connect("area_entered", Callable(this, "_on_area_entered"));
+    _start_patrol();
+}
+
+void AutoMover::_enter_tree() {
+    if (Engine::get_singleton()->is_editor_hint()) {
+        return;
+    }
+    GameEventBus *bus = GameEventBus::get_singleton();
+    if (bus) {
+        bus->subscribe(GameEventBus::EVENT_WIN, Callable(this, "_on_game_won"));
+    }
+
+    // Re-added after a reparent; the first time round _ready does it
+    if (is_node_ready()) {
+        _start_patrol();
+    }
+}
+
+// Same patrol as _physics_process below, stepped together with every other mover
+void AutoMover::_start_patrol() {
+    KinematicMoverServer *server = KinematicMoverServer::get_singleton();
+    if (use_mover_server && server && !Engine::get_singleton()->is_editor_hint()) {
+        const float y = get_position().y;
+        server->add_ping_pong(this, Vector2(left_limit + 1, y), Vector2(right_limit - 1, y), speed);
+        set_physics_process(false);
+    }
+}
+
+void AutoMover::_exit_tree() {
+    GameEventBus *bus = GameEventBus::get_singleton();
+    if (bus) {
+        bus->unsubscribe(GameEventBus::EVENT_WIN, Callable(this, "_on_game_won"));
+    }
+
+    KinematicMoverServer *server = KinematicMoverServer::get_singleton();
+    if (server) {
+        server->remove_mover(this, true);
+    }
 }
 
 void AutoMover::_physics_process(double delta) {
@@ -61,24 +115,37 @@ void AutoMover::_on_area_entered(Area2D *other_area) {
     other_area->queue_free();
     score++;
 
-    UtilityFunctions::print("Block passed through! Score is now: ", score);
+    // This runs inside the physics callback; the win itself is handled when the bus drains
+    GameEventBus *bus = GameEventBus::get_singleton();
+    if (!bus) {
+        if (score == win_threshold) {
+            _on_game_won(GameEventBus::EVENT_WIN, get_instance_id(), 0, score, Vector3());
+        }
+        return;
+    }
+    const Vector2 pos = get_global_position();
+    bus->push(GameEventBus::EVENT_SCORE, get_instance_id(), other_area->get_instance_id(), 1.0f, Vector3(pos.x, pos.y, 0.0f));
+    if (score == win_threshold) {
+        bus->push(GameEventBus::EVENT_WIN, get_instance_id(), 0, (float)score, Vector3(pos.x, pos.y, 0.0f));
+    }
+}
 
-    // Check for win condition
-    if (score >= win_threshold) {
-        UtilityFunctions::print("YOU WIN!");
+void AutoMover::_on_game_won(int type, int64_t source_id, int64_t target_id, float value, const Vector3 &position) {
+    if ((uint64_t)source_id != get_instance_id()) {
+        return;
+    }
 
-        // Display "YOU WIN!" on screen
-        Label *win_label = get_node<Label>("/root/Main/WinLabel");
-        if (win_label) {
-            win_label->set_visible(true);
-            win_label->set_text("YOU WIN!");
-        }
+    // Display "YOU WIN!" on screen
+    Label *win_label = get_node<Label>("/root/Main/WinLabel");
+    if (win_label) {
+        win_label->set_visible(true);
+        win_label->set_text("YOU WIN!");
+    }
 
-        // Pause the game
-        SceneTree *tree = get_tree();
-        if (tree) {
-            tree->set("paused", true);
-            // Alternatively: tree->call("set_paused", true);
-        }
+    // Pause the game
+    SceneTree *tree = get_tree();
+    if (tree) {
+        tree->set("paused", true);
+        // Alternatively: tree->call("set_paused", true);
     }
 }
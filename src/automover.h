@@ -17,15 +17,25 @@ private:
     float right_limit = 800.0f;
     int score = 0;             // track player score
     int win_threshold = 20;    // once score reaches this, game is won
+    bool use_mover_server = true; // let KinematicMoverServer do the patrol
+
+    void _start_patrol();
 
 public:
     AutoMover();
     ~AutoMover();
 
+    void set_use_mover_server(bool p_use);
+    bool get_use_mover_server() const;
+
     void _ready() override;
+    void _enter_tree() override;
+    void _exit_tree() override;
     void _physics_process(double delta) override;
 
     void _on_area_entered(Area2D *other_area);
+    // GameEventBus EVENT_WIN subscriber
+    void _on_game_won(int type, int64_t source_id, int64_t target_id, float value, const Vector3 &position);
 };
 
 } // namespace godot
@@ -0,0 +1,239 @@
+#include "collectible_pool.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include "native_stats.h"
+
+using namespace godot;
+
+CollectiblePool *CollectiblePool::singleton = nullptr;
+
+void CollectiblePool::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_high_water_mark", "count"), &CollectiblePool::set_high_water_mark);
+    ClassDB::bind_method(D_METHOD("get_high_water_mark"), &CollectiblePool::get_high_water_mark);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "high_water_mark"), "set_high_water_mark", "get_high_water_mark");
+
+    ClassDB::bind_method(D_METHOD("acquire", "scene"), &CollectiblePool::acquire);
+    ClassDB::bind_method(D_METHOD("acquire_named", "key"), &CollectiblePool::acquire_named);
+    ClassDB::bind_method(D_METHOD("release", "node", "key"), &CollectiblePool::release, DEFVAL(StringName()));
+    ClassDB::bind_method(D_METHOD("release_id", "id", "key"), &CollectiblePool::release_id, DEFVAL(StringName()));
+    ClassDB::bind_method(D_METHOD("prewarm", "scene", "count"), &CollectiblePool::prewarm);
+    ClassDB::bind_method(D_METHOD("get_free_count", "key"), &CollectiblePool::get_free_count);
+    ClassDB::bind_method(D_METHOD("get_peak_count", "key"), &CollectiblePool::get_peak_count);
+    ClassDB::bind_method(D_METHOD("clear"), &CollectiblePool::clear);
+    ClassDB::bind_method(D_METHOD("_park", "id"), &CollectiblePool::_park);
+}
+
+CollectiblePool *CollectiblePool::get_singleton() {
+    return singleton;
+}
+
+CollectiblePool::CollectiblePool() {
+    singleton = this;
+}
+
+CollectiblePool::~CollectiblePool() {
+    // Parked nodes are normally freed when the scene tree shuts down (see _watch_tree)
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void CollectiblePool::set_high_water_mark(int p_count) {
+    high_water_mark = MAX(p_count, 0);
+}
+
+int CollectiblePool::get_high_water_mark() const {
+    return high_water_mark;
+}
+
+int CollectiblePool::_find_pool(const StringName &p_key) const {
+    for (int i = 0; i < (int)pools.size(); i++) {
+        if (pools[i].key == p_key) return i;
+    }
+    return -1;
+}
+
+int CollectiblePool::_pool_for_key(const StringName &p_key, const Ref<PackedScene> &p_scene) {
+    int index = _find_pool(p_key);
+    if (index < 0) {
+        index = (int)pools.size();
+        pools.push_back(Pool());
+        pools[index].key = p_key;
+    }
+    if (pools[index].scene.is_null()) {
+        pools[index].scene = p_scene;
+    }
+    return index;
+}
+
+StringName CollectiblePool::_scene_key(const Ref<PackedScene> &p_scene) {
+    const String path = p_scene->get_path();
+    return path.is_empty() ? StringName("PackedScene:" + String::num_uint64(p_scene->get_instance_id())) : StringName(path);
+}
+
+Node *CollectiblePool::_pop(int p_pool) {
+    std::vector<uint64_t> &free_ids = pools[p_pool].free_ids;
+    while (!free_ids.empty()) {
+        const uint64_t id = free_ids.back();
+        free_ids.pop_back();
+        // Skip nodes somebody freed or re-parented behind the pool's back
+        Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+        if (node && !node->get_parent()) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void CollectiblePool::_watch_tree() {
+    if (watching_tree) return;
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || !tree->get_root()) return;
+
+    // Detached nodes are not freed with the tree; free them while their scripts still exist
+    const Callable on_exit(this, "clear");
+    if (!tree->get_root()->is_connected("tree_exiting", on_exit)) {
+        tree->get_root()->connect("tree_exiting", on_exit);
+    }
+    watching_tree = true;
+}
+
+Node *CollectiblePool::acquire(const Ref<PackedScene> &p_scene) {
+    ERR_FAIL_COND_V(p_scene.is_null(), nullptr);
+    const int index = _pool_for_key(_scene_key(p_scene), p_scene);
+
+    Node *node = _pop(index);
+    if (node) {
+        NativeStats::add(NativeStats::POOL_HITS);
+        return node;
+    }
+
+    NativeStats::add(NativeStats::POOL_MISSES);
+    node = p_scene->instantiate();
+    ERR_FAIL_NULL_V(node, nullptr);
+    origin[node->get_instance_id()] = index;
+    return node;
+}
+
+Node *CollectiblePool::acquire_named(const StringName &p_key) {
+    const int index = _find_pool(p_key);
+    Node *node = index >= 0 ? _pop(index) : nullptr;
+    NativeStats::add(node ? NativeStats::POOL_HITS : NativeStats::POOL_MISSES);
+    return node;
+}
+
+void CollectiblePool::release(Node *p_node, const StringName &p_key) {
+    ERR_FAIL_NULL(p_node);
+    const uint64_t id = p_node->get_instance_id();
+    if (pending_ids.count(id)) return; // already on its way back
+
+    int index = -1;
+    if (!p_key.is_empty()) {
+        index = _pool_for_key(p_key, Ref<PackedScene>());
+    } else {
+        auto it = origin.find(id);
+        if (it != origin.end()) {
+            index = it->second;
+        } else if (!p_node->get_scene_file_path().is_empty()) {
+            // Instanced by the level rather than the pool; only worth parking when
+            // something acquires that scene, otherwise it would wait forever
+            index = _find_pool(StringName(p_node->get_scene_file_path()));
+            if (index >= 0 && pools[index].scene.is_null()) {
+                index = -1;
+            }
+        }
+    }
+
+    Pool *pool = index >= 0 ? &pools[index] : nullptr;
+    if (!pool || (int)pool->free_ids.size() + pool->pending >= high_water_mark) {
+        origin.erase(id);
+        p_node->queue_free();
+        return;
+    }
+
+    origin[id] = index;
+    pending_ids.insert(id);
+    pool->pending++;
+    call_deferred("_park", id);
+}
+
+void CollectiblePool::release_id(uint64_t p_id, const StringName &p_key) {
+    Node *node = Object::cast_to<Node>(ObjectDB::get_instance(p_id));
+    if (!node || node->is_queued_for_deletion()) {
+        origin.erase(p_id);
+        return;
+    }
+    release(node, p_key);
+}
+
+void CollectiblePool::_park(uint64_t p_id) {
+    if (!pending_ids.erase(p_id)) return;
+    auto it = origin.find(p_id);
+    if (it == origin.end()) return;
+    Pool &pool = pools[it->second];
+    pool.pending--;
+
+    Node *node = Object::cast_to<Node>(ObjectDB::get_instance(p_id));
+    if (!node) {
+        origin.erase(it);
+        return;
+    }
+
+    Node *parent = node->get_parent();
+    if (parent) {
+        parent->remove_child(node);
+    }
+    if (node->has_method("_pool_reset")) {
+        node->call("_pool_reset");
+    }
+
+    pool.free_ids.push_back(p_id);
+    pool.peak = MAX(pool.peak, (int)pool.free_ids.size());
+    _watch_tree();
+}
+
+void CollectiblePool::prewarm(const Ref<PackedScene> &p_scene, int p_count) {
+    ERR_FAIL_COND(p_scene.is_null());
+    const int index = _pool_for_key(_scene_key(p_scene), p_scene);
+    Pool &pool = pools[index];
+
+    const int target = MIN(p_count, high_water_mark);
+    while ((int)pool.free_ids.size() < target) {
+        Node *node = p_scene->instantiate();
+        ERR_FAIL_NULL(node);
+        origin[node->get_instance_id()] = index;
+        pool.free_ids.push_back(node->get_instance_id());
+    }
+    pool.peak = MAX(pool.peak, (int)pool.free_ids.size());
+    _watch_tree();
+}
+
+int CollectiblePool::get_free_count(const StringName &p_key) const {
+    const int index = _find_pool(p_key);
+    return index >= 0 ? (int)pools[index].free_ids.size() : 0;
+}
+
+int CollectiblePool::get_peak_count(const StringName &p_key) const {
+    const int index = _find_pool(p_key);
+    return index >= 0 ? pools[index].peak : 0;
+}
+
+void CollectiblePool::clear() {
+    for (Pool &pool : pools) {
+        for (uint64_t id : pool.free_ids) {
+            Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+            if (node && !node->get_parent()) {
+                memdelete(node);
+            }
+            origin.erase(id);
+        }
+        pool.free_ids.clear();
+        pool.peak = 0;
+    }
+    watching_tree = false;
+}
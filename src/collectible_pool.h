@@ -0,0 +1,90 @@
+#ifndef COLLECTIBLE_POOL_H
+#define COLLECTIBLE_POOL_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/classes/packed_scene.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace godot {
+
+// Recycles collectible nodes (gems, FloatingItems) and their pickup effects
+// instead of freeing and re-instancing them for every drop.
+//
+// Released nodes are taken out of the tree at the end of the frame, get
+// _pool_reset() called if they have it, and wait detached until acquired
+// again. Scene nodes are pooled per scene path; nodes built in code (particle
+// emitters) under a name of the caller's choosing. A node the level placed is
+// only parked when its scene is acquired from the pool too, and freed otherwise. At most high_water_mark
+// nodes are kept per pool; anything released past that is freed as before.
+//
+// A node re-entering the tree from the pool does not get _ready() again, so
+// pooled scripts redo their per-spawn setup in _enter_tree().
+class CollectiblePool : public Object {
+    GDCLASS(CollectiblePool, Object);
+
+private:
+    struct Pool {
+        StringName key;
+        Ref<PackedScene> scene;         // null for named pools
+        std::vector<uint64_t> free_ids; // parked nodes, most recent last
+        int pending = 0;                // released, parked at the end of the frame
+        int peak = 0;                   // most nodes parked at once
+    };
+
+    static CollectiblePool *singleton;
+
+    int high_water_mark = 32;
+    std::vector<Pool> pools;
+    std::unordered_map<uint64_t, int> origin;  // node instance id -> pool index
+    std::unordered_set<uint64_t> pending_ids;
+    bool watching_tree = false;
+
+    int _find_pool(const StringName &p_key) const;
+    int _pool_for_key(const StringName &p_key, const Ref<PackedScene> &p_scene);
+    static StringName _scene_key(const Ref<PackedScene> &p_scene);
+    Node *_pop(int p_pool);
+    void _watch_tree();
+
+protected:
+    static void _bind_methods();
+
+public:
+    static CollectiblePool *get_singleton();
+
+    CollectiblePool();
+    ~CollectiblePool();
+
+    void set_high_water_mark(int p_count);
+    int get_high_water_mark() const;
+
+    // A parked instance of the scene, or a fresh one. Not inside the tree yet.
+    Node *acquire(const Ref<PackedScene> &p_scene);
+    // A parked node released under p_key, or null when the caller has to build one
+    Node *acquire_named(const StringName &p_key);
+    // Use instead of queue_free(). Safe from physics callbacks: the node leaves
+    // the tree at the end of the frame. Without p_key the node goes back to the
+    // pool it came from, or to the pool of its scene file when that scene has
+    // been acquired or prewarmed; anything else is freed.
+    void release(Node *p_node, const StringName &p_key = StringName());
+    // release() for a node that may have been freed since, e.g. with its scene
+    // before a timer bound to it fired; does nothing then
+    void release_id(uint64_t p_id, const StringName &p_key = StringName());
+    // Instantiates and parks nodes up front, up to the high water mark
+    void prewarm(const Ref<PackedScene> &p_scene, int p_count);
+
+    int get_free_count(const StringName &p_key) const;
+    int get_peak_count(const StringName &p_key) const;
+    // Frees every parked node
+    void clear();
+
+    void _park(uint64_t p_id);
+};
+
+} // namespace godot
+
+#endif // COLLECTIBLE_POOL_H
@@ -1,8 +1,11 @@
 #include "custom_surface.h"
 
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/physics_material.hpp>
-#include <godot_cpp/variant/utility_functions.hpp>
+
+#include "surface_map.h"
+#include "surface_registry.h"
 
 using namespace godot;
 
@@ -25,57 +28,83 @@ void CustomSurface::_bind_methods() {
         "set_surface_type",
         "get_surface_type"
     );
+
+    // Designer-defined types from the SurfaceRegistry library, by name
+    ClassDB::bind_method(D_METHOD("set_custom_type", "name"), &CustomSurface::set_custom_type);
+    ClassDB::bind_method(D_METHOD("get_custom_type"), &CustomSurface::get_custom_type);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "custom_type"), "set_custom_type", "get_custom_type");
+
+    ClassDB::bind_method(D_METHOD("get_surface_id"), &CustomSurface::get_surface_id);
+    ClassDB::bind_method(D_METHOD("get_friction"), &CustomSurface::get_friction);
+    ClassDB::bind_method(D_METHOD("get_bounce"), &CustomSurface::get_bounce);
 }
 
 void CustomSurface::set_surface_type(int p_type) {
     surface_type = p_type;
+    _apply_surface();
+}
 
-    // We'll pick friction and bounce based on the chosen surface
-    switch (surface_type) {
-        case SURFACE_ICE:
-            friction = 0.1f;
-            bounce   = 0.1f;
-            break;
-        case SURFACE_SAND:
-            friction = 0.9f;
-            bounce   = 0.0f;
-            break;
-        case SURFACE_METAL:
-            friction = 0.4f;
-            bounce   = 0.2f;
-            break;
-        case SURFACE_RUBBER:
-            friction = 0.2f;
-            bounce   = 0.8f;
-            break;
-        default:
-            friction = 0.5f;
-            bounce   = 0.3f;
-            break;
-    }
+int CustomSurface::get_surface_type() const {
+    return surface_type;
+}
 
-    // If the physics_material is already valid, update it now
-    if (physics_material.is_valid()) {
-        physics_material->set_friction(friction);
-        physics_material->set_bounce(bounce);
-    }
+void CustomSurface::set_custom_type(const StringName &p_name) {
+    custom_type = p_name;
+    _apply_surface();
 }
 
-int CustomSurface::get_surface_type() const {
+StringName CustomSurface::get_custom_type() const {
+    return custom_type;
+}
+
+int CustomSurface::get_surface_id() const {
+    SurfaceRegistry *registry = SurfaceRegistry::get_singleton();
+    if (!custom_type.is_empty() && registry) {
+        const int id = registry->find_type(custom_type);
+        if (id >= 0) return id;
+    }
     return surface_type;
 }
 
-void CustomSurface::_ready() {
-    // Create a PhysicsMaterial at runtime
-    physics_material.instantiate();
-    if (!physics_material.is_valid()) {
-        UtilityFunctions::print("Failed to instantiate PhysicsMaterial.");
+void CustomSurface::_apply_surface() {
+    // The editor never uses the values; don't load the surface library there
+    SurfaceRegistry *registry = SurfaceRegistry::get_singleton();
+    if (!registry || Engine::get_singleton()->is_editor_hint()) {
         return;
     }
 
-    // set friction/bounce based on the current surface_type
-    set_surface_type(surface_type);
+    // We'll pick friction and bounce based on the chosen surface
+    const int id = get_surface_id();
+    friction = registry->get_friction(id);
+    bounce   = registry->get_bounce(id);
+
+    // Every surface of a type shares one material; only assign it once we're in the
+    // running scene so the editor never saves the registry's material into the level
+    if (is_inside_tree()) {
+        set_physics_material_override(registry->get_material(id));
 
-    // Assign the material to override
-    set("physics_material_override", physics_material);
+        // Bake our shapes into the map so gameplay can ask for the surface without a query
+        SurfaceMap *map = SurfaceMap::get_singleton();
+        if (map) {
+            map->add_body(this, id);
+        }
+    }
+}
+
+void CustomSurface::_ready() {
+    _apply_surface();
+}
+
+// _ready only runs once; a body that left the tree goes back into SurfaceMap here
+void CustomSurface::_enter_tree() {
+    if (is_node_ready()) {
+        _apply_surface();
+    }
+}
+
+void CustomSurface::_exit_tree() {
+    SurfaceMap *map = SurfaceMap::get_singleton();
+    if (map) {
+        map->remove_body(this);
+    }
 }
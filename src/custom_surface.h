@@ -4,6 +4,7 @@
 #include <godot_cpp/classes/static_body2d.hpp>
 #include <godot_cpp/classes/physics_material.hpp>
 #include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/string_name.hpp>
 
 namespace godot {
 
@@ -24,13 +25,15 @@ protected:
 private:
     // We'll store which surface is chosen: 0=ICE, 1=SAND, 2=METAL, 3=RUBBER
     int surface_type = SURFACE_ICE;
+    // Name of a designer type from the SurfaceRegistry library; overrides surface_type when set
+    StringName custom_type;
 
     // We'll store friction/bounce after picking the surface
     float friction = 0.5f;
     float bounce   = 0.3f;
 
-    // A reference to the runtime PhysicsMaterial
-    Ref<PhysicsMaterial> physics_material;
+    // Looks the type up in SurfaceRegistry and uses its shared PhysicsMaterial
+    void _apply_surface();
 
 public:
     CustomSurface();
@@ -39,7 +42,15 @@ public:
     void set_surface_type(int p_type);
     int get_surface_type() const;
 
+    void set_custom_type(const StringName &p_name);
+    StringName get_custom_type() const;
+
+    // Registry id actually in use (surface_type, or the custom type's id)
+    int get_surface_id() const;
+
     void _ready();
+    void _enter_tree() override;
+    void _exit_tree() override;
 
     // (Optional) If you want direct read of friction/bounce in code or GDScript
     float get_friction() const { return friction; }
@@ -0,0 +1,466 @@
+#include "debug_draw.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/font.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/theme_db.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/classes/world2d.hpp>
+#include <godot_cpp/classes/world3d.hpp>
+
+#include <cmath>
+
+#include "frame_arena.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+DebugDraw *DebugDraw::singleton = nullptr;
+
+void DebugDraw::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &DebugDraw::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &DebugDraw::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    // 2D
+    ClassDB::bind_method(D_METHOD("line_2d", "from", "to", "color", "duration"), &DebugDraw::line_2d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("circle_2d", "center", "radius", "color", "duration"), &DebugDraw::circle_2d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("box_2d", "rect", "color", "duration"), &DebugDraw::box_2d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("arrow_2d", "from", "to", "color", "duration"), &DebugDraw::arrow_2d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("text_2d", "position", "text", "color", "duration"), &DebugDraw::text_2d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+
+    // 3D
+    ClassDB::bind_method(D_METHOD("line_3d", "from", "to", "color", "duration"), &DebugDraw::line_3d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("circle_3d", "center", "radius", "color", "duration"), &DebugDraw::circle_3d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("box_3d", "box", "color", "duration"), &DebugDraw::box_3d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("arrow_3d", "from", "to", "color", "duration"), &DebugDraw::arrow_3d, DEFVAL(Color(1, 1, 1)), DEFVAL(0.0));
+
+    ClassDB::bind_method(D_METHOD("clear"), &DebugDraw::clear);
+    ClassDB::bind_method(D_METHOD("_flush"), &DebugDraw::_flush);
+}
+
+DebugDraw *DebugDraw::get_singleton() {
+    return singleton;
+}
+
+DebugDraw::DebugDraw() :
+        items_2d(MAX_PRIMITIVES),
+        items_3d(MAX_PRIMITIVES),
+        texts_2d(MAX_TEXTS) {
+    singleton = this;
+
+    // Nothing to draw over in the editor, and tool scripts calling in would pile up items
+    if (Engine::get_singleton()->is_editor_hint()) {
+        enabled = false;
+        return;
+    }
+
+    // Flush right before the frame is drawn, after every node had its _process()
+    RenderingServer::get_singleton()->connect("frame_pre_draw", Callable(this, "_flush"));
+}
+
+DebugDraw::~DebugDraw() {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (rs) {
+        if (rs->is_connected("frame_pre_draw", Callable(this, "_flush"))) {
+            rs->disconnect("frame_pre_draw", Callable(this, "_flush"));
+        }
+        if (instance.is_valid()) rs->free_rid(instance);
+        if (mesh.is_valid()) rs->free_rid(mesh);
+        if (canvas_item.is_valid()) rs->free_rid(canvas_item);
+    }
+    line_material.unref();
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void DebugDraw::set_enabled(bool p_enabled) {
+    enabled = p_enabled && !Engine::get_singleton()->is_editor_hint();
+    if (!enabled) {
+        clear();
+    }
+}
+
+bool DebugDraw::is_enabled() const {
+    return enabled;
+}
+
+uint64_t DebugDraw::_expiry(float p_duration) const {
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+    return now + (uint64_t)(MAX(p_duration, 0.0f) * 1000000.0f);
+}
+
+void DebugDraw::_push_2d(const Item2D &p_item) {
+    if (!enabled) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    items_2d.push(p_item);
+}
+
+void DebugDraw::_push_3d(const Item3D &p_item) {
+    if (!enabled) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    items_3d.push(p_item);
+}
+
+/* ------------ 2D submission ------------ */
+void DebugDraw::line_2d(const Vector2 &p_from, const Vector2 &p_to, const Color &p_color, float p_duration) {
+    Item2D item;
+    item.type = PRIM_LINE;
+    item.a = p_from;
+    item.b = p_to;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_2d(item);
+}
+
+void DebugDraw::circle_2d(const Vector2 &p_center, float p_radius, const Color &p_color, float p_duration) {
+    Item2D item;
+    item.type = PRIM_CIRCLE;
+    item.a = p_center;
+    item.radius = p_radius;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_2d(item);
+}
+
+void DebugDraw::box_2d(const Rect2 &p_rect, const Color &p_color, float p_duration) {
+    Item2D item;
+    item.type = PRIM_BOX;
+    item.a = p_rect.position;
+    item.b = p_rect.size;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_2d(item);
+}
+
+void DebugDraw::arrow_2d(const Vector2 &p_from, const Vector2 &p_to, const Color &p_color, float p_duration) {
+    Item2D item;
+    item.type = PRIM_ARROW;
+    item.a = p_from;
+    item.b = p_to;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_2d(item);
+}
+
+void DebugDraw::text_2d(const Vector2 &p_position, const String &p_text, const Color &p_color, float p_duration) {
+    if (!enabled) return;
+    Text2D text;
+    text.position = p_position;
+    text.text = p_text;
+    text.color = p_color;
+    text.expire_usec = _expiry(p_duration);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    texts_2d.push(text);
+}
+
+/* ------------ 3D submission ------------ */
+void DebugDraw::line_3d(const Vector3 &p_from, const Vector3 &p_to, const Color &p_color, float p_duration) {
+    Item3D item;
+    item.type = PRIM_LINE;
+    item.a = p_from;
+    item.b = p_to;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_3d(item);
+}
+
+void DebugDraw::circle_3d(const Vector3 &p_center, float p_radius, const Color &p_color, float p_duration) {
+    Item3D item;
+    item.type = PRIM_CIRCLE;
+    item.a = p_center;
+    item.radius = p_radius;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_3d(item);
+}
+
+void DebugDraw::box_3d(const AABB &p_box, const Color &p_color, float p_duration) {
+    Item3D item;
+    item.type = PRIM_BOX;
+    item.a = p_box.position;
+    item.b = p_box.size;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_3d(item);
+}
+
+void DebugDraw::arrow_3d(const Vector3 &p_from, const Vector3 &p_to, const Color &p_color, float p_duration) {
+    Item3D item;
+    item.type = PRIM_ARROW;
+    item.a = p_from;
+    item.b = p_to;
+    item.color = p_color;
+    item.expire_usec = _expiry(p_duration);
+    _push_3d(item);
+}
+
+void DebugDraw::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    items_2d.clear();
+    items_3d.clear();
+    texts_2d.clear();
+}
+
+/* ------------ segment helpers ------------ */
+int DebugDraw::append_circle(std::vector<Vector2> &r_points, const Vector2 &p_center, float p_radius, int p_segments) {
+    p_segments = MAX(p_segments, 3);
+    const float step = (float)Math_TAU / (float)p_segments;
+    Vector2 prev = p_center + Vector2(p_radius, 0);
+    for (int i = 1; i <= p_segments; i++) {
+        float angle = step * (float)i;
+        Vector2 next = p_center + Vector2(std::cos(angle), std::sin(angle)) * p_radius;
+        r_points.push_back(prev);
+        r_points.push_back(next);
+        prev = next;
+    }
+    return p_segments;
+}
+
+int DebugDraw::append_rect(std::vector<Vector2> &r_points, const Transform2D &p_xform, const Rect2 &p_rect) {
+    Vector2 corners[4] = {
+        p_xform.xform(p_rect.position),
+        p_xform.xform(p_rect.position + Vector2(p_rect.size.x, 0)),
+        p_xform.xform(p_rect.position + p_rect.size),
+        p_xform.xform(p_rect.position + Vector2(0, p_rect.size.y))
+    };
+    for (int i = 0; i < 4; i++) {
+        r_points.push_back(corners[i]);
+        r_points.push_back(corners[(i + 1) % 4]);
+    }
+    return 4;
+}
+
+int DebugDraw::append_arrow(std::vector<Vector2> &r_points, const Vector2 &p_from, const Vector2 &p_to) {
+    r_points.push_back(p_from);
+    r_points.push_back(p_to);
+
+    Vector2 dir = p_to - p_from;
+    float length = dir.length();
+    if (length <= 0.0001f) return 1;
+
+    dir /= length;
+    float head = MIN(length * 0.25f, 16.0f);
+    r_points.push_back(p_to);
+    r_points.push_back(p_to - dir.rotated(0.45f) * head);
+    r_points.push_back(p_to);
+    r_points.push_back(p_to - dir.rotated(-0.45f) * head);
+    return 3;
+}
+
+/* ------------ flushing ------------ */
+void DebugDraw::_flush() {
+    PROFILE_ZONE("DebugDraw::_flush");
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+    _flush_2d(now);
+    _flush_3d(now);
+}
+
+bool DebugDraw::_ensure_canvas_item() {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || !tree->get_root()) return false;
+
+    Ref<World2D> world = tree->get_root()->find_world_2d();
+    if (world.is_null()) return false;
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (!canvas_item.is_valid()) {
+        canvas_item = rs->canvas_item_create();
+        rs->canvas_item_set_z_index(canvas_item, RenderingServer::CANVAS_ITEM_Z_MAX);
+    }
+    if (world->get_canvas() != canvas) {
+        canvas = world->get_canvas();
+        rs->canvas_item_set_parent(canvas_item, canvas);
+    }
+    return true;
+}
+
+bool DebugDraw::_ensure_mesh_instance() {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || !tree->get_root()) return false;
+
+    Ref<World3D> world = tree->get_root()->find_world_3d();
+    if (world.is_null()) return false;
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (!mesh.is_valid()) {
+        line_material.instantiate();
+        line_material->set_shading_mode(BaseMaterial3D::SHADING_MODE_UNSHADED);
+        line_material->set_flag(BaseMaterial3D::FLAG_ALBEDO_FROM_VERTEX_COLOR, true);
+        line_material->set_transparency(BaseMaterial3D::TRANSPARENCY_ALPHA);
+
+        mesh = rs->mesh_create();
+        instance = rs->instance_create();
+        rs->instance_set_base(instance, mesh);
+        rs->instance_geometry_set_material_override(instance, line_material->get_rid());
+        rs->instance_geometry_set_cast_shadows_setting(instance, RenderingServer::SHADOW_CASTING_SETTING_OFF);
+    }
+    if (world->get_scenario() != scenario) {
+        scenario = world->get_scenario();
+        rs->instance_set_scenario(instance, scenario);
+    }
+    return true;
+}
+
+void DebugDraw::_flush_2d(uint64_t p_now) {
+    FrameVector<Text2D> texts{ FrameAllocator<Text2D>(FrameArena::frame(Engine::get_singleton()->get_process_frames())) };
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items_2d.size() == 0 && texts_2d.size() == 0 && !drew_2d) {
+            return; // nothing now, nothing last frame
+        }
+
+        scratch_2d.clear();
+        scratch_colors_2d.clear();
+        items_2d.filter([&](Item2D &item) {
+            if (item.drawn && p_now >= item.expire_usec) return false;
+
+            int segments = 0;
+            switch (item.type) {
+                case PRIM_LINE:
+                    scratch_2d.push_back(item.a);
+                    scratch_2d.push_back(item.b);
+                    segments = 1;
+                    break;
+                case PRIM_CIRCLE:
+                    segments = append_circle(scratch_2d, item.a, item.radius, CIRCLE_SEGMENTS);
+                    break;
+                case PRIM_BOX:
+                    segments = append_rect(scratch_2d, Transform2D(), Rect2(item.a, item.b));
+                    break;
+                case PRIM_ARROW:
+                    segments = append_arrow(scratch_2d, item.a, item.b);
+                    break;
+            }
+            scratch_colors_2d.insert(scratch_colors_2d.end(), segments, item.color);
+            item.drawn = true;
+            return true;
+        });
+
+        texts.reserve(texts_2d.size());
+        texts_2d.filter([&](Text2D &text) {
+            if (text.drawn && p_now >= text.expire_usec) return false;
+            texts.push_back(text);
+            text.drawn = true;
+            return true;
+        });
+    }
+
+    if (!_ensure_canvas_item()) return;
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    rs->canvas_item_clear(canvas_item);
+    drew_2d = !scratch_2d.empty() || !texts.empty();
+
+    // Every line, circle, box and arrow goes out in a single command
+    points_2d.resize((int64_t)scratch_2d.size());
+    colors_2d.resize((int64_t)scratch_colors_2d.size());
+    if (!scratch_2d.empty()) {
+        Vector2 *pw = points_2d.ptrw();
+        for (size_t i = 0; i < scratch_2d.size(); i++) pw[i] = scratch_2d[i];
+        Color *cw = colors_2d.ptrw();
+        for (size_t i = 0; i < scratch_colors_2d.size(); i++) cw[i] = scratch_colors_2d[i];
+        rs->canvas_item_add_multiline(canvas_item, points_2d, colors_2d);
+    }
+
+    if (!texts.empty()) {
+        Ref<Font> font = ThemeDB::get_singleton()->get_fallback_font();
+        if (font.is_valid()) {
+            for (const Text2D &text : texts) {
+                font->draw_string(canvas_item, text.position, text.text, HORIZONTAL_ALIGNMENT_LEFT, -1, 16, text.color);
+            }
+        }
+    }
+}
+
+void DebugDraw::_flush_3d(uint64_t p_now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items_3d.size() == 0 && !drew_3d) {
+            return;
+        }
+
+        scratch_3d.clear();
+        scratch_colors_3d.clear();
+        items_3d.filter([&](Item3D &item) {
+            if (item.drawn && p_now >= item.expire_usec) return false;
+
+            size_t first = scratch_3d.size();
+            switch (item.type) {
+                case PRIM_LINE:
+                    scratch_3d.push_back(item.a);
+                    scratch_3d.push_back(item.b);
+                    break;
+                case PRIM_CIRCLE: {
+                    const float step = (float)Math_TAU / (float)CIRCLE_SEGMENTS;
+                    Vector3 prev = item.a + Vector3(item.radius, 0, 0);
+                    for (int i = 1; i <= CIRCLE_SEGMENTS; i++) {
+                        float angle = step * (float)i;
+                        Vector3 next = item.a + Vector3(std::cos(angle), 0, std::sin(angle)) * item.radius;
+                        scratch_3d.push_back(prev);
+                        scratch_3d.push_back(next);
+                        prev = next;
+                    }
+                } break;
+                case PRIM_BOX: {
+                    AABB box(item.a, item.b);
+                    for (int e = 0; e < 12; e++) {
+                        Vector3 from, to;
+                        box.get_edge(e, from, to);
+                        scratch_3d.push_back(from);
+                        scratch_3d.push_back(to);
+                    }
+                } break;
+                case PRIM_ARROW: {
+                    scratch_3d.push_back(item.a);
+                    scratch_3d.push_back(item.b);
+                    Vector3 dir = item.b - item.a;
+                    float length = dir.length();
+                    if (length > 0.0001f) {
+                        dir /= length;
+                        Vector3 side = dir.cross(Vector3(0, 1, 0));
+                        if (side.length_squared() < 0.0001f) side = dir.cross(Vector3(1, 0, 0));
+                        side.normalize();
+                        float head = MIN(length * 0.25f, 0.5f);
+                        Vector3 base = item.b - dir * head;
+                        scratch_3d.push_back(item.b);
+                        scratch_3d.push_back(base + side * head * 0.5f);
+                        scratch_3d.push_back(item.b);
+                        scratch_3d.push_back(base - side * head * 0.5f);
+                    }
+                } break;
+            }
+            scratch_colors_3d.insert(scratch_colors_3d.end(), scratch_3d.size() - first, item.color);
+            item.drawn = true;
+            return true;
+        });
+    }
+
+    if (!_ensure_mesh_instance()) return;
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    rs->mesh_clear(mesh);
+    drew_3d = !scratch_3d.empty();
+
+    points_3d.resize((int64_t)scratch_3d.size());
+    colors_3d.resize((int64_t)scratch_colors_3d.size());
+    if (scratch_3d.empty()) return;
+
+    Vector3 *pw = points_3d.ptrw();
+    for (size_t i = 0; i < scratch_3d.size(); i++) pw[i] = scratch_3d[i];
+    Color *cw = colors_3d.ptrw();
+    for (size_t i = 0; i < scratch_colors_3d.size(); i++) cw[i] = scratch_colors_3d[i];
+
+    // One line-list surface holds every 3D primitive of the frame
+    Array arrays;
+    arrays.resize(RenderingServer::ARRAY_MAX);
+    arrays[RenderingServer::ARRAY_VERTEX] = points_3d;
+    arrays[RenderingServer::ARRAY_COLOR] = colors_3d;
+    rs->mesh_add_surface_from_arrays(mesh, RenderingServer::PRIMITIVE_LINES, arrays);
+}
@@ -0,0 +1,180 @@
+#ifndef DEBUG_DRAW_H
+#define DEBUG_DRAW_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/classes/standard_material3d.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace godot {
+
+// Fixed-capacity ring of timed primitives. When full the oldest entry is dropped.
+template <typename T>
+class ExpiringRing {
+public:
+    explicit ExpiringRing(int p_capacity) : slots(p_capacity) {}
+
+    void push(const T &p_item) {
+        slots[head] = p_item;
+        head = (head + 1) % (int)slots.size();
+        if (count < (int)slots.size()) count++;
+    }
+
+    // Calls p_visit on every entry (oldest first) and keeps those it returns true for
+    template <typename F>
+    void filter(F p_visit) {
+        const int cap = (int)slots.size();
+        const int tail = (head - count + cap) % cap;
+        int kept = 0;
+        for (int r = 0; r < count; r++) {
+            T &item = slots[(tail + r) % cap];
+            if (p_visit(item)) {
+                if (kept != r) slots[(tail + kept) % cap] = item;
+                kept++;
+            }
+        }
+        count = kept;
+        head = (tail + kept) % cap;
+    }
+
+    void clear() { head = 0; count = 0; }
+    int size() const { return count; }
+
+private:
+    std::vector<T> slots;
+    int head = 0;
+    int count = 0;
+};
+
+// Immediate-mode debug drawing usable from any system (AI, projectiles, navigation...).
+// Primitives live in ring buffers until their duration expires (0 = one frame) and
+// are flushed once per frame: all 2D lines with a single canvas_item_add_multiline,
+// all 3D lines as a single line mesh.
+class DebugDraw : public Object {
+    GDCLASS(DebugDraw, Object);
+
+public:
+    static const int MAX_PRIMITIVES = 8192;
+    static const int MAX_TEXTS = 256;
+    static const int CIRCLE_SEGMENTS = 24;
+
+    enum PrimitiveType {
+        PRIM_LINE = 0,
+        PRIM_CIRCLE,
+        PRIM_BOX,
+        PRIM_ARROW
+    };
+
+private:
+    static DebugDraw *singleton;
+
+    struct Item2D {
+        uint8_t type = PRIM_LINE;
+        bool drawn = false;
+        Vector2 a, b;         // line/arrow endpoints, or box position/size
+        float radius = 0.0f;
+        Color color;
+        uint64_t expire_usec = 0;
+    };
+
+    struct Item3D {
+        uint8_t type = PRIM_LINE;
+        bool drawn = false;
+        Vector3 a, b;         // line/arrow endpoints, or box position/size
+        float radius = 0.0f;
+        Color color;
+        uint64_t expire_usec = 0;
+    };
+
+    struct Text2D {
+        bool drawn = false;
+        Vector2 position;
+        String text;
+        Color color;
+        uint64_t expire_usec = 0;
+    };
+
+    bool enabled = true;
+
+    std::mutex mutex; // producers may live on the physics thread
+    ExpiringRing<Item2D> items_2d;
+    ExpiringRing<Item3D> items_3d;
+    ExpiringRing<Text2D> texts_2d;
+
+    // Per-frame vertex arrays, reused between flushes
+    std::vector<Vector2> scratch_2d;
+    std::vector<Color> scratch_colors_2d;
+    std::vector<Vector3> scratch_3d;
+    std::vector<Color> scratch_colors_3d;
+    PackedVector2Array points_2d;
+    PackedColorArray colors_2d;   // one per segment
+    PackedVector3Array points_3d;
+    PackedColorArray colors_3d;   // one per vertex
+    bool drew_2d = false;         // something is on the canvas item from last flush
+    bool drew_3d = false;         // the line mesh has a surface from last flush
+
+    // RenderingServer resources, created on first use
+    RID canvas_item;
+    RID canvas;
+    RID mesh;
+    RID instance;
+    RID scenario;
+    Ref<StandardMaterial3D> line_material;
+
+protected:
+    static void _bind_methods();
+
+public:
+    static DebugDraw *get_singleton();
+
+    DebugDraw();
+    ~DebugDraw();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+
+    // 2D primitives (canvas / world coordinates)
+    void line_2d(const Vector2 &p_from, const Vector2 &p_to, const Color &p_color, float p_duration);
+    void circle_2d(const Vector2 &p_center, float p_radius, const Color &p_color, float p_duration);
+    void box_2d(const Rect2 &p_rect, const Color &p_color, float p_duration);
+    void arrow_2d(const Vector2 &p_from, const Vector2 &p_to, const Color &p_color, float p_duration);
+    void text_2d(const Vector2 &p_position, const String &p_text, const Color &p_color, float p_duration);
+
+    // 3D primitives (world coordinates; circles lie in the XZ plane)
+    void line_3d(const Vector3 &p_from, const Vector3 &p_to, const Color &p_color, float p_duration);
+    void circle_3d(const Vector3 &p_center, float p_radius, const Color &p_color, float p_duration);
+    void box_3d(const AABB &p_box, const Color &p_color, float p_duration);
+    void arrow_3d(const Vector3 &p_from, const Vector3 &p_to, const Color &p_color, float p_duration);
+
+    void clear();
+
+    // Connected to RenderingServer.frame_pre_draw
+    void _flush();
+
+    // Segment helpers shared with other batched drawers (e.g. DebugVisualizer).
+    // Each appends endpoint pairs and returns the number of segments added.
+    static int append_circle(std::vector<Vector2> &r_points, const Vector2 &p_center, float p_radius, int p_segments);
+    static int append_rect(std::vector<Vector2> &r_points, const Transform2D &p_xform, const Rect2 &p_rect);
+    static int append_arrow(std::vector<Vector2> &r_points, const Vector2 &p_from, const Vector2 &p_to);
+
+private:
+    uint64_t _expiry(float p_duration) const;
+    void _push_2d(const Item2D &p_item);
+    void _push_3d(const Item3D &p_item);
+
+    void _flush_2d(uint64_t p_now);
+    void _flush_3d(uint64_t p_now);
+    bool _ensure_canvas_item();
+    bool _ensure_mesh_instance();
+};
+
+} // namespace godot
+
+#endif // DEBUG_DRAW_H
@@ -7,6 +7,15 @@
 
 #include <godot_cpp/classes/node2d.hpp>
 #include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include <vector>
+
+#include "orbit_predictor.h"
+#include "physics_shape_registry.h"
+#include "frame_recorder.h"
 
 namespace godot {
 
@@ -20,6 +29,39 @@ private:
     bool show_collision_shapes = true;
     bool show_forces = true;
 
+    // Only draw shapes whose bounds intersect the camera's visible rect
+    bool cull_to_view = true;
+
+    // Frame-time graph of the FrameRecorder history, drawn in screen space
+    bool show_frame_graph = false;
+    int frame_graph_frames = 240;
+    std::vector<FrameRecorder::FrameSample> graph_samples;
+
+    // Predicted future paths of every MagneticOrbit body
+    bool show_trajectories = false;
+    int trajectory_steps = 120;
+    Color trajectory_color = Color(0.3, 0.8, 1.0, 0.8);
+
+    // Collision shapes of physics bodies, kept up to date from SceneTree signals
+    PhysicsShapeRegistry shape_registry;
+    std::vector<int> visible_shapes;   // registry indices returned by the last query
+    static const int SHAPE_SYNC_BUDGET = 64;  // off-screen entries re-checked per frame
+    float view_scale = 1.0f;           // canvas units -> screen pixels, for arc LOD
+
+    // Every outline of the frame is accumulated here and drawn in one call
+    std::vector<Vector2> outline_points;
+    std::vector<Color> outline_colors;  // one per segment
+    PackedVector2Array batch_points;
+    PackedColorArray batch_colors;
+
+    OrbitPredictor predictor;
+    std::vector<OrbitPredictor::BodyState> trajectory_bodies;
+    TypedArray<Node> orbits;            // MagneticOrbit group, refreshed when the tree changes
+    bool orbits_dirty = true;
+    PackedVector2Array trajectory_lines;
+    Vector2 default_gravity;
+    float default_linear_damp = 0.0f;
+
     // If you know exactly where your MagneticOrbit is, store a NodePath here:
     NodePath magnetic_orbit_path = NodePath("MagneticOrbit");
 
@@ -33,23 +75,51 @@ public:
     void set_show_forces(bool p_show);
     bool is_show_forces() const;
 
+    void set_cull_to_view(bool p_cull);
+    bool is_cull_to_view() const;
+
+    void set_show_frame_graph(bool p_show);
+    bool is_show_frame_graph() const;
+
+    void set_frame_graph_frames(int p_frames);
+    int get_frame_graph_frames() const;
+
+    void set_show_trajectories(bool p_show);
+    bool is_show_trajectories() const;
+
+    void set_trajectory_steps(int p_steps);
+    int get_trajectory_steps() const;
+
+    void set_trajectory_color(const Color &p_color);
+    Color get_trajectory_color() const;
+
     // For the typed get_node approach to find MagneticOrbit:
     void set_magnetic_orbit_path(const NodePath &p_path);
     NodePath get_magnetic_orbit_path() const;
 
     // Godot callbacks
     void _ready() override;
+    void _enter_tree() override;
+    void _exit_tree() override;
     void _process(double delta) override;
     void _draw() override;
 
-private:
-    // Recursively gather physics bodies
-    void gather_physics_bodies(Node *p_node, Vector<Node2D *> &bodies);
-    // Recursively gather shapes
-    void gather_collision_shapes(Node *p_node, Vector<Node*> &shapes);
+    // SceneTree node_added / node_removed handlers feeding the shape registry
+    void _on_node_added(Node *p_node);
+    void _on_node_removed(Node *p_node);
 
-    // Actually draw shape outlines
-    void draw_shape_outline(const Ref<class Shape2D> &shape, const Transform2D &global_xform);
+private:
+    // Snapshot every MagneticOrbit body and hand it to the predictor thread
+    void submit_trajectories();
+
+    // Append shape outlines to the frame batch
+    void append_shape_outline(const PhysicsShapeRegistry::Entry &entry, const Transform2D &global_xform);
+    void append_segments(int count, const Color &color);
+    // Arc segment count for a circle of the given canvas radius at the current zoom
+    int circle_segments_for(float radius) const;
+    // Draw everything appended this frame with a single draw_multiline_colors
+    void flush_outlines();
+    void draw_frame_graph();
 };
 
 } // namespace godot
@@ -16,9 +16,15 @@
 #include <godot_cpp/classes/canvas_item.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
 #include <godot_cpp/classes/font.hpp>  // For text rendering
+#include <godot_cpp/classes/physics_server2d.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/viewport.hpp>
+#include <godot_cpp/classes/theme_db.hpp>
 
 // Include MagneticOrbit class if used for force visualization
 #include "magnetic_orbit.h"
+#include "debug_draw.h"
+#include "profile_zone.h"
 
 using namespace godot;
 
@@ -34,6 +40,37 @@ void DebugVisualizer::_bind_methods() {
     ClassDB::bind_method(D_METHOD("is_show_forces"), &DebugVisualizer::is_show_forces);
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_forces"), "set_show_forces", "is_show_forces");
 
+    // Bind methods for camera culling of shape outlines
+    ClassDB::bind_method(D_METHOD("set_cull_to_view", "p_cull"), &DebugVisualizer::set_cull_to_view);
+    ClassDB::bind_method(D_METHOD("is_cull_to_view"), &DebugVisualizer::is_cull_to_view);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cull_to_view"), "set_cull_to_view", "is_cull_to_view");
+
+    // Bind methods for the frame-time graph
+    ClassDB::bind_method(D_METHOD("set_show_frame_graph", "p_show"), &DebugVisualizer::set_show_frame_graph);
+    ClassDB::bind_method(D_METHOD("is_show_frame_graph"), &DebugVisualizer::is_show_frame_graph);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_frame_graph"), "set_show_frame_graph", "is_show_frame_graph");
+
+    ClassDB::bind_method(D_METHOD("set_frame_graph_frames", "p_frames"), &DebugVisualizer::set_frame_graph_frames);
+    ClassDB::bind_method(D_METHOD("get_frame_graph_frames"), &DebugVisualizer::get_frame_graph_frames);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "frame_graph_frames", PROPERTY_HINT_RANGE, "16,1000,1"), "set_frame_graph_frames", "get_frame_graph_frames");
+
+    // Bind methods for the trajectory preview
+    ClassDB::bind_method(D_METHOD("set_show_trajectories", "p_show"), &DebugVisualizer::set_show_trajectories);
+    ClassDB::bind_method(D_METHOD("is_show_trajectories"), &DebugVisualizer::is_show_trajectories);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_trajectories"), "set_show_trajectories", "is_show_trajectories");
+
+    ClassDB::bind_method(D_METHOD("set_trajectory_steps", "p_steps"), &DebugVisualizer::set_trajectory_steps);
+    ClassDB::bind_method(D_METHOD("get_trajectory_steps"), &DebugVisualizer::get_trajectory_steps);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "trajectory_steps", PROPERTY_HINT_RANGE, "1,600,1"), "set_trajectory_steps", "get_trajectory_steps");
+
+    ClassDB::bind_method(D_METHOD("set_trajectory_color", "p_color"), &DebugVisualizer::set_trajectory_color);
+    ClassDB::bind_method(D_METHOD("get_trajectory_color"), &DebugVisualizer::get_trajectory_color);
+    ADD_PROPERTY(PropertyInfo(Variant::COLOR, "trajectory_color"), "set_trajectory_color", "get_trajectory_color");
+
+    // Shape registry feed
+    ClassDB::bind_method(D_METHOD("_on_node_added", "node"), &DebugVisualizer::_on_node_added);
+    ClassDB::bind_method(D_METHOD("_on_node_removed", "node"), &DebugVisualizer::_on_node_removed);
+
     // Expose MagneticOrbit NodePath to connect to an external magnetic force system
     ClassDB::bind_method(D_METHOD("set_magnetic_orbit_path", "p_path"), &DebugVisualizer::set_magnetic_orbit_path);
     ClassDB::bind_method(D_METHOD("get_magnetic_orbit_path"), &DebugVisualizer::get_magnetic_orbit_path);
@@ -63,6 +100,57 @@ bool DebugVisualizer::is_show_forces() const {
     return show_forces;
 }
 
+// Enable or disable culling of shapes outside the visible rect
+void DebugVisualizer::set_cull_to_view(bool p_cull) {
+    cull_to_view = p_cull;
+    queue_redraw();
+}
+bool DebugVisualizer::is_cull_to_view() const {
+    return cull_to_view;
+}
+
+// Enable or disable the frame-time graph
+void DebugVisualizer::set_show_frame_graph(bool p_show) {
+    show_frame_graph = p_show;
+    queue_redraw();
+}
+bool DebugVisualizer::is_show_frame_graph() const {
+    return show_frame_graph;
+}
+
+void DebugVisualizer::set_frame_graph_frames(int p_frames) {
+    frame_graph_frames = CLAMP(p_frames, 16, 1000);
+}
+int DebugVisualizer::get_frame_graph_frames() const {
+    return frame_graph_frames;
+}
+
+// Enable or disable the predicted orbit paths
+void DebugVisualizer::set_show_trajectories(bool p_show) {
+    show_trajectories = p_show;
+    if (!show_trajectories) {
+        trajectory_lines.clear();
+    }
+    queue_redraw();
+}
+bool DebugVisualizer::is_show_trajectories() const {
+    return show_trajectories;
+}
+
+void DebugVisualizer::set_trajectory_steps(int p_steps) {
+    trajectory_steps = MAX(p_steps, 1);
+}
+int DebugVisualizer::get_trajectory_steps() const {
+    return trajectory_steps;
+}
+
+void DebugVisualizer::set_trajectory_color(const Color &p_color) {
+    trajectory_color = p_color;
+}
+Color DebugVisualizer::get_trajectory_color() const {
+    return trajectory_color;
+}
+
 // Setters and getters for the MagneticOrbit node path
 void DebugVisualizer::set_magnetic_orbit_path(const NodePath &p_path) {
     magnetic_orbit_path = p_path;
@@ -74,59 +162,171 @@ NodePath DebugVisualizer::get_magnetic_orbit_path() const {
 // Called when the node is ready in the scene
 void DebugVisualizer::_ready() {
     set_process(true); // Enable `_process()` updates
+
+    // Project defaults the predictor needs to mirror the 2D physics step
+    ProjectSettings *settings = ProjectSettings::get_singleton();
+    float gravity = settings->get_setting("physics/2d/default_gravity", 980.0);
+    Vector2 gravity_dir = settings->get_setting("physics/2d/default_gravity_vector", Vector2(0, 1));
+    default_gravity = gravity_dir * gravity;
+    default_linear_damp = settings->get_setting("physics/2d/default_linear_damp", 0.1);
+}
+
+// Mirrors _exit_tree, so a visualizer that is removed and added back registers again
+void DebugVisualizer::_enter_tree() {
+    // Walk the tree once, then keep the shape list current from tree signals
+    SceneTree *tree = get_tree();
+    shape_registry.scan(tree->get_root());
+    if (!tree->is_connected("node_added", Callable(this, "_on_node_added"))) {
+        tree->connect("node_added", Callable(this, "_on_node_added"));
+        tree->connect("node_removed", Callable(this, "_on_node_removed"));
+    }
+    orbits_dirty = true;
+}
+
+void DebugVisualizer::_exit_tree() {
+    SceneTree *tree = get_tree();
+    if (tree->is_connected("node_added", Callable(this, "_on_node_added"))) {
+        tree->disconnect("node_added", Callable(this, "_on_node_added"));
+        tree->disconnect("node_removed", Callable(this, "_on_node_removed"));
+    }
+    shape_registry.clear();
+}
+
+void DebugVisualizer::_on_node_added(Node *p_node) {
+    shape_registry.add_node(p_node);
+    orbits_dirty = true;
+}
+
+void DebugVisualizer::_on_node_removed(Node *p_node) {
+    shape_registry.remove_node(p_node);
+    orbits_dirty = true;
 }
 
 // Called every frame to refresh the debug visualization
 void DebugVisualizer::_process(double delta) {
+    if (show_trajectories) {
+        // Pick up last frame's prediction, then queue the next one
+        if (predictor.fetch()) {
+            const std::vector<float> &segments = predictor.get_segments();
+            int point_count = (int)(segments.size() / 2);
+            trajectory_lines.resize(point_count);
+            Vector2 *dst = trajectory_lines.ptrw();
+            for (int i = 0; i < point_count; i++) {
+                dst[i] = Vector2(segments[i * 2], segments[i * 2 + 1]);
+            }
+        }
+        submit_trajectories();
+    }
+
     queue_redraw(); // Request re-rendering each frame
 }
 
+// Gathers every MagneticOrbit body and starts a prediction on the worker thread.
+// Only physics server state is read here; the integration itself runs off-thread.
+void DebugVisualizer::submit_trajectories() {
+    PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+    if (orbits_dirty) {
+        orbits = get_tree()->get_nodes_in_group(MagneticOrbit::GROUP_NAME);
+        orbits_dirty = false;
+    }
+
+    trajectory_bodies.clear();
+    for (int i = 0; i < orbits.size(); i++) {
+        MagneticOrbit *orbit = Object::cast_to<MagneticOrbit>(orbits[i]);
+        if (!orbit || !orbit->get_player_rid().is_valid()) {
+            continue;
+        }
+
+        // The orbiting body is the separate orbit object if set, else the MagneticOrbit itself
+        RID body_rid = orbit->get_orbit_object_rid();
+        if (!body_rid.is_valid()) {
+            body_rid = orbit->get_rid();
+        }
+
+        Transform2D center_xf = ps->body_get_state(orbit->get_player_rid(), PhysicsServer2D::BODY_STATE_TRANSFORM);
+        Transform2D body_xf = ps->body_get_state(body_rid, PhysicsServer2D::BODY_STATE_TRANSFORM);
+        Vector2 velocity = ps->body_get_state(body_rid, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+        float mass = ps->body_get_param(body_rid, PhysicsServer2D::BODY_PARAM_MASS);
+        float gravity_scale = ps->body_get_param(body_rid, PhysicsServer2D::BODY_PARAM_GRAVITY_SCALE);
+        float linear_damp = ps->body_get_param(body_rid, PhysicsServer2D::BODY_PARAM_LINEAR_DAMP);
+
+        OrbitPredictor::BodyState body;
+        body.px = body_xf.get_origin().x;
+        body.py = body_xf.get_origin().y;
+        body.vx = velocity.x;
+        body.vy = velocity.y;
+        body.cx = center_xf.get_origin().x;
+        body.cy = center_xf.get_origin().y;
+        body.gx = default_gravity.x * gravity_scale;
+        body.gy = default_gravity.y * gravity_scale;
+        body.inv_mass = mass > 0.0f ? 1.0f / mass : 0.0f;
+        body.linear_damp = default_linear_damp + linear_damp; // "Combine" damp mode
+        body.params = orbit->get_orbit_params();
+        trajectory_bodies.push_back(body);
+    }
+
+    float step_time = 1.0f / (float)MAX(Engine::get_singleton()->get_physics_ticks_per_second(), 1);
+    predictor.submit(trajectory_bodies, trajectory_steps, step_time);
+}
+
 // Main drawing function for the debug visualizer
 void DebugVisualizer::_draw() {
+    PROFILE_ZONE("DebugVisualizer::_draw");
     Node *root = get_tree()->get_current_scene();
     if (!root) return;
 
-    // Step 1: Draw collision shapes if enabled
+    outline_points.clear();
+    outline_colors.clear();
+
+    // Outlines, trajectories and forces are all in global coordinates; draw them
+    // through the inverse of this node's transform so they land where they are
+    draw_set_transform_matrix(get_global_transform().affine_inverse());
+
+    // Step 1: Collect collision shape outlines; only transforms are read per frame
     if (show_collision_shapes) {
-        Vector<Node2D*> bodies;
-        gather_physics_bodies(root, bodies); // Collect all physics bodies
+        shape_registry.refresh_moving();
+
+        // Visible part of the canvas, in the same space the outlines are drawn in
+        Transform2D canvas_xform = get_viewport()->get_canvas_transform();
+        view_scale = MAX(canvas_xform.get_scale().x, 0.0001f);
 
-        for (int i = 0; i < bodies.size(); i++) {
-            Node2D *body2d = bodies[i];
+        const std::vector<PhysicsShapeRegistry::Entry> &entries = shape_registry.get_entries();
+        visible_shapes.clear();
+        if (cull_to_view) {
+            Rect2 view_rect = canvas_xform.affine_inverse().xform(get_viewport_rect());
+            shape_registry.query(view_rect, visible_shapes);
+        } else {
+            for (int i = 0; i < (int)entries.size(); i++) visible_shapes.push_back(i);
+        }
 
-            // Collect all collision shapes in the physics body
-            Vector<Node*> shape_nodes;
-            gather_collision_shapes(body2d, shape_nodes);
+        NativeStats::add(NativeStats::DEBUG_SHAPES, visible_shapes.size());
+        // Drawn shapes are always current; the rest catch up a few per frame
+        shape_registry.sync_some(SHAPE_SYNC_BUDGET);
+        for (int index : visible_shapes) {
+            shape_registry.sync_entry(index);
+            const PhysicsShapeRegistry::Entry &entry = entries[index];
+            if (entry.kind == PhysicsShapeRegistry::SHAPE_POLYGON) {
+                // Handle CollisionPolygon2D
+                CollisionPolygon2D *cpoly = static_cast<CollisionPolygon2D *>(entry.node);
+                if (cpoly->is_disabled() || entry.polygon.size() <= 2) continue;
 
-            for (int s = 0; s < shape_nodes.size(); s++) {
+                append_shape_outline(entry, cpoly->get_global_transform());
+            } else {
                 // Handle CollisionShape2D
-                CollisionShape2D *cshape = Object::cast_to<CollisionShape2D>(shape_nodes[s]);
-                if (cshape && !cshape->is_disabled()) {
-                    Ref<Shape2D> shape_ref = cshape->get_shape();
-                    if (shape_ref.is_valid()) {
-                        Transform2D gxf = cshape->get_global_transform();
-                        draw_shape_outline(shape_ref, gxf);
-                    }
-                }
-                // Handle CollisionPolygon2D
-                CollisionPolygon2D *cpoly = Object::cast_to<CollisionPolygon2D>(shape_nodes[s]);
-                if (cpoly && !cpoly->is_disabled()) {
-                    PackedVector2Array local_pts = cpoly->get_polygon();
-                    if (local_pts.size() > 2) {
-                        Transform2D cxf = cpoly->get_global_transform();
-                        PackedVector2Array xformed;
-                        xformed.resize(local_pts.size());
-                        for (int p = 0; p < local_pts.size(); p++) {
-                            xformed.set(p, cxf.xform(local_pts[p]));
-                        }
-                        draw_polyline(xformed, Color(1,1,0), 2.0f, false);
-                    }
-                }
+                CollisionShape2D *cshape = static_cast<CollisionShape2D *>(entry.node);
+                if (cshape->is_disabled() || !entry.shape.is_valid()) continue;
+
+                append_shape_outline(entry, cshape->get_global_transform());
             }
         }
     }
 
-    // Step 2: Draw force vectors from MagneticOrbit if enabled
+    // Step 2: Draw predicted orbit paths in one batched call
+    if (show_trajectories && trajectory_lines.size() >= 2) {
+        draw_multiline(trajectory_lines, trajectory_color, 1.0f);
+    }
+
+    // Step 3: Draw force vectors from MagneticOrbit if enabled
     if (show_forces && !magnetic_orbit_path.is_empty()) {
         MagneticOrbit *orbit = root->get_node<MagneticOrbit>(magnetic_orbit_path);
         if (orbit) {
@@ -139,59 +339,116 @@ void DebugVisualizer::_draw() {
                         Vector2 body_pos = body->get_global_position();
                         float scale = 0.05f;
                         Vector2 end_pos = body_pos + (force_vec * scale);
-                        draw_line(body_pos, end_pos, Color(1,0,0), 2.0f, false);
+                        outline_points.push_back(body_pos);
+                        outline_points.push_back(end_pos);
+                        append_segments(1, Color(1,0,0));
                     }
                 }
             }
         }
     }
-}
 
-// Recursive function to collect physics bodies (RigidBody2D, CharacterBody2D, StaticBody2D)
-void DebugVisualizer::gather_physics_bodies(Node *p_node, Vector<Node2D *> &bodies) {
-    if (!p_node) return;
-    if (Node2D *n2d = Object::cast_to<Node2D>(p_node)) {
-        if (Object::cast_to<RigidBody2D>(n2d) ||
-            Object::cast_to<CharacterBody2D>(n2d) ||
-            Object::cast_to<StaticBody2D>(n2d))
-        {
-            bodies.push_back(n2d);
-        }
-    }
-    int cc = p_node->get_child_count();
-    for (int i = 0; i < cc; i++) {
-        gather_physics_bodies(p_node->get_child(i), bodies);
+    flush_outlines();
+    draw_set_transform_matrix(Transform2D());
+
+    // Step 4: Frame-time graph on top of everything else
+    if (show_frame_graph) {
+        draw_frame_graph();
     }
 }
 
-// Recursive function to collect collision shapes
-void DebugVisualizer::gather_collision_shapes(Node *p_node, Vector<Node*> &shapes) {
-    if (!p_node) return;
-    if (Object::cast_to<CollisionShape2D>(p_node) ||
-        Object::cast_to<CollisionPolygon2D>(p_node))
-    {
-        shapes.push_back(p_node);
-    }
-    int cc = p_node->get_child_count();
-    for (int i = 0; i < cc; i++) {
-        gather_collision_shapes(p_node->get_child(i), shapes);
-    }
+void DebugVisualizer::append_segments(int count, const Color &color) {
+    outline_colors.insert(outline_colors.end(), count, color);
+}
+
+// Roughly one segment per 4 on-screen pixels of circumference, capped at the old 24
+int DebugVisualizer::circle_segments_for(float radius) const {
+    float screen_radius = radius * view_scale;
+    return CLAMP((int)(screen_radius * 1.5f), 6, 24);
+}
+
+void DebugVisualizer::flush_outlines() {
+    if (outline_points.empty()) return;
+
+    batch_points.resize((int64_t)outline_points.size());
+    batch_colors.resize((int64_t)outline_colors.size());
+    Vector2 *pw = batch_points.ptrw();
+    for (size_t i = 0; i < outline_points.size(); i++) pw[i] = outline_points[i];
+    Color *cw = batch_colors.ptrw();
+    for (size_t i = 0; i < outline_colors.size(); i++) cw[i] = outline_colors[i];
+
+    draw_multiline_colors(batch_points, batch_colors, 2.0f);
 }
 
-// Function to draw outlines of different shape types
-void DebugVisualizer::draw_shape_outline(const Ref<Shape2D> &shape, const Transform2D &global_xform) {
-    if (!shape.is_valid()) return;
+// One bar per recorded frame, scaled so the budget line sits at half height.
+// Drawn in screen pixels by undoing the canvas and node transforms.
+void DebugVisualizer::draw_frame_graph() {
+    FrameRecorder *recorder = FrameRecorder::get_singleton();
+    if (!recorder) return;
 
-    if (Object::cast_to<RectangleShape2D>(*shape)) {
-        RectangleShape2D *rect_shape = Object::cast_to<RectangleShape2D>(*shape);
+    graph_samples.resize(frame_graph_frames);
+    int count = recorder->copy_recent(graph_samples.data(), frame_graph_frames);
+    if (count == 0) return;
+
+    const Vector2 origin(10.0f, 10.0f);
+    const Vector2 size(2.0f * frame_graph_frames, 100.0f);
+    const float budget = recorder->get_frame_budget_ms();
+    const float ms_to_px = size.y / (budget * 2.0f);
+
+    draw_set_transform_matrix(get_global_transform_with_canvas().affine_inverse());
+    draw_rect(Rect2(origin, size), Color(0, 0, 0, 0.5), true);
+
+    outline_points.clear();
+    outline_colors.clear();
+    float worst = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float ms = graph_samples[i].frame_ms;
+        worst = MAX(worst, ms);
+        float x = origin.x + size.x - (count - i) * 2.0f + 1.0f;
+        float bottom = origin.y + size.y;
+        outline_points.push_back(Vector2(x, bottom));
+        outline_points.push_back(Vector2(x, bottom - MIN(ms * ms_to_px, size.y)));
+        outline_colors.push_back(ms > budget ? Color(1, 0.2, 0.2) : Color(0.2, 1, 0.4));
+    }
+
+    // Budget line
+    float budget_y = origin.y + size.y - budget * ms_to_px;
+    outline_points.push_back(Vector2(origin.x, budget_y));
+    outline_points.push_back(Vector2(origin.x + size.x, budget_y));
+    outline_colors.push_back(Color(1, 1, 0, 0.8));
+
+    flush_outlines();
+
+    String label = "frame " + String::num(graph_samples[count - 1].frame_ms, 1) + " ms  max " + String::num(worst, 1) + " ms";
+    draw_string(ThemeDB::get_singleton()->get_fallback_font(), origin + Vector2(4, 14), label, HORIZONTAL_ALIGNMENT_LEFT, -1, -1, Color(1, 1, 1));
+    draw_set_transform_matrix(Transform2D());
+}
+
+// Function to collect outlines of different shape types
+void DebugVisualizer::append_shape_outline(const PhysicsShapeRegistry::Entry &entry, const Transform2D &global_xform) {
+    // The shape kind was resolved when the entry was registered, so no casts here
+    if (entry.kind == PhysicsShapeRegistry::SHAPE_RECT) {
+        RectangleShape2D *rect_shape = static_cast<RectangleShape2D *>(*entry.shape);
         Vector2 size = rect_shape->get_size();
         Rect2 local_rect(Vector2(-size.x * 0.5f, -size.y * 0.5f), size);
-        draw_rect(local_rect, Color(1, 1, 0), false);
+        append_segments(DebugDraw::append_rect(outline_points, global_xform, local_rect), Color(1, 1, 0));
 
-    } else if (Object::cast_to<CircleShape2D>(*shape)) {
-        CircleShape2D *circle = Object::cast_to<CircleShape2D>(*shape);
+    } else if (entry.kind == PhysicsShapeRegistry::SHAPE_CIRCLE) {
+        CircleShape2D *circle = static_cast<CircleShape2D *>(*entry.shape);
         float radius = circle->get_radius();
-        draw_arc(global_xform.get_origin(), radius, 0, 2 * Math_PI, 24, Color(1,0,0), 2.0f, false);
+        append_segments(DebugDraw::append_circle(outline_points, global_xform.get_origin(), radius, circle_segments_for(radius)), Color(1,0,0));
+
+    } else if (entry.kind == PhysicsShapeRegistry::SHAPE_POLYGON) {
+        // Closed outline through the cached local points
+        int count = entry.polygon.size();
+        Vector2 prev = global_xform.xform(entry.polygon[count - 1]);
+        for (int p = 0; p < count; p++) {
+            Vector2 next = global_xform.xform(entry.polygon[p]);
+            outline_points.push_back(prev);
+            outline_points.push_back(next);
+            prev = next;
+        }
+        append_segments(count, Color(1,1,0));
 
     } else {
         draw_string(Ref<Font>(), global_xform.get_origin(), "[Unknown Shape2D]", HORIZONTAL_ALIGNMENT_LEFT, -1, -1, Color(1,1,0,1));
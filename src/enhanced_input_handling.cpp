@@ -4,6 +4,10 @@
 #include <godot_cpp/classes/input.hpp>
 #include <godot_cpp/classes/engine.hpp>
 
+#include "input_buffer.h"
+#include "input_latency.h"
+#include "input_snapshot.h"
+
 using namespace godot;
 
 void EnhancedInputHandling::_bind_methods() {
@@ -37,17 +41,41 @@ void EnhancedInputHandling::_init() {
     }
 }
 
-void EnhancedInputHandling::_process(double delta) {
+void EnhancedInputHandling::_ready() {
+    if (Engine::get_singleton()->is_editor_hint()) {
+        return;
+    }
+
+    // Look the actions up once; the snapshot polls them for everyone each frame
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    if (snapshot) {
+        action_up = snapshot->register_action("ui_up");
+        action_down = snapshot->register_action("ui_down");
+        action_left = snapshot->register_action("ui_left");
+        action_right = snapshot->register_action("ui_right");
+        action_sprint = snapshot->register_action("sprint");
+        action_attack = snapshot->register_action("attack");
+    }
+
+    // Movement comes from the per-tick commands the buffer builds out of the raw events
+    InputBuffer *buffer = InputBuffer::get_singleton();
+    if (buffer) {
+        buffer->listen();
+    }
+}
+
+// Runs on the physics tick so motion doesn't depend on the render rate
+void EnhancedInputHandling::_physics_process(double delta) {
     // Skip logic in editor
     if (Engine::get_singleton()->is_editor_hint()) {
         return;
     }
 
-    Input* input = Input::get_singleton();
-    if (!input) return;
+    InputBuffer *buffer = InputBuffer::get_singleton();
+    if (!buffer) return;
 
     // 1) Check if the "sprint" action is pressed (mapped to Space in Input Map)
-    bool sprint_pressed = input->is_action_pressed("sprint");
+    bool sprint_pressed = buffer->is_held(action_sprint) || buffer->was_pressed(action_sprint);
     
     if( sprint_pressed){
         //UtilityFunctions::print("EnhancedInputHandling: Sprint triggered!");
@@ -57,29 +85,21 @@ void EnhancedInputHandling::_process(double delta) {
     double effective_speed = sprint_pressed ? sprint_speed : base_speed;
     //UtilityFunctions::print("Effective speed: ", effective_speed);
 
-    // 2) Movement logic: is_action_pressed for "ui_up", "ui_left", etc.
-    Vector2 direction(0, 0);
-    if (input->is_action_pressed("ui_up")) {
-        direction.y -= 1;
-    }
-    if (input->is_action_pressed("ui_down")) {
-        direction.y += 1;
-    }
-    if (input->is_action_pressed("ui_left")) {
-        direction.x -= 1;
-    }
-    if (input->is_action_pressed("ui_right")) {
-        direction.x += 1;
-    }
+    // 2) Movement logic: how much of this tick "ui_up", "ui_left", etc. were held,
+    // so a tap shorter than a tick still moves a little
+    Vector2 direction = buffer->get_vector(action_left, action_right, action_up, action_down);
 
-    // 3) Attack logic: If "attack" action is just pressed (mapped to F)
-    if (input->is_action_just_pressed("attack")) {
+    // 3) Attack logic: If "attack" action went down during this tick (mapped to F)
+    if (buffer->was_pressed(action_attack)) {
 
         //UtilityFunctions::print("EnhancedInputHandling: Attack triggered!");
     }
 
     // 4) Move the node
-    move(direction.normalized() * (float)effective_speed * (float)delta);
+    move(direction * (float)effective_speed * (float)delta);
+    if (InputLatency::get_singleton()) {
+        latency_moving = InputLatency::get_singleton()->mark_movement(latency_moving, direction.length());
+    }
 
     // Let the GDScript see the new speed
     Node *parent = get_parent(); // the CharacterBody2D
@@ -18,6 +18,15 @@ private:
     // For Inspector
     double current_speed = 100.0; // We expose this with get_speed/set_speed
 
+    // InputSnapshot indices, resolved in _ready
+    int action_up = -1;
+    int action_down = -1;
+    int action_left = -1;
+    int action_right = -1;
+    int action_sprint = -1;
+    int action_attack = -1;
+    bool latency_moving = false;  // for InputLatency::mark_movement
+
 public:
     EnhancedInputHandling();
     ~EnhancedInputHandling();
@@ -26,7 +35,8 @@ public:
     void set_speed(const double p_speed);
 
     virtual void _init();
-    virtual void _process(double delta) override;
+    virtual void _ready() override;
+    virtual void _physics_process(double delta) override;
 
     // The function that actually translates the node
     void move(Vector2 direction);
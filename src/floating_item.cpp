@@ -1,7 +1,6 @@
 #include "floating_item.h"
 
 #include <godot_cpp/core/class_db.hpp>
-#include <godot_cpp/variant/utility_functions.hpp>
 
 // For positions, collisions, etc.
 #include <godot_cpp/classes/node2d.hpp>
@@ -10,6 +9,10 @@
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/engine.hpp>
 
+#include "collectible_pool.h"
+#include "game_event_bus.h"
+#include "hover_system.h"
+
 using namespace godot;
 
 void FloatingItem::_bind_methods() {
@@ -31,6 +34,8 @@ void FloatingItem::_bind_methods() {
     // Collision callbacks
     ClassDB::bind_method(D_METHOD("_on_body_entered", "body"), &FloatingItem::_on_body_entered);
     ClassDB::bind_method(D_METHOD("collect_item", "player"), &FloatingItem::collect_item);
+    ClassDB::bind_method(D_METHOD("_pool_reset"), &FloatingItem::_pool_reset);
+    ClassDB::bind_method(D_METHOD("_hover_wake_changed", "awake"), &FloatingItem::_hover_wake_changed);
 }
 
 // Constructor / destructor
@@ -49,6 +54,41 @@ void FloatingItem::_ready() {
 
     // Connect collision detection
     connect("body_entered", Callable(this, "_on_body_entered"));
+
+    if (!Engine::get_singleton()->is_editor_hint()) {
+        _register_hover();
+    }
+}
+
+// _ready only runs once; an item coming back from CollectiblePool re-registers here
+void FloatingItem::_enter_tree() {
+    if (is_node_ready() && !Engine::get_singleton()->is_editor_hint()) {
+        base_local_y = get_position().y;
+        _register_hover();
+    }
+}
+
+void FloatingItem::_exit_tree() {
+    HoverSystem *hover = HoverSystem::get_singleton();
+    if (hover) {
+        hover->remove_item(this);
+    }
+}
+
+void FloatingItem::_register_hover() {
+    HoverSystem *hover = HoverSystem::get_singleton();
+    Node2D *visual = Object::cast_to<Node2D>(get_node_or_null(NodePath("Sprite2D")));
+    if (!hover || !visual) {
+        return;
+    }
+
+    hover->add_item_2d(this, visual, float_amplitude, float_speed, distance);
+    set_process(false);
+}
+
+void FloatingItem::_hover_wake_changed(bool p_awake) {
+    // Deferred: wakes can happen while physics queries are being flushed
+    set_deferred("monitoring", p_awake);
 }
 
 // Called every rendered frame
@@ -115,14 +155,33 @@ void FloatingItem::_on_body_entered(Node *body) {
 
 // Called to finalize collection logic
 void FloatingItem::collect_item(Node *player) {
-    UtilityFunctions::print("FloatingItem collected by: ", player->get_name());
-    // Remove item from scene
-    queue_free();
+    GameEventBus *bus = GameEventBus::get_singleton();
+    if (bus) {
+        const Vector2 pos = get_global_position();
+        bus->push(GameEventBus::EVENT_PICKUP, get_instance_id(), player ? player->get_instance_id() : 0, 1.0f,
+                Vector3(pos.x, pos.y, 0.0f));
+    }
+
+    // Back to the pool (or freed when there is none); this runs inside body_entered,
+    // so the pool detaches the item at the end of the frame
+    set_deferred("monitoring", false);
+    CollectiblePool *pool = CollectiblePool::get_singleton();
+    if (pool) {
+        pool->release(this);
+    } else {
+        queue_free();
+    }
+}
+
+void FloatingItem::_pool_reset() {
+    time = 0.0f;
+    set_monitoring(true);
 }
 
 // Accessors for amplitude/speed
 void FloatingItem::set_float_amplitude(float amp) {
     float_amplitude = amp;
+    if (HoverSystem::get_singleton() && HoverSystem::get_singleton()->has_item(this)) _register_hover();
 }
 float FloatingItem::get_float_amplitude() const {
     return float_amplitude;
@@ -130,6 +189,7 @@ float FloatingItem::get_float_amplitude() const {
 
 void FloatingItem::set_float_speed(float spd) {
     float_speed = spd;
+    if (HoverSystem::get_singleton() && HoverSystem::get_singleton()->has_item(this)) _register_hover();
 }
 float FloatingItem::get_float_speed() const {
     return float_speed;
@@ -138,6 +198,7 @@ float FloatingItem::get_float_speed() const {
 // Accessors for distance property
 void FloatingItem::set_distance(float dist) {
     distance = dist;
+    if (HoverSystem::get_singleton() && HoverSystem::get_singleton()->has_item(this)) _register_hover();
 }
 float FloatingItem::get_distance() const {
     return distance;
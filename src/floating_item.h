@@ -19,17 +19,27 @@ private:
 
     float distance = 50.0f; // default radius in inspector
 
+    // Hands the bobbing to HoverSystem; _process only runs when that isn't possible
+    void _register_hover();
+
 public:
     FloatingItem();
     ~FloatingItem();
 
     // Godot callbacks
     void _ready() override;
+    void _enter_tree() override;
+    void _exit_tree() override;
     void _process(double delta) override;
 
     // If something enters collision, we handle it or call collect
     void _on_body_entered(Node *body);
     void collect_item(Node *player);
+    // CollectiblePool: called when the item is parked for reuse
+    void _pool_reset();
+
+    // HoverSystem: nothing to detect while the player is cells away
+    void _hover_wake_changed(bool p_awake);
 
     // Floating amplitude/speed
     void set_float_amplitude(float amp);
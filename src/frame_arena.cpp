@@ -0,0 +1,97 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+
+#include "native_stats.h"
+
+using namespace godot;
+
+FrameArena::FrameArena(size_t p_block_size) :
+        block_size(std::max<size_t>(p_block_size, 256)) {
+}
+
+FrameArena &FrameArena::frame(uint64_t p_frame) {
+    static FrameArena main_arena;
+    main_arena.begin_frame(p_frame);
+    return main_arena;
+}
+
+void FrameArena::begin_frame(uint64_t p_frame) {
+    if (p_frame != current_frame) {
+        reset();
+        current_frame = p_frame;
+    }
+}
+
+void FrameArena::reset() {
+    // Counters are published once per frame rather than per allocation
+    NativeStats::add(NativeStats::FRAME_ARENA_ALLOCATIONS, frame_allocations);
+    NativeStats::add(NativeStats::FRAME_ARENA_BYTES, frame_bytes);
+
+    // Replace an overflowed chain with a single block as large as the whole chain
+    if (blocks.size() > 1) {
+        const size_t total = get_capacity();
+        blocks.clear();
+        _add_block(total);
+    }
+
+    current = 0;
+    offset = 0;
+    used_before = 0;
+    frame_allocations = 0;
+    frame_bytes = 0;
+}
+
+void FrameArena::_add_block(size_t p_min_size) {
+    Block block;
+    block.size = std::max(block_size, p_min_size);
+    block.data.reset(new unsigned char[block.size]);
+    blocks.push_back(std::move(block));
+
+    heap_blocks++;
+    NativeStats::add(NativeStats::FRAME_ARENA_HEAP_BLOCKS);
+}
+
+void *FrameArena::allocate(size_t p_size, size_t p_align) {
+    if (p_size == 0) p_size = 1;
+    frame_allocations++;
+    frame_bytes += p_size;
+
+    if (blocks.empty()) {
+        _add_block(p_size + p_align);
+    }
+
+    while (true) {
+        Block &block = blocks[current];
+        const uintptr_t base = (uintptr_t)block.data.get();
+        const uintptr_t aligned = (base + offset + p_align - 1) & ~(uintptr_t)(p_align - 1);
+        if (aligned + p_size <= base + block.size) {
+            offset = aligned + p_size - base;
+            high_water = std::max(high_water, used_before + offset);
+            return (void *)aligned;
+        }
+
+        // Spill into the next block, growing the chain if needed
+        used_before += offset;
+        offset = 0;
+        current++;
+        if (current == blocks.size()) {
+            _add_block(std::max(p_size + p_align, blocks.back().size * 2));
+        }
+    }
+}
+
+void FrameArena::release(void *p_ptr, size_t p_size) {
+    if (blocks.empty() || !p_ptr) return;
+
+    const uintptr_t base = (uintptr_t)blocks[current].data.get();
+    if ((uintptr_t)p_ptr + p_size == base + offset) {
+        offset = (uintptr_t)p_ptr - base;
+    }
+}
+
+size_t FrameArena::get_capacity() const {
+    size_t total = 0;
+    for (const Block &block : blocks) total += block.size;
+    return total;
+}
@@ -0,0 +1,96 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace godot {
+
+// Bump allocator for scratch memory that only lives until the end of the frame.
+// Nothing is freed individually; the whole arena is rewound when a new frame
+// starts. If a frame overflowed into extra blocks they are merged into one on
+// rewind, so once the working set is known, frames stop touching the heap.
+//
+// Not thread-safe: FrameArena::frame() is the main thread's arena.
+class FrameArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit FrameArena(size_t p_block_size = DEFAULT_BLOCK_SIZE);
+
+    // Main-thread arena, rewound the first time it is used in a new process frame.
+    // Pass Engine::get_process_frames().
+    static FrameArena &frame(uint64_t p_frame);
+
+    void begin_frame(uint64_t p_frame);
+    void reset();
+
+    void *allocate(size_t p_size, size_t p_align);
+    // Only the most recent allocation is given back (lets a growing vector reuse its tail)
+    void release(void *p_ptr, size_t p_size);
+
+    uint64_t get_frame_allocations() const { return frame_allocations; }
+    size_t get_frame_bytes() const { return frame_bytes; }
+    size_t get_high_water() const { return high_water; } // most bytes in use at once, any frame
+    size_t get_capacity() const;
+    uint64_t get_heap_blocks() const { return heap_blocks; } // blocks allocated since construction
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+    };
+
+    void _add_block(size_t p_min_size);
+
+    size_t block_size;
+    std::vector<Block> blocks;
+    size_t current = 0;     // block being bumped
+    size_t offset = 0;      // first free byte in the current block
+    size_t used_before = 0; // bytes in the blocks before the current one
+
+    uint64_t current_frame = UINT64_MAX;
+    uint64_t frame_allocations = 0;
+    size_t frame_bytes = 0;
+    size_t high_water = 0;
+    uint64_t heap_blocks = 0;
+};
+
+// std allocator backed by a FrameArena. Containers using it must not outlive the frame.
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena &p_arena) :
+            arena(&p_arena) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &p_other) :
+            arena(p_other.arena) {}
+
+    T *allocate(size_t p_count) {
+        return static_cast<T *>(arena->allocate(p_count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p_ptr, size_t p_count) {
+        arena->release(p_ptr, p_count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U> &p_other) const { return arena == p_other.arena; }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U> &p_other) const { return arena != p_other.arena; }
+
+    FrameArena *arena;
+};
+
+// Reserve up front: each reallocation leaves the old buffer behind until the frame ends
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace godot
+
+#endif // FRAME_ARENA_H
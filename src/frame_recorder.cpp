@@ -0,0 +1,333 @@
+#include "frame_recorder.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+FrameRecorder *FrameRecorder::singleton = nullptr;
+
+void FrameRecorder::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &FrameRecorder::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &FrameRecorder::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    ClassDB::bind_method(D_METHOD("set_frame_budget_ms", "ms"), &FrameRecorder::set_frame_budget_ms);
+    ClassDB::bind_method(D_METHOD("get_frame_budget_ms"), &FrameRecorder::get_frame_budget_ms);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "frame_budget_ms"), "set_frame_budget_ms", "get_frame_budget_ms");
+
+    ClassDB::bind_method(D_METHOD("set_capacity", "frames"), &FrameRecorder::set_capacity);
+    ClassDB::bind_method(D_METHOD("get_capacity"), &FrameRecorder::get_capacity);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "capacity"), "set_capacity", "get_capacity");
+
+    ClassDB::bind_method(D_METHOD("set_frames_before", "frames"), &FrameRecorder::set_frames_before);
+    ClassDB::bind_method(D_METHOD("get_frames_before"), &FrameRecorder::get_frames_before);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "frames_before"), "set_frames_before", "get_frames_before");
+
+    ClassDB::bind_method(D_METHOD("set_frames_after", "frames"), &FrameRecorder::set_frames_after);
+    ClassDB::bind_method(D_METHOD("get_frames_after"), &FrameRecorder::get_frames_after);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "frames_after"), "set_frames_after", "get_frames_after");
+
+    ClassDB::bind_method(D_METHOD("set_min_dump_interval", "seconds"), &FrameRecorder::set_min_dump_interval);
+    ClassDB::bind_method(D_METHOD("get_min_dump_interval"), &FrameRecorder::get_min_dump_interval);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_dump_interval"), "set_min_dump_interval", "get_min_dump_interval");
+
+    ClassDB::bind_method(D_METHOD("set_snapshot_dir", "dir"), &FrameRecorder::set_snapshot_dir);
+    ClassDB::bind_method(D_METHOD("get_snapshot_dir"), &FrameRecorder::get_snapshot_dir);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "snapshot_dir", PROPERTY_HINT_DIR), "set_snapshot_dir", "get_snapshot_dir");
+
+    ClassDB::bind_method(D_METHOD("get_last_snapshot_path"), &FrameRecorder::get_last_snapshot_path);
+    ClassDB::bind_method(D_METHOD("add_projectiles", "delta"), &FrameRecorder::add_projectiles);
+    ClassDB::bind_method(D_METHOD("get_projectile_count"), &FrameRecorder::get_projectile_count);
+    ClassDB::bind_method(D_METHOD("get_frame_times", "count"), &FrameRecorder::get_frame_times, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("get_counter_history", "counter", "count"), &FrameRecorder::get_counter_history, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("dump_snapshot"), &FrameRecorder::dump_snapshot);
+    ClassDB::bind_method(D_METHOD("_record_frame"), &FrameRecorder::_record_frame);
+
+    BIND_CONSTANT(COUNTER_AI_DECISIONS);
+    BIND_CONSTANT(COUNTER_MINIMAP_MARKERS);
+    BIND_CONSTANT(COUNTER_ORBIT_BODIES);
+    BIND_CONSTANT(COUNTER_DEBUG_SHAPES);
+    BIND_CONSTANT(COUNTER_PHYSICS_BODIES);
+    BIND_CONSTANT(COUNTER_PROJECTILES);
+    BIND_CONSTANT(COUNTER_DRAW_CALLS);
+    BIND_CONSTANT(COUNTER_NODES);
+}
+
+FrameRecorder *FrameRecorder::get_singleton() {
+    return singleton;
+}
+
+FrameRecorder::FrameRecorder() {
+    singleton = this;
+    ring.resize(600);
+
+    // Editor redraws come in bursts with long gaps that aren't game hitches
+    if (Engine::get_singleton()->is_editor_hint()) {
+        enabled = false;
+        return;
+    }
+
+    // Sample after the frame has been drawn so draw call counts are final
+    RenderingServer::get_singleton()->connect("frame_post_draw", Callable(this, "_record_frame"));
+}
+
+FrameRecorder::~FrameRecorder() {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (rs && rs->is_connected("frame_post_draw", Callable(this, "_record_frame"))) {
+        rs->disconnect("frame_post_draw", Callable(this, "_record_frame"));
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void FrameRecorder::set_enabled(bool p_enabled) {
+    enabled = p_enabled && !Engine::get_singleton()->is_editor_hint();
+    last_frame_usec = 0; // don't report the paused time as one huge frame
+}
+
+bool FrameRecorder::is_enabled() const {
+    return enabled;
+}
+
+void FrameRecorder::set_frame_budget_ms(float p_ms) {
+    frame_budget_ms = MAX(p_ms, 0.1f);
+}
+
+float FrameRecorder::get_frame_budget_ms() const {
+    return frame_budget_ms;
+}
+
+// Resizing drops the recorded history
+void FrameRecorder::set_capacity(int p_frames) {
+    ring.assign(MAX(p_frames, 16), FrameSample());
+    frames_written.store(0, std::memory_order_release);
+    dump_pending = false;
+}
+
+int FrameRecorder::get_capacity() const {
+    return (int)ring.size();
+}
+
+void FrameRecorder::set_frames_before(int p_frames) {
+    frames_before = MAX(p_frames, 0);
+}
+
+int FrameRecorder::get_frames_before() const {
+    return frames_before;
+}
+
+void FrameRecorder::set_frames_after(int p_frames) {
+    frames_after = MAX(p_frames, 0);
+}
+
+int FrameRecorder::get_frames_after() const {
+    return frames_after;
+}
+
+void FrameRecorder::set_min_dump_interval(float p_seconds) {
+    min_dump_interval = MAX(p_seconds, 0.0f);
+}
+
+float FrameRecorder::get_min_dump_interval() const {
+    return min_dump_interval;
+}
+
+void FrameRecorder::set_snapshot_dir(const String &p_dir) {
+    snapshot_dir = p_dir;
+}
+
+String FrameRecorder::get_snapshot_dir() const {
+    return snapshot_dir;
+}
+
+String FrameRecorder::get_last_snapshot_path() const {
+    return last_snapshot_path;
+}
+
+void FrameRecorder::add_projectiles(int p_delta) {
+    live_projectiles = MAX(live_projectiles + p_delta, (int64_t)0);
+}
+
+int64_t FrameRecorder::get_projectile_count() const {
+    return live_projectiles;
+}
+
+int FrameRecorder::copy_recent(FrameSample *r_samples, int p_count) const {
+    const uint64_t written = frames_written.load(std::memory_order_acquire);
+    const uint64_t cap = ring.size();
+    uint64_t count = MIN((uint64_t)MAX(p_count, 0), MIN(written, cap));
+    for (uint64_t i = 0; i < count; i++) {
+        r_samples[i] = ring[(written - count + i) % cap];
+    }
+    return (int)count;
+}
+
+PackedFloat32Array FrameRecorder::get_frame_times(int p_count) const {
+    std::vector<FrameSample> samples(p_count > 0 ? MIN(p_count, (int)ring.size()) : ring.size());
+    int count = copy_recent(samples.data(), (int)samples.size());
+
+    PackedFloat32Array result;
+    result.resize(count);
+    for (int i = 0; i < count; i++) {
+        result.set(i, samples[i].frame_ms);
+    }
+    return result;
+}
+
+PackedInt32Array FrameRecorder::get_counter_history(int p_counter, int p_count) const {
+    PackedInt32Array result;
+    ERR_FAIL_INDEX_V(p_counter, COUNTER_MAX, result);
+
+    std::vector<FrameSample> samples(p_count > 0 ? MIN(p_count, (int)ring.size()) : ring.size());
+    int count = copy_recent(samples.data(), (int)samples.size());
+
+    result.resize(count);
+    for (int i = 0; i < count; i++) {
+        result.set(i, (int32_t)samples[i].counters[p_counter]);
+    }
+    return result;
+}
+
+// Paused or alt-tabbed frames stall on purpose (the OS throttles unfocused
+// windows); headless runs never get focus, so they always count
+bool FrameRecorder::_should_skip_frame() const {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || tree->is_paused()) return true;
+
+    Window *root = tree->get_root();
+    DisplayServer *display = DisplayServer::get_singleton();
+    return root && !root->has_focus() && display && display->get_name() != "headless";
+}
+
+void FrameRecorder::_record_frame() {
+    if (!enabled) return;
+
+    if (_should_skip_frame()) {
+        // Resume with a fresh frame time and without the skipped frames' counts
+        last_frame_usec = 0;
+        for (int i = 0; i < NativeStats::COUNTER_MAX; i++) {
+            last_native[i] = NativeStats::get((NativeStats::Counter)i);
+        }
+        return;
+    }
+
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+    Performance *perf = Performance::get_singleton();
+
+    FrameSample sample;
+    sample.frame = Engine::get_singleton()->get_process_frames();
+    sample.timestamp_usec = now;
+    sample.frame_ms = last_frame_usec ? (float)(now - last_frame_usec) * 0.001f : 0.0f;
+    sample.process_ms = (float)perf->get_monitor(Performance::TIME_PROCESS) * 1000.0f;
+    sample.physics_ms = (float)perf->get_monitor(Performance::TIME_PHYSICS_PROCESS) * 1000.0f;
+    last_frame_usec = now;
+
+    // Native counters are totals; store what happened during this frame
+    uint64_t delta[NativeStats::COUNTER_MAX];
+    for (int i = 0; i < NativeStats::COUNTER_MAX; i++) {
+        uint64_t total = NativeStats::get((NativeStats::Counter)i);
+        delta[i] = total - last_native[i];
+        last_native[i] = total;
+    }
+    sample.counters[COUNTER_AI_DECISIONS] = (uint32_t)delta[NativeStats::AI_DECISIONS];
+    sample.counters[COUNTER_MINIMAP_MARKERS] = (uint32_t)delta[NativeStats::MINIMAP_MARKERS];
+    sample.counters[COUNTER_ORBIT_BODIES] = (uint32_t)delta[NativeStats::ORBIT_BODIES];
+    sample.counters[COUNTER_DEBUG_SHAPES] = (uint32_t)delta[NativeStats::DEBUG_SHAPES];
+
+    sample.counters[COUNTER_PHYSICS_BODIES] = (uint32_t)(perf->get_monitor(Performance::PHYSICS_2D_ACTIVE_OBJECTS) +
+                                                         perf->get_monitor(Performance::PHYSICS_3D_ACTIVE_OBJECTS));
+    sample.counters[COUNTER_DRAW_CALLS] = (uint32_t)perf->get_monitor(Performance::RENDER_TOTAL_DRAW_CALLS_IN_FRAME);
+    sample.counters[COUNTER_NODES] = (uint32_t)perf->get_monitor(Performance::OBJECT_NODE_COUNT);
+    sample.counters[COUNTER_PROJECTILES] = (uint32_t)live_projectiles;
+
+    _write_sample(sample);
+}
+
+void FrameRecorder::_write_sample(FrameSample &r_sample) {
+    const uint64_t index = frames_written.load(std::memory_order_relaxed);
+    ring[index % ring.size()] = r_sample;
+    frames_written.store(index + 1, std::memory_order_release);
+
+    // Remember the first spike, then wait until its trailing frames are recorded
+    if (!dump_pending && r_sample.frame_ms > frame_budget_ms) {
+        bool cooled_down = last_dump_usec == 0 ||
+                           r_sample.timestamp_usec - last_dump_usec >= (uint64_t)(min_dump_interval * 1000000.0f);
+        if (cooled_down) {
+            dump_pending = true;
+            pending_spike_index = index;
+        }
+    }
+
+    if (dump_pending && index >= pending_spike_index + frames_after) {
+        const uint64_t end = index + 1;
+        const uint64_t oldest = end > ring.size() ? end - ring.size() : 0;
+        const uint64_t wanted = pending_spike_index > (uint64_t)frames_before ? pending_spike_index - frames_before : 0;
+        const uint64_t spike_frame = ring[pending_spike_index % ring.size()].frame;
+
+        last_snapshot_path = _write_snapshot(MAX(oldest, wanted), end, spike_frame);
+        last_dump_usec = r_sample.timestamp_usec;
+        dump_pending = false;
+    }
+}
+
+String FrameRecorder::dump_snapshot() {
+    const uint64_t end = frames_written.load(std::memory_order_acquire);
+    if (end == 0) return String();
+
+    const uint64_t window = MIN((uint64_t)(frames_before + frames_after + 1), MIN(end, (uint64_t)ring.size()));
+    last_snapshot_path = _write_snapshot(end - window, end, ring[(end - 1) % ring.size()].frame);
+    return last_snapshot_path;
+}
+
+// Little-endian layout:
+//   u32 magic, u32 version, f32 budget_ms, u32 counter_count, u32 sample_count, u64 spike_frame
+//   per sample: u64 frame, u64 timestamp_usec, f32 frame_ms, f32 process_ms, f32 physics_ms,
+//               u32 counters[counter_count]
+String FrameRecorder::_write_snapshot(uint64_t p_first, uint64_t p_end, uint64_t p_spike_frame) {
+    DirAccess::make_dir_recursive_absolute(snapshot_dir);
+
+    String file_name = "spike_" + String::num_uint64((uint64_t)Time::get_singleton()->get_unix_time_from_system()) +
+                       "_" + String::num_uint64(p_spike_frame) + ".bin";
+    String path = snapshot_dir.path_join(file_name);
+
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        UtilityFunctions::push_warning("FrameRecorder: could not write ", path);
+        return String();
+    }
+
+    file->store_32(SNAPSHOT_MAGIC);
+    file->store_32(SNAPSHOT_VERSION);
+    file->store_float(frame_budget_ms);
+    file->store_32(COUNTER_MAX);
+    file->store_32((uint32_t)(p_end - p_first));
+    file->store_64(p_spike_frame);
+
+    for (uint64_t i = p_first; i < p_end; i++) {
+        const FrameSample &sample = ring[i % ring.size()];
+        file->store_64(sample.frame);
+        file->store_64(sample.timestamp_usec);
+        file->store_float(sample.frame_ms);
+        file->store_float(sample.process_ms);
+        file->store_float(sample.physics_ms);
+        for (int c = 0; c < COUNTER_MAX; c++) {
+            file->store_32(sample.counters[c]);
+        }
+    }
+    file->close();
+
+    UtilityFunctions::print("FrameRecorder: frame spike written to ", path);
+    return path;
+}
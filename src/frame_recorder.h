@@ -0,0 +1,133 @@
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include "native_stats.h"
+
+namespace godot {
+
+// Always-on flight recorder for frame spikes.
+// Once per frame (RenderingServer.frame_post_draw) the frame time and a set of
+// counters are written to a ring of the last N frames. When a frame goes over
+// the budget, the frames around it are written to user://frame_spikes/ as a
+// small binary file so hitches can be looked at after the fact.
+class FrameRecorder : public Object {
+    GDCLASS(FrameRecorder, Object);
+
+public:
+    enum Counter {
+        COUNTER_AI_DECISIONS = 0,
+        COUNTER_MINIMAP_MARKERS,
+        COUNTER_ORBIT_BODIES,
+        COUNTER_DEBUG_SHAPES,
+        COUNTER_PHYSICS_BODIES,   // active 2D + 3D physics objects
+        COUNTER_PROJECTILES,      // live projectiles, as reported through add_projectiles
+        COUNTER_DRAW_CALLS,
+        COUNTER_NODES,
+        COUNTER_MAX
+    };
+
+    struct FrameSample {
+        uint64_t frame = 0;
+        uint64_t timestamp_usec = 0;
+        float frame_ms = 0.0f;      // time since the previous recorded frame
+        float process_ms = 0.0f;
+        float physics_ms = 0.0f;
+        uint32_t counters[COUNTER_MAX] = {};
+    };
+
+    static const uint32_t SNAPSHOT_MAGIC = 0x4B505346; // "FSPK"
+    static const uint32_t SNAPSHOT_VERSION = 1;
+
+private:
+    static FrameRecorder *singleton;
+
+    bool enabled = true;
+    float frame_budget_ms = 33.3f;
+    int frames_before = 120;        // frames before the spike written to a snapshot
+    int frames_after = 30;          // frames after the spike written to a snapshot
+    float min_dump_interval = 5.0f; // seconds between two snapshots
+    String snapshot_dir = "user://frame_spikes";
+
+    // Single producer (the main thread), lock-free readers: a slot is fully
+    // written before frames_written is published with release semantics.
+    std::vector<FrameSample> ring;
+    std::atomic<uint64_t> frames_written{ 0 };
+
+    uint64_t last_frame_usec = 0;
+    uint64_t last_native[NativeStats::COUNTER_MAX] = {};
+    int64_t live_projectiles = 0;   // kept by the projectiles themselves, no group query per frame
+
+    // Spike waiting for its trailing frames before being written
+    bool dump_pending = false;
+    uint64_t pending_spike_index = 0;
+    uint64_t last_dump_usec = 0;
+    String last_snapshot_path;
+
+protected:
+    static void _bind_methods();
+
+public:
+    static FrameRecorder *get_singleton();
+
+    FrameRecorder();
+    ~FrameRecorder();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+
+    void set_frame_budget_ms(float p_ms);
+    float get_frame_budget_ms() const;
+
+    void set_capacity(int p_frames);
+    int get_capacity() const;
+
+    void set_frames_before(int p_frames);
+    int get_frames_before() const;
+
+    void set_frames_after(int p_frames);
+    int get_frames_after() const;
+
+    void set_min_dump_interval(float p_seconds);
+    float get_min_dump_interval() const;
+
+    void set_snapshot_dir(const String &p_dir);
+    String get_snapshot_dir() const;
+
+    String get_last_snapshot_path() const;
+
+    // Projectiles call this with +1 on entering the tree and -1 on leaving it
+    void add_projectiles(int p_delta);
+    int64_t get_projectile_count() const;
+
+    // Oldest first, at most p_count of the most recent frames (0 = whole ring)
+    PackedFloat32Array get_frame_times(int p_count) const;
+    PackedInt32Array get_counter_history(int p_counter, int p_count) const;
+
+    // Writes the most recent frames_before + frames_after frames right away
+    String dump_snapshot();
+
+    // Copies up to p_count most recent samples, oldest first
+    int copy_recent(FrameSample *r_samples, int p_count) const;
+    uint64_t get_frames_written() const { return frames_written.load(std::memory_order_acquire); }
+
+    // Connected to RenderingServer.frame_post_draw
+    void _record_frame();
+
+private:
+    bool _should_skip_frame() const;
+    void _write_sample(FrameSample &r_sample);
+    String _write_snapshot(uint64_t p_first, uint64_t p_end, uint64_t p_spike_frame);
+};
+
+} // namespace godot
+
+#endif // FRAME_RECORDER_H
@@ -0,0 +1,218 @@
+#include "game_event_bus.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+
+#include <algorithm>
+
+#include "profile_zone.h"
+
+using namespace godot;
+
+GameEventBus *GameEventBus::singleton = nullptr;
+
+void GameEventBus::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("push", "type", "source_id", "target_id", "value", "position"), &GameEventBus::push,
+            DEFVAL(0), DEFVAL(0), DEFVAL(0.0f), DEFVAL(Vector3()));
+    ClassDB::bind_method(D_METHOD("subscribe", "type", "callable"), &GameEventBus::subscribe);
+    ClassDB::bind_method(D_METHOD("unsubscribe", "type", "callable"), &GameEventBus::unsubscribe);
+    ClassDB::bind_method(D_METHOD("flush"), &GameEventBus::flush);
+    ClassDB::bind_method(D_METHOD("get_pending_count"), &GameEventBus::get_pending_count);
+    ClassDB::bind_method(D_METHOD("get_dropped_count"), &GameEventBus::get_dropped_count);
+    ClassDB::bind_method(D_METHOD("get_dispatched_count"), &GameEventBus::get_dispatched_count);
+
+    BIND_CONSTANT(EVENT_SCORE);
+    BIND_CONSTANT(EVENT_PICKUP);
+    BIND_CONSTANT(EVENT_DAMAGE);
+    BIND_CONSTANT(EVENT_DEATH);
+    BIND_CONSTANT(EVENT_WIN);
+    BIND_CONSTANT(EVENT_CUSTOM);
+    BIND_CONSTANT(EVENT_TYPE_MAX);
+}
+
+GameEventBus *GameEventBus::get_singleton() {
+    return singleton;
+}
+
+GameEventBus::GameEventBus() :
+        queue(QUEUE_CAPACITY) {
+    singleton = this;
+}
+
+GameEventBus::~GameEventBus() {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (tree && tree->is_connected("process_frame", Callable(this, "flush"))) {
+        tree->disconnect("process_frame", Callable(this, "flush"));
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+// Hooked up by the first subscriber, or by the first push from the main thread
+// when that subscriber came before the SceneTree
+void GameEventBus::_watch_tree() {
+    if (watching_tree.load(std::memory_order_relaxed)) return;
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree) return;
+
+    const Callable on_frame(this, "flush");
+    if (!tree->is_connected("process_frame", on_frame)) {
+        tree->connect("process_frame", on_frame);
+    }
+    watching_tree.store(true, std::memory_order_relaxed);
+}
+
+void GameEventBus::_set_subscribed(int p_type, bool p_subscribed) {
+    const uint64_t bit = uint64_t(1) << (p_type & 63);
+    if (p_subscribed) {
+        subscribed[p_type >> 6].fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        subscribed[p_type >> 6].fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+bool GameEventBus::_is_subscribed(uint32_t p_type) const {
+    return (subscribed[p_type >> 6].load(std::memory_order_relaxed) >> (p_type & 63)) & 1;
+}
+
+bool GameEventBus::push_event(const GameEvent &p_event) {
+    if (p_event.type < EVENT_TYPE_MAX && !_is_subscribed(p_event.type)) {
+        return true;
+    }
+    if (!watching_tree.load(std::memory_order_relaxed) &&
+            OS::get_singleton()->get_thread_caller_id() == OS::get_singleton()->get_main_thread_id()) {
+        _watch_tree();
+    }
+    if (p_event.type >= EVENT_TYPE_MAX || !queue.try_push(p_event)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool GameEventBus::push(int p_type, uint64_t p_source, uint64_t p_target, float p_value, const Vector3 &p_position) {
+    GameEvent event;
+    event.type = (uint32_t)p_type;
+    event.value = p_value;
+    event.source = p_source;
+    event.target = p_target;
+    event.x = p_position.x;
+    event.y = p_position.y;
+    event.z = p_position.z;
+    return push_event(event);
+}
+
+void GameEventBus::subscribe(int p_type, const Callable &p_callable) {
+    ERR_FAIL_INDEX(p_type, EVENT_TYPE_MAX);
+    ERR_FAIL_COND(!p_callable.is_valid());
+    Subscriber subscriber;
+    subscriber.callable = p_callable;
+    subscribers[p_type].push_back(subscriber);
+    _set_subscribed(p_type, true);
+    _watch_tree();
+}
+
+void GameEventBus::unsubscribe(int p_type, const Callable &p_callable) {
+    ERR_FAIL_INDEX(p_type, EVENT_TYPE_MAX);
+    for (Subscriber &subscriber : subscribers[p_type]) {
+        if (!subscriber.handler && !subscriber.removed && subscriber.callable == p_callable) {
+            subscriber.removed = true;
+            has_removed = true;
+            break;
+        }
+    }
+    if (!dispatching) _compact();
+}
+
+void GameEventBus::subscribe_native(int p_type, NativeHandler p_handler, void *p_userdata) {
+    ERR_FAIL_INDEX(p_type, EVENT_TYPE_MAX);
+    ERR_FAIL_NULL(p_handler);
+    Subscriber subscriber;
+    subscriber.handler = p_handler;
+    subscriber.userdata = p_userdata;
+    subscribers[p_type].push_back(subscriber);
+    _set_subscribed(p_type, true);
+    _watch_tree();
+}
+
+void GameEventBus::unsubscribe_native(int p_type, NativeHandler p_handler, void *p_userdata) {
+    ERR_FAIL_INDEX(p_type, EVENT_TYPE_MAX);
+    for (Subscriber &subscriber : subscribers[p_type]) {
+        if (subscriber.handler == p_handler && subscriber.userdata == p_userdata && !subscriber.removed) {
+            subscriber.removed = true;
+            has_removed = true;
+            break;
+        }
+    }
+    if (!dispatching) _compact();
+}
+
+// Unsubscribing while dispatching only marks the entry; it is erased afterwards
+void GameEventBus::_compact() {
+    if (!has_removed) return;
+    for (int type = 0; type < EVENT_TYPE_MAX; type++) {
+        std::vector<Subscriber> &list = subscribers[type];
+        list.erase(std::remove_if(list.begin(), list.end(), [](const Subscriber &s) { return s.removed; }), list.end());
+        _set_subscribed(type, !list.empty());
+    }
+    has_removed = false;
+}
+
+void GameEventBus::_dispatch(const GameEvent &p_event) {
+    std::vector<Subscriber> &list = subscribers[p_event.type];
+    // Subscribing from a handler may grow the list; new entries see the next event
+    const size_t count = list.size();
+    for (size_t i = 0; i < count; i++) {
+        if (list[i].removed) continue;
+        // Copied out: a handler that subscribes can reallocate the list under us
+        const Subscriber subscriber = list[i];
+        if (subscriber.handler) {
+            subscriber.handler(p_event, subscriber.userdata);
+        } else if (subscriber.callable.is_valid()) {
+            subscriber.callable.call((int)p_event.type, (int64_t)p_event.source, (int64_t)p_event.target, p_event.value,
+                    Vector3(p_event.x, p_event.y, p_event.z));
+        } else {
+            // Bound object is gone
+            list[i].removed = true;
+            has_removed = true;
+        }
+    }
+}
+
+int GameEventBus::flush() {
+    if (dispatching) {
+        return 0;
+    }
+    PROFILE_ZONE("GameEventBus::flush");
+
+    // Only what is queued now, so handlers that push can't keep the drain going
+    size_t budget = MIN(queue.size(), queue.capacity());
+    int handled = 0;
+    GameEvent event;
+    dispatching = true;
+    while (budget-- > 0 && queue.try_pop(event)) {
+        _dispatch(event);
+        handled++;
+    }
+    dispatching = false;
+    _compact();
+
+    dispatched += handled;
+    return handled;
+}
+
+int GameEventBus::get_pending_count() const {
+    return (int)queue.size();
+}
+
+int64_t GameEventBus::get_dropped_count() const {
+    return (int64_t)dropped.load(std::memory_order_relaxed);
+}
+
+int64_t GameEventBus::get_dispatched_count() const {
+    return (int64_t)dispatched;
+}
@@ -0,0 +1,111 @@
+#ifndef GAME_EVENT_BUS_H
+#define GAME_EVENT_BUS_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "mpsc_ring.h"
+
+namespace godot {
+
+// Plain gameplay event. Nodes are referred to by instance id so an event stays
+// safe to hold after its source is freed.
+struct GameEvent {
+    uint32_t type = 0;
+    float value = 0.0f;
+    uint64_t source = 0;
+    uint64_t target = 0;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+// Gameplay events (score, pickups, damage, ...) raised from anywhere, physics
+// callbacks and worker threads included, and handled on the main thread.
+// push() only copies the event into a lock-free ring; once per frame, on
+// SceneTree.process_frame, everything queued is drained in one batch and handed
+// to the subscribers of each event type in the order it was pushed.
+//
+// Script subscribers are Callables taking (type, source_id, target_id, value,
+// position); native ones are plain function pointers. Ids from EVENT_CUSTOM
+// up are free for game code. Events of a type nobody subscribes to are
+// discarded at push(). When the ring is full events are dropped and counted
+// rather than blocking the producer.
+class GameEventBus : public Object {
+    GDCLASS(GameEventBus, Object);
+
+public:
+    enum EventType {
+        EVENT_SCORE,        // value: points scored
+        EVENT_PICKUP,       // source: item, target: collector
+        EVENT_DAMAGE,       // source: attacker, target: victim, value: amount
+        EVENT_DEATH,        // source: whatever died
+        EVENT_WIN,
+        EVENT_CUSTOM = 32,
+        EVENT_TYPE_MAX = 256,
+    };
+
+    typedef void (*NativeHandler)(const GameEvent &p_event, void *p_userdata);
+
+    static const int QUEUE_CAPACITY = 8192;
+
+private:
+    struct Subscriber {
+        Callable callable;
+        NativeHandler handler = nullptr;
+        void *userdata = nullptr;
+        bool removed = false;
+    };
+
+    static GameEventBus *singleton;
+
+    MpscRing<GameEvent> queue;
+    std::vector<Subscriber> subscribers[EVENT_TYPE_MAX];
+    std::atomic<uint64_t> subscribed[EVENT_TYPE_MAX / 64] = {};  // bit per type with a live subscriber
+    std::atomic<uint64_t> dropped{ 0 };
+    uint64_t dispatched = 0;
+    bool dispatching = false;
+    bool has_removed = false;
+    std::atomic<bool> watching_tree{ false };
+
+    void _watch_tree();
+    void _set_subscribed(int p_type, bool p_subscribed);
+    bool _is_subscribed(uint32_t p_type) const;
+    void _dispatch(const GameEvent &p_event);
+    void _compact();
+
+protected:
+    static void _bind_methods();
+
+public:
+    static GameEventBus *get_singleton();
+
+    GameEventBus();
+    ~GameEventBus();
+
+    // Any thread. False when the event was dropped; true but not queued when
+    // nothing subscribes to its type.
+    bool push_event(const GameEvent &p_event);
+    bool push(int p_type, uint64_t p_source, uint64_t p_target, float p_value, const Vector3 &p_position);
+
+    // Main thread only
+    void subscribe(int p_type, const Callable &p_callable);
+    void unsubscribe(int p_type, const Callable &p_callable);
+    void subscribe_native(int p_type, NativeHandler p_handler, void *p_userdata);
+    void unsubscribe_native(int p_type, NativeHandler p_handler, void *p_userdata);
+
+    // Drains and dispatches what is queued now; events pushed by subscribers wait for the next flush
+    int flush();
+
+    int get_pending_count() const;
+    int64_t get_dropped_count() const;
+    int64_t get_dispatched_count() const;
+};
+
+} // namespace godot
+
+#endif // GAME_EVENT_BUS_H
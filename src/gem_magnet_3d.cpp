@@ -0,0 +1,365 @@
+#include "gem_magnet_3d.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include <cmath>
+
+#include "hover_system.h"
+#include "native_stats.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+void GemMagnet3D::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_player_path", "path"), &GemMagnet3D::set_player_path);
+    ClassDB::bind_method(D_METHOD("get_player_path"), &GemMagnet3D::get_player_path);
+    ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "player_path"), "set_player_path", "get_player_path");
+
+    ClassDB::bind_method(D_METHOD("set_pickup_radius", "radius"), &GemMagnet3D::set_pickup_radius);
+    ClassDB::bind_method(D_METHOD("get_pickup_radius"), &GemMagnet3D::get_pickup_radius);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "pickup_radius"), "set_pickup_radius", "get_pickup_radius");
+
+    ClassDB::bind_method(D_METHOD("set_radius_multiplier", "multiplier"), &GemMagnet3D::set_radius_multiplier);
+    ClassDB::bind_method(D_METHOD("get_radius_multiplier"), &GemMagnet3D::get_radius_multiplier);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "radius_multiplier"), "set_radius_multiplier", "get_radius_multiplier");
+    ClassDB::bind_method(D_METHOD("get_effective_radius"), &GemMagnet3D::get_effective_radius);
+
+    ClassDB::bind_method(D_METHOD("set_arrive_distance", "distance"), &GemMagnet3D::set_arrive_distance);
+    ClassDB::bind_method(D_METHOD("get_arrive_distance"), &GemMagnet3D::get_arrive_distance);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "arrive_distance"), "set_arrive_distance", "get_arrive_distance");
+
+    ClassDB::bind_method(D_METHOD("set_orbit_distance", "distance"), &GemMagnet3D::set_orbit_distance);
+    ClassDB::bind_method(D_METHOD("get_orbit_distance"), &GemMagnet3D::get_orbit_distance);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "orbit_distance"), "set_orbit_distance", "get_orbit_distance");
+
+    ClassDB::bind_method(D_METHOD("set_magnetic_force", "force"), &GemMagnet3D::set_magnetic_force);
+    ClassDB::bind_method(D_METHOD("get_magnetic_force"), &GemMagnet3D::get_magnetic_force);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "magnetic_force"), "set_magnetic_force", "get_magnetic_force");
+
+    ClassDB::bind_method(D_METHOD("set_swirl_factor", "factor"), &GemMagnet3D::set_swirl_factor);
+    ClassDB::bind_method(D_METHOD("get_swirl_factor"), &GemMagnet3D::get_swirl_factor);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "swirl_factor"), "set_swirl_factor", "get_swirl_factor");
+
+    ClassDB::bind_method(D_METHOD("set_max_speed", "speed"), &GemMagnet3D::set_max_speed);
+    ClassDB::bind_method(D_METHOD("get_max_speed"), &GemMagnet3D::get_max_speed);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_speed"), "set_max_speed", "get_max_speed");
+
+    ClassDB::bind_method(D_METHOD("set_drag", "drag"), &GemMagnet3D::set_drag);
+    ClassDB::bind_method(D_METHOD("get_drag"), &GemMagnet3D::get_drag);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "drag"), "set_drag", "get_drag");
+
+    ClassDB::bind_method(D_METHOD("set_target_height", "height"), &GemMagnet3D::set_target_height);
+    ClassDB::bind_method(D_METHOD("get_target_height"), &GemMagnet3D::get_target_height);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "target_height"), "set_target_height", "get_target_height");
+
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &GemMagnet3D::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &GemMagnet3D::get_cell_size);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+
+    ClassDB::bind_method(D_METHOD("add_gem", "gem"), &GemMagnet3D::add_gem);
+    ClassDB::bind_method(D_METHOD("remove_gem", "gem"), &GemMagnet3D::remove_gem);
+    ClassDB::bind_method(D_METHOD("refresh_gem", "gem"), &GemMagnet3D::refresh_gem);
+    ClassDB::bind_method(D_METHOD("get_gem_count"), &GemMagnet3D::get_gem_count);
+}
+
+GemMagnet3D::GemMagnet3D() :
+        grid(4.0f) {
+}
+
+GemMagnet3D::~GemMagnet3D() {
+}
+
+void GemMagnet3D::set_player_path(const NodePath &p_path) {
+    player_path = p_path;
+}
+NodePath GemMagnet3D::get_player_path() const {
+    return player_path;
+}
+
+void GemMagnet3D::set_pickup_radius(float p_radius) {
+    pickup_radius = MAX(p_radius, 0.0f);
+}
+float GemMagnet3D::get_pickup_radius() const {
+    return pickup_radius;
+}
+
+void GemMagnet3D::set_radius_multiplier(float p_multiplier) {
+    radius_multiplier = MAX(p_multiplier, 0.0f);
+}
+float GemMagnet3D::get_radius_multiplier() const {
+    return radius_multiplier;
+}
+
+float GemMagnet3D::get_effective_radius() const {
+    return pickup_radius * radius_multiplier;
+}
+
+void GemMagnet3D::set_arrive_distance(float p_distance) {
+    arrive_distance = MAX(p_distance, 0.0f);
+}
+float GemMagnet3D::get_arrive_distance() const {
+    return arrive_distance;
+}
+
+void GemMagnet3D::set_orbit_distance(float p_distance) {
+    orbit_distance = p_distance;
+}
+float GemMagnet3D::get_orbit_distance() const {
+    return orbit_distance;
+}
+
+void GemMagnet3D::set_magnetic_force(float p_force) {
+    magnetic_force = p_force;
+}
+float GemMagnet3D::get_magnetic_force() const {
+    return magnetic_force;
+}
+
+void GemMagnet3D::set_swirl_factor(float p_factor) {
+    swirl_factor = p_factor;
+}
+float GemMagnet3D::get_swirl_factor() const {
+    return swirl_factor;
+}
+
+void GemMagnet3D::set_max_speed(float p_speed) {
+    max_speed = MAX(p_speed, 0.0f);
+}
+float GemMagnet3D::get_max_speed() const {
+    return max_speed;
+}
+
+void GemMagnet3D::set_drag(float p_drag) {
+    drag = MAX(p_drag, 0.0f);
+}
+float GemMagnet3D::get_drag() const {
+    return drag;
+}
+
+void GemMagnet3D::set_target_height(float p_height) {
+    target_height = p_height;
+}
+float GemMagnet3D::get_target_height() const {
+    return target_height;
+}
+
+void GemMagnet3D::set_cell_size(float p_size) {
+    cell_size = MAX(p_size, 0.1f);
+    grid.set_cell_size(cell_size);
+}
+float GemMagnet3D::get_cell_size() const {
+    return cell_size;
+}
+
+void GemMagnet3D::add_gem(Node3D *p_gem) {
+    ERR_FAIL_NULL(p_gem);
+    static const StringName auto_pickup("auto_pickup");
+    if (!(bool)p_gem->get(auto_pickup)) {
+        remove_gem(p_gem);
+        return;
+    }
+
+    const uint64_t id = p_gem->get_instance_id();
+    const Vector3 pos = p_gem->get_global_position();
+    if (index.count(id)) {
+        grid.move(id, pos.x, pos.z);
+        return;
+    }
+
+    index[id] = (int)ids.size();
+    ids.push_back(id);
+    vel_x.push_back(0.0f);
+    vel_y.push_back(0.0f);
+    vel_z.push_back(0.0f);
+    pulling.push_back(0);
+    grid.insert(id, pos.x, pos.z);
+}
+
+void GemMagnet3D::remove_gem(Node *p_gem) {
+    if (!p_gem) return;
+    auto it = index.find(p_gem->get_instance_id());
+    if (it != index.end()) {
+        _remove_at(it->second);
+    }
+}
+
+void GemMagnet3D::_remove_at(int p_index) {
+    if (pulling[p_index]) {
+        _set_pulling(p_index, Object::cast_to<Node3D>(ObjectDB::get_instance(ids[p_index])), false);
+    }
+    index.erase(ids[p_index]);
+    grid.remove(ids[p_index]);
+
+    const int last = (int)ids.size() - 1;
+    if (p_index != last) {
+        ids[p_index] = ids[last];
+        vel_x[p_index] = vel_x[last];
+        vel_y[p_index] = vel_y[last];
+        vel_z[p_index] = vel_z[last];
+        pulling[p_index] = pulling[last];
+        index[ids[p_index]] = p_index;
+    }
+    ids.pop_back();
+    vel_x.pop_back();
+    vel_y.pop_back();
+    vel_z.pop_back();
+    pulling.pop_back();
+}
+
+void GemMagnet3D::_set_pulling(int p_index, Node3D *p_gem, bool p_pulling) {
+    pulling[p_index] = p_pulling ? 1 : 0;
+    if (p_gem) {
+        p_gem->set_notify_transform(!p_pulling);
+    }
+}
+
+void GemMagnet3D::refresh_gem(Node3D *p_gem) {
+    if (!p_gem) return;
+    const uint64_t id = p_gem->get_instance_id();
+    if (index.count(id)) {
+        const Vector3 pos = p_gem->get_global_position();
+        grid.move(id, pos.x, pos.z);
+    }
+}
+
+int GemMagnet3D::get_gem_count() const {
+    return (int)ids.size();
+}
+
+void GemMagnet3D::_ready() {
+    add_to_group(GROUP_NAME);
+    if (Engine::get_singleton()->is_editor_hint()) {
+        return;
+    }
+
+    // Gems that were in the level before the magnet
+    TypedArray<Node> gems = get_tree()->get_nodes_in_group(GEM_GROUP_NAME);
+    for (int i = 0; i < gems.size(); i++) {
+        Node3D *gem = Object::cast_to<Node3D>(gems[i]);
+        if (gem) add_gem(gem);
+    }
+}
+
+void GemMagnet3D::_physics_process(double p_delta) {
+    if (Engine::get_singleton()->is_editor_hint() || ids.empty()) {
+        return;
+    }
+    PROFILE_ZONE("GemMagnet3D::_physics_process");
+
+    Node *player = get_node_or_null(player_path);
+    if (!player) {
+        return;
+    }
+
+    const float dt = (float)p_delta;
+    const float radius = get_effective_radius();
+    const Vector3 target = get_global_position() + Vector3(0, target_height, 0);
+
+    // Only the cells around the player; drop gems freed without telling us
+    gather_scratch.clear();
+    grid.gather(target.x, target.z, (int)std::ceil(radius / cell_size), gather_scratch);
+
+    near_nodes.clear();
+    pos_x.clear();
+    pos_y.clear();
+    pos_z.clear();
+    for (uint64_t id : gather_scratch) {
+        Node3D *gem = Object::cast_to<Node3D>(ObjectDB::get_instance(id));
+        if (!gem || !gem->is_inside_tree()) {
+            _remove_at(index.find(id)->second);
+            continue;
+        }
+        const Vector3 pos = gem->get_global_position();
+        near_nodes.push_back(gem);
+        pos_x.push_back(pos.x);
+        pos_y.push_back(pos.y);
+        pos_z.push_back(pos.z);
+    }
+
+    const int count = (int)near_nodes.size();
+    near_index.resize(count);
+    moved.assign(count, 0);
+    for (int j = 0; j < count; j++) {
+        near_index[j] = index.find(near_nodes[j]->get_instance_id())->second;
+    }
+
+    OrbitParams params;
+    params.max_distance = radius;
+    params.orbit_distance = orbit_distance;
+    params.magnetic_force = magnetic_force;
+    params.swirl_factor = swirl_factor;
+
+    // One pass over the gems in reach: integrate the orbit force (unit mass)
+    const float damping = MAX(0.0f, 1.0f - drag * dt);
+    const float max_speed_sq = max_speed * max_speed;
+    const float arrive_sq = arrive_distance * arrive_distance;
+    const float radius_sq = radius * radius;
+    arrived.clear();
+    for (int j = 0; j < count; j++) {
+        const int i = near_index[j];
+        const float dx = target.x - pos_x[j];
+        const float dy = target.y - pos_y[j];
+        const float dz = target.z - pos_z[j];
+        const float dist_sq = dx * dx + dy * dy + dz * dz;
+        if (dist_sq > radius_sq) {
+            vel_x[i] = vel_y[i] = vel_z[i] = 0.0f;
+            if (pulling[i]) _set_pulling(i, near_nodes[j], false);
+            continue;
+        }
+        if (dist_sq <= arrive_sq) {
+            arrived.push_back(near_nodes[j]);
+            continue;
+        }
+
+        float fx, fy, fz;
+        compute_orbit_force_3d(dx, dy, dz, params, fx, fy, fz);
+        float vx = (vel_x[i] + fx * dt) * damping;
+        float vy = (vel_y[i] + fy * dt) * damping;
+        float vz = (vel_z[i] + fz * dt) * damping;
+        const float speed_sq = vx * vx + vy * vy + vz * vz;
+        if (speed_sq > max_speed_sq) {
+            const float scale = max_speed / std::sqrt(speed_sq);
+            vx *= scale;
+            vy *= scale;
+            vz *= scale;
+        }
+        vel_x[i] = vx;
+        vel_y[i] = vy;
+        vel_z[i] = vz;
+
+        pos_x[j] += vx * dt;
+        pos_y[j] += vy * dt;
+        pos_z[j] += vz * dt;
+        moved[j] = 1;
+    }
+
+    // Write back with the gems' transform notifications off, so no script runs
+    // per moved gem; HoverSystem is told directly
+    HoverSystem *hover = HoverSystem::get_singleton();
+    int pulled = 0;
+    for (int j = 0; j < count; j++) {
+        if (!moved[j]) continue;
+        const int i = near_index[j];
+        Node3D *gem = near_nodes[j];
+        if (!pulling[i]) _set_pulling(i, gem, true);
+        gem->set_global_position(Vector3(pos_x[j], pos_y[j], pos_z[j]));
+        grid.move(ids[i], pos_x[j], pos_z[j]);
+        if (hover) hover->refresh_item(gem);
+        pulled++;
+    }
+    NativeStats::add(NativeStats::MAGNET_GEMS_PULLED, pulled);
+
+    // Pickup events last: pickup_item may free the gem, or re-register it when
+    // the pickup fails (full inventory)
+    static const StringName pickup_method("pickup_item");
+    for (Node3D *gem : arrived) {
+        remove_gem(gem);
+        if (gem->has_method(pickup_method)) {
+            gem->call(pickup_method, player);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef GEM_MAGNET_3D_H
+#define GEM_MAGNET_3D_H
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/node_path.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+#include "orbit_force.h"
+#include "proximity_grid.h"
+
+namespace godot {
+
+// Pulls gems towards the player and picks them up when they arrive.
+// Lives under the player. Gems (the "Gem" group) are kept in an XZ cell grid,
+// so each physics tick only the gems in the cells around the player are
+// looked at; those in reach are moved in one pass with the MagneticOrbit
+// inverse-square/swirl force and get pickup_item(player) on arrival.
+//
+// Gems join and leave through the "GemMagnet" group (add_gem / remove_gem /
+// refresh_gem), which also tells them a magnet is doing their auto pickup.
+// Only gems with auto_pickup set are taken. While a gem is being pulled its
+// transform notifications are off and the magnet refreshes HoverSystem
+// itself, so moving it does not call back into the gem's script.
+class GemMagnet3D : public Node3D {
+    GDCLASS(GemMagnet3D, Node3D);
+
+protected:
+    static void _bind_methods();
+
+private:
+    NodePath player_path = NodePath("..");
+
+    float pickup_radius = 4.0f;      // reach before radius_multiplier
+    float radius_multiplier = 1.0f;  // raised by Luck/Speed gem effects
+    float arrive_distance = 0.8f;
+    float orbit_distance = 1.5f;
+    float magnetic_force = 60.0f;
+    float swirl_factor = 0.5f;
+    float max_speed = 20.0f;
+    float drag = 2.0f;               // velocity lost per second, keeps the swirl from orbiting forever
+    float target_height = 1.0f;      // gems fly to this height above the magnet
+    float cell_size = 4.0f;
+
+    ProximityGrid grid;
+
+    // Tracked gems, structure-of-arrays and swap-removed
+    std::vector<uint64_t> ids;
+    std::vector<float> vel_x, vel_y, vel_z;
+    std::vector<uint8_t> pulling;    // transform notifications switched off
+    std::unordered_map<uint64_t, int> index;
+
+    // Per tick scratch
+    std::vector<uint64_t> gather_scratch;
+    std::vector<Node3D *> near_nodes;
+    std::vector<int> near_index;
+    std::vector<float> pos_x, pos_y, pos_z;
+    std::vector<uint8_t> moved;
+    std::vector<Node3D *> arrived;
+
+    void _remove_at(int p_index);
+    void _set_pulling(int p_index, Node3D *p_gem, bool p_pulling);
+
+public:
+    // Group magnets join; gems call into it
+    static constexpr const char *GROUP_NAME = "GemMagnet";
+    // Group gems join so a magnet entering later can find them
+    static constexpr const char *GEM_GROUP_NAME = "Gem";
+
+    GemMagnet3D();
+    ~GemMagnet3D();
+
+    void set_player_path(const NodePath &p_path);
+    NodePath get_player_path() const;
+
+    void set_pickup_radius(float p_radius);
+    float get_pickup_radius() const;
+    void set_radius_multiplier(float p_multiplier);
+    float get_radius_multiplier() const;
+    float get_effective_radius() const;
+
+    void set_arrive_distance(float p_distance);
+    float get_arrive_distance() const;
+    void set_orbit_distance(float p_distance);
+    float get_orbit_distance() const;
+    void set_magnetic_force(float p_force);
+    float get_magnetic_force() const;
+    void set_swirl_factor(float p_factor);
+    float get_swirl_factor() const;
+    void set_max_speed(float p_speed);
+    float get_max_speed() const;
+    void set_drag(float p_drag);
+    float get_drag() const;
+    void set_target_height(float p_height);
+    float get_target_height() const;
+    void set_cell_size(float p_size);
+    float get_cell_size() const;
+
+    // Ignored (and dropped if tracked) when the gem's auto_pickup is off
+    void add_gem(Node3D *p_gem);
+    void remove_gem(Node *p_gem);
+    // Re-buckets a gem after it was moved by something else (spawner, tween)
+    void refresh_gem(Node3D *p_gem);
+    int get_gem_count() const;
+
+    void _ready() override;
+    void _physics_process(double p_delta) override;
+};
+
+} // namespace godot
+
+#endif // GEM_MAGNET_3D_H
@@ -0,0 +1,493 @@
+#include "hover_system.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/visual_instance3d.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <cmath>
+
+#include "native_stats.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+HoverSystem *HoverSystem::singleton = nullptr;
+
+void HoverSystem::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &HoverSystem::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &HoverSystem::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    ClassDB::bind_method(D_METHOD("set_cell_size_2d", "size"), &HoverSystem::set_cell_size_2d);
+    ClassDB::bind_method(D_METHOD("get_cell_size_2d"), &HoverSystem::get_cell_size_2d);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size_2d"), "set_cell_size_2d", "get_cell_size_2d");
+
+    ClassDB::bind_method(D_METHOD("set_cell_size_3d", "size"), &HoverSystem::set_cell_size_3d);
+    ClassDB::bind_method(D_METHOD("get_cell_size_3d"), &HoverSystem::get_cell_size_3d);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size_3d"), "set_cell_size_3d", "get_cell_size_3d");
+
+    ClassDB::bind_method(D_METHOD("set_wake_radius_3d", "radius"), &HoverSystem::set_wake_radius_3d);
+    ClassDB::bind_method(D_METHOD("get_wake_radius_3d"), &HoverSystem::get_wake_radius_3d);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "wake_radius_3d"), "set_wake_radius_3d", "get_wake_radius_3d");
+
+    ClassDB::bind_method(D_METHOD("add_item_2d", "item", "visual", "amplitude", "speed", "range"), &HoverSystem::add_item_2d);
+    ClassDB::bind_method(D_METHOD("add_item_3d", "item", "visuals", "amplitude", "speed", "spin_speed", "phase"),
+            &HoverSystem::add_item_3d, DEFVAL(0.5f), DEFVAL(0.0f));
+    ClassDB::bind_method(D_METHOD("remove_item", "item"), &HoverSystem::remove_item);
+    ClassDB::bind_method(D_METHOD("has_item", "item"), &HoverSystem::has_item);
+    ClassDB::bind_method(D_METHOD("refresh_item", "item"), &HoverSystem::refresh_item);
+    ClassDB::bind_method(D_METHOD("get_item_count"), &HoverSystem::get_item_count);
+    ClassDB::bind_method(D_METHOD("get_awake_count"), &HoverSystem::get_awake_count);
+    ClassDB::bind_method(D_METHOD("_update"), &HoverSystem::_update);
+}
+
+HoverSystem *HoverSystem::get_singleton() {
+    return singleton;
+}
+
+HoverSystem::HoverSystem() :
+        grid_2d(128.0f), grid_3d(8.0f) {
+    singleton = this;
+    RenderingServer::get_singleton()->connect("frame_pre_draw", Callable(this, "_update"));
+}
+
+HoverSystem::~HoverSystem() {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (rs && rs->is_connected("frame_pre_draw", Callable(this, "_update"))) {
+        rs->disconnect("frame_pre_draw", Callable(this, "_update"));
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void HoverSystem::set_enabled(bool p_enabled) {
+    enabled = p_enabled;
+    last_update_usec = 0;
+}
+
+bool HoverSystem::is_enabled() const {
+    return enabled;
+}
+
+void HoverSystem::set_cell_size_2d(float p_size) {
+    cell_size_2d = MAX(p_size, 1.0f);
+    grid_2d.set_cell_size(cell_size_2d);
+    awake_dirty_2d = true;
+}
+
+float HoverSystem::get_cell_size_2d() const {
+    return cell_size_2d;
+}
+
+void HoverSystem::set_cell_size_3d(float p_size) {
+    cell_size_3d = MAX(p_size, 0.1f);
+    grid_3d.set_cell_size(cell_size_3d);
+    awake_dirty_3d = true;
+}
+
+float HoverSystem::get_cell_size_3d() const {
+    return cell_size_3d;
+}
+
+void HoverSystem::set_wake_radius_3d(float p_radius) {
+    wake_radius_3d = MAX(p_radius, 0.0f);
+    awake_dirty_3d = true;
+}
+
+float HoverSystem::get_wake_radius_3d() const {
+    return wake_radius_3d;
+}
+
+void HoverSystem::add_item_2d(Node2D *p_item, Node2D *p_visual, float p_amplitude, float p_speed, float p_range) {
+    ERR_FAIL_NULL(p_item);
+    ERR_FAIL_NULL(p_visual);
+    remove_item(p_item);
+
+    const uint64_t id = p_item->get_instance_id();
+    const Vector2 base = p_item->get_global_position();
+    index_2d[id] = (int)ids_2d.size();
+    ids_2d.push_back(id);
+    canvas_items.push_back(p_visual->get_canvas_item());
+    rest_2d.push_back(p_visual->get_transform());
+    base_x_2d.push_back(base.x);
+    base_y_2d.push_back(base.y);
+    range_sq_2d.push_back(p_range * p_range);
+    amplitude_2d.push_back(p_amplitude);
+    speed_2d.push_back(p_speed);
+    time_2d.push_back(0.0f);
+    offset_2d.push_back(0.0f);
+    bobbing_2d.push_back(0);
+    awake_2d.push_back(0);
+
+    // Starts asleep; the next update wakes it if the player is close
+    grid_2d.insert(id, base.x, base.y);
+    max_range_2d = MAX(max_range_2d, p_range);
+    awake_dirty_2d = true;
+    _notify_wake(id, false);
+}
+
+void HoverSystem::add_item_3d(Node3D *p_item, const Array &p_visuals, float p_amplitude, float p_speed, float p_spin_speed, float p_phase) {
+    ERR_FAIL_NULL(p_item);
+    remove_item(p_item);
+
+    const uint64_t id = p_item->get_instance_id();
+    const Transform3D base = p_item->get_global_transform();
+    const Transform3D to_local = base.affine_inverse();
+
+    int count = 0;
+    for (int i = 0; i < p_visuals.size() && count < MAX_VISUALS_3D; i++) {
+        VisualInstance3D *visual = Object::cast_to<VisualInstance3D>(p_visuals[i]);
+        if (!visual) continue;
+        instances_3d.push_back(visual->get_instance());
+        local_3d.push_back(to_local * visual->get_global_transform());
+        count++;
+    }
+    ERR_FAIL_COND_MSG(count == 0, "HoverSystem: add_item_3d needs at least one VisualInstance3D");
+    instances_3d.resize(instances_3d.size() + (MAX_VISUALS_3D - count));
+    local_3d.resize(local_3d.size() + (MAX_VISUALS_3D - count));
+
+    index_3d[id] = (int)ids_3d.size();
+    ids_3d.push_back(id);
+    base_3d.push_back(base);
+    amplitude_3d.push_back(p_amplitude);
+    speed_3d.push_back(p_speed);
+    time_3d.push_back(p_phase);
+    spin_speed_3d.push_back(p_spin_speed);
+    angle_3d.push_back(0.0f);
+    visual_count_3d.push_back(count);
+    awake_3d.push_back(0);
+
+    grid_3d.insert(id, base.origin.x, base.origin.z);
+    awake_dirty_3d = true;
+    _notify_wake(id, false);
+}
+
+void HoverSystem::remove_item(Node *p_item) {
+    if (!p_item) return;
+    const uint64_t id = p_item->get_instance_id();
+
+    auto it2 = index_2d.find(id);
+    if (it2 != index_2d.end()) {
+        _remove_2d(it2->second);
+    }
+    auto it3 = index_3d.find(id);
+    if (it3 != index_3d.end()) {
+        _remove_3d(it3->second);
+    }
+}
+
+bool HoverSystem::has_item(Node *p_item) const {
+    if (!p_item) return false;
+    const uint64_t id = p_item->get_instance_id();
+    return index_2d.count(id) || index_3d.count(id);
+}
+
+void HoverSystem::refresh_item(Node *p_item) {
+    if (!p_item) return;
+    const uint64_t id = p_item->get_instance_id();
+
+    auto it2 = index_2d.find(id);
+    if (it2 != index_2d.end()) {
+        const Vector2 base = static_cast<Node2D *>(p_item)->get_global_position();
+        base_x_2d[it2->second] = base.x;
+        base_y_2d[it2->second] = base.y;
+        grid_2d.move(id, base.x, base.y);
+        awake_dirty_2d = true;
+    }
+    auto it3 = index_3d.find(id);
+    if (it3 != index_3d.end()) {
+        const Transform3D base = static_cast<Node3D *>(p_item)->get_global_transform();
+        base_3d[it3->second] = base;
+        grid_3d.move(id, base.origin.x, base.origin.z);
+        awake_dirty_3d = true;
+    }
+}
+
+int HoverSystem::get_item_count() const {
+    return (int)(ids_2d.size() + ids_3d.size());
+}
+
+int HoverSystem::get_awake_count() const {
+    return (int)(awake_list_2d.size() + awake_list_3d.size());
+}
+
+// Keeps an index list valid across a swap-remove
+void HoverSystem::_drop_index(std::vector<int> &r_list, int p_removed, int p_moved_from) {
+    for (size_t i = 0; i < r_list.size();) {
+        if (r_list[i] == p_removed) {
+            r_list[i] = r_list.back();
+            r_list.pop_back();
+            continue;
+        }
+        if (r_list[i] == p_moved_from) r_list[i] = p_removed;
+        i++;
+    }
+}
+
+void HoverSystem::_notify_wake(uint64_t p_id, bool p_awake) {
+    static const StringName method("_hover_wake_changed");
+    Object *object = ObjectDB::get_instance(p_id);
+    if (object && object->has_method(method)) {
+        object->call(method, p_awake);
+    }
+}
+
+void HoverSystem::_rest_3d(int p_index) {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    const int first = p_index * MAX_VISUALS_3D;
+    for (int k = 0; k < visual_count_3d[p_index]; k++) {
+        rs->instance_set_transform(instances_3d[first + k], base_3d[p_index] * local_3d[first + k]);
+    }
+}
+
+void HoverSystem::_remove_2d(int p_index) {
+    RenderingServer::get_singleton()->canvas_item_set_transform(canvas_items[p_index], rest_2d[p_index]);
+    index_2d.erase(ids_2d[p_index]);
+    grid_2d.remove(ids_2d[p_index]);
+
+    const int last = (int)ids_2d.size() - 1;
+    _drop_index(awake_list_2d, p_index, last);
+    if (p_index != last) {
+        ids_2d[p_index] = ids_2d[last];
+        canvas_items[p_index] = canvas_items[last];
+        rest_2d[p_index] = rest_2d[last];
+        base_x_2d[p_index] = base_x_2d[last];
+        base_y_2d[p_index] = base_y_2d[last];
+        range_sq_2d[p_index] = range_sq_2d[last];
+        amplitude_2d[p_index] = amplitude_2d[last];
+        speed_2d[p_index] = speed_2d[last];
+        time_2d[p_index] = time_2d[last];
+        offset_2d[p_index] = offset_2d[last];
+        bobbing_2d[p_index] = bobbing_2d[last];
+        awake_2d[p_index] = awake_2d[last];
+        index_2d[ids_2d[p_index]] = p_index;
+    }
+    ids_2d.pop_back();
+    canvas_items.pop_back();
+    rest_2d.pop_back();
+    base_x_2d.pop_back();
+    base_y_2d.pop_back();
+    range_sq_2d.pop_back();
+    amplitude_2d.pop_back();
+    speed_2d.pop_back();
+    time_2d.pop_back();
+    offset_2d.pop_back();
+    bobbing_2d.pop_back();
+    awake_2d.pop_back();
+}
+
+void HoverSystem::_remove_3d(int p_index) {
+    _rest_3d(p_index);
+    index_3d.erase(ids_3d[p_index]);
+    grid_3d.remove(ids_3d[p_index]);
+
+    const int first = p_index * MAX_VISUALS_3D;
+    const int last = (int)ids_3d.size() - 1;
+    _drop_index(awake_list_3d, p_index, last);
+    if (p_index != last) {
+        ids_3d[p_index] = ids_3d[last];
+        base_3d[p_index] = base_3d[last];
+        amplitude_3d[p_index] = amplitude_3d[last];
+        speed_3d[p_index] = speed_3d[last];
+        time_3d[p_index] = time_3d[last];
+        spin_speed_3d[p_index] = spin_speed_3d[last];
+        angle_3d[p_index] = angle_3d[last];
+        visual_count_3d[p_index] = visual_count_3d[last];
+        awake_3d[p_index] = awake_3d[last];
+        for (int k = 0; k < MAX_VISUALS_3D; k++) {
+            instances_3d[first + k] = instances_3d[last * MAX_VISUALS_3D + k];
+            local_3d[first + k] = local_3d[last * MAX_VISUALS_3D + k];
+        }
+        index_3d[ids_3d[p_index]] = p_index;
+    }
+    ids_3d.pop_back();
+    base_3d.pop_back();
+    amplitude_3d.pop_back();
+    speed_3d.pop_back();
+    time_3d.pop_back();
+    spin_speed_3d.pop_back();
+    angle_3d.pop_back();
+    visual_count_3d.pop_back();
+    awake_3d.pop_back();
+    instances_3d.resize(ids_3d.size() * MAX_VISUALS_3D);
+    local_3d.resize(ids_3d.size() * MAX_VISUALS_3D);
+}
+
+void HoverSystem::_update() {
+    if (!enabled || (ids_2d.empty() && ids_3d.empty())) {
+        last_update_usec = 0;
+        return;
+    }
+    PROFILE_ZONE("HoverSystem::_update");
+
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || tree->is_paused()) {
+        last_update_usec = 0;
+        return;
+    }
+
+    const uint64_t now = Time::get_singleton()->get_ticks_usec();
+    const float delta = last_update_usec ? MIN((float)(now - last_update_usec) * 1e-6f, 0.1f) : 0.0f;
+    last_update_usec = now;
+
+    _update_2d(delta);
+    _update_3d(delta);
+}
+
+void HoverSystem::_refresh_awake_2d(bool p_has_focus, const Vector2 &p_focus) {
+    const uint64_t key = p_has_focus ? grid_2d.cell_key(p_focus.x, p_focus.y) : 0;
+    if (!awake_dirty_2d && p_has_focus == focus_valid_2d && key == focus_key_2d) return;
+    awake_dirty_2d = false;
+    focus_valid_2d = p_has_focus;
+    focus_key_2d = key;
+
+    // Without a player nothing can be ruled out, so everything stays awake
+    awake_scratch.clear();
+    if (p_has_focus) {
+        gather_scratch.clear();
+        grid_2d.gather(p_focus.x, p_focus.y, (int)std::ceil(max_range_2d / cell_size_2d), gather_scratch);
+        for (uint64_t id : gather_scratch) {
+            awake_scratch.push_back(index_2d.find(id)->second);
+        }
+    } else {
+        for (int i = 0; i < (int)ids_2d.size(); i++) {
+            awake_scratch.push_back(i);
+        }
+    }
+
+    // Bit 2 marks the new set, bit 1 the old one
+    for (int i : awake_scratch) {
+        awake_2d[i] |= 2;
+    }
+    RenderingServer *rs = RenderingServer::get_singleton();
+    for (int i : awake_list_2d) {
+        if (awake_2d[i] & 2) continue;
+        awake_2d[i] = 0;
+        if (bobbing_2d[i]) {
+            rs->canvas_item_set_transform(canvas_items[i], rest_2d[i]);
+            bobbing_2d[i] = 0;
+        }
+        offset_2d[i] = 0.0f;
+        _notify_wake(ids_2d[i], false);
+    }
+    for (int i : awake_scratch) {
+        if (!(awake_2d[i] & 1)) _notify_wake(ids_2d[i], true);
+        awake_2d[i] = 1;
+    }
+    awake_list_2d.swap(awake_scratch);
+}
+
+void HoverSystem::_refresh_awake_3d(bool p_has_focus, const Vector3 &p_focus) {
+    const uint64_t key = p_has_focus ? grid_3d.cell_key(p_focus.x, p_focus.z) : 0;
+    if (!awake_dirty_3d && p_has_focus == focus_valid_3d && key == focus_key_3d) return;
+    awake_dirty_3d = false;
+    focus_valid_3d = p_has_focus;
+    focus_key_3d = key;
+
+    awake_scratch.clear();
+    if (p_has_focus) {
+        gather_scratch.clear();
+        grid_3d.gather(p_focus.x, p_focus.z, (int)std::ceil(wake_radius_3d / cell_size_3d), gather_scratch);
+        for (uint64_t id : gather_scratch) {
+            awake_scratch.push_back(index_3d.find(id)->second);
+        }
+    } else {
+        for (int i = 0; i < (int)ids_3d.size(); i++) {
+            awake_scratch.push_back(i);
+        }
+    }
+
+    for (int i : awake_scratch) {
+        awake_3d[i] |= 2;
+    }
+    for (int i : awake_list_3d) {
+        if (awake_3d[i] & 2) continue;
+        awake_3d[i] = 0;
+        _rest_3d(i);
+        _notify_wake(ids_3d[i], false);
+    }
+    for (int i : awake_scratch) {
+        if (!(awake_3d[i] & 1)) _notify_wake(ids_3d[i], true);
+        awake_3d[i] = 1;
+    }
+    awake_list_3d.swap(awake_scratch);
+}
+
+void HoverSystem::_update_2d(float p_delta) {
+    if (ids_2d.empty()) return;
+
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    Node *root = tree->get_current_scene();
+    Node2D *player = root ? Object::cast_to<Node2D>(root->get_node_or_null(NodePath("Player"))) : nullptr;
+    _refresh_awake_2d(player != nullptr, player ? player->get_global_position() : Vector2());
+    if (!player) return;
+    const Vector2 player_pos = player->get_global_position();
+
+    const int count = (int)awake_list_2d.size();
+    NativeStats::add(NativeStats::HOVER_ITEMS_UPDATED, count);
+
+    // Branch-free pass over the awake items: the clock only runs while the player is in range
+    for (int j = 0; j < count; j++) {
+        const int i = awake_list_2d[j];
+        const float dx = base_x_2d[i] - player_pos.x;
+        const float dy = base_y_2d[i] - player_pos.y;
+        const float active = (dx * dx + dy * dy <= range_sq_2d[i]) ? 1.0f : 0.0f;
+        time_2d[i] += p_delta * speed_2d[i] * active;
+        offset_2d[i] = active * amplitude_2d[i] * std::sin(time_2d[i]);
+    }
+
+    // Items at rest that were already at rest cost nothing
+    RenderingServer *rs = RenderingServer::get_singleton();
+    for (int j = 0; j < count; j++) {
+        const int i = awake_list_2d[j];
+        const bool bobbing = offset_2d[i] != 0.0f;
+        if (!bobbing && !bobbing_2d[i]) continue;
+
+        Transform2D xform = rest_2d[i];
+        xform.columns[2].y += offset_2d[i];
+        rs->canvas_item_set_transform(canvas_items[i], xform);
+        bobbing_2d[i] = bobbing;
+    }
+}
+
+void HoverSystem::_update_3d(float p_delta) {
+    if (ids_3d.empty()) return;
+
+    Node3D *player = Object::cast_to<Node3D>(ObjectDB::get_instance(player_3d_id));
+    if (!player || !player->is_inside_tree()) {
+        SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+        player = Object::cast_to<Node3D>(tree->get_first_node_in_group("Player"));
+        player_3d_id = player ? player->get_instance_id() : 0;
+    }
+    _refresh_awake_3d(player != nullptr, player ? player->get_global_position() : Vector3());
+
+    const int count = (int)awake_list_3d.size();
+    NativeStats::add(NativeStats::HOVER_ITEMS_UPDATED, count);
+
+    for (int j = 0; j < count; j++) {
+        const int i = awake_list_3d[j];
+        time_3d[i] += p_delta * speed_3d[i];
+        angle_3d[i] = std::fmod(angle_3d[i] + p_delta * spin_speed_3d[i], (float)Math_TAU);
+    }
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    const Vector3 up(0, 1, 0);
+    for (int j = 0; j < count; j++) {
+        const int i = awake_list_3d[j];
+        // Spin about the world up axis, bob along it
+        Transform3D xform = base_3d[i];
+        xform.basis = Basis(up, angle_3d[i]) * xform.basis;
+        xform.origin.y += amplitude_3d[i] * std::sin(time_3d[i]);
+
+        const int first = i * MAX_VISUALS_3D;
+        for (int k = 0; k < visual_count_3d[i]; k++) {
+            rs->instance_set_transform(instances_3d[first + k], xform * local_3d[first + k]);
+        }
+    }
+}
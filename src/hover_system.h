@@ -0,0 +1,138 @@
+#ifndef HOVER_SYSTEM_H
+#define HOVER_SYSTEM_H
+
+#include <godot_cpp/classes/node2d.hpp>
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/transform2d.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+#include "proximity_grid.h"
+
+namespace godot {
+
+// Bobbing (and spinning) of pickups, done for all of them in one pass per frame.
+// Only the visuals move: each item's sprite canvas item or mesh instances get
+// their transforms straight through RenderingServer, so the item nodes, their
+// collision areas and the scene tree are never touched while hovering.
+// Items are kept in structure-of-arrays form and swap-removed.
+//
+// Items also live in a cell grid and sleep until the player is in the cells
+// around them: asleep items sit at rest, cost nothing per frame and get
+// _hover_wake_changed(false) so they can switch their own processing and
+// monitoring off. The awake set is only rebuilt when the player changes cell.
+// The 2D player is the "Player" node under the current scene, the 3D player
+// the first node in the "Player" group; without one every item stays awake.
+//
+// 2D items (FloatingItem) only bob while the player is within their range, and
+// snap back to rest otherwise.
+class HoverSystem : public Object {
+    GDCLASS(HoverSystem, Object);
+
+public:
+    static const int MAX_VISUALS_3D = 4; // mesh instances moved per 3D item
+
+private:
+    static HoverSystem *singleton;
+
+    bool enabled = true;
+    uint64_t last_update_usec = 0;
+
+    // Sleep/wake
+    float cell_size_2d = 128.0f;
+    float cell_size_3d = 8.0f;
+    float wake_radius_3d = 24.0f;
+    ProximityGrid grid_2d;
+    ProximityGrid grid_3d;
+    float max_range_2d = 0.0f;          // wake neighborhood covers the largest 2D range
+    std::vector<int> awake_list_2d;      // item indices updated every frame
+    std::vector<int> awake_list_3d;
+    uint64_t focus_key_2d = 0;          // player cell at the last rebuild
+    uint64_t focus_key_3d = 0;
+    bool focus_valid_2d = false;        // a player was found at the last rebuild
+    bool focus_valid_3d = false;
+    bool awake_dirty_2d = true;
+    bool awake_dirty_3d = true;
+    uint64_t player_3d_id = 0;
+    std::vector<uint64_t> gather_scratch;
+    std::vector<int> awake_scratch;
+
+    // 2D: one canvas item per item, transforms are parent-relative
+    std::vector<uint64_t> ids_2d;
+    std::vector<RID> canvas_items;
+    std::vector<Transform2D> rest_2d;   // visual's local transform at rest
+    std::vector<float> base_x_2d, base_y_2d;
+    std::vector<float> range_sq_2d;
+    std::vector<float> amplitude_2d, speed_2d, time_2d;
+    std::vector<float> offset_2d;
+    std::vector<uint8_t> bobbing_2d;    // offset was non-zero last frame
+    std::vector<uint8_t> awake_2d;
+    std::unordered_map<uint64_t, int> index_2d;
+
+    // 3D: up to MAX_VISUALS_3D render instances per item, transforms are global
+    std::vector<uint64_t> ids_3d;
+    std::vector<Transform3D> base_3d;   // item's global transform at rest
+    std::vector<float> amplitude_3d, speed_3d, time_3d;
+    std::vector<float> spin_speed_3d, angle_3d;
+    std::vector<int> visual_count_3d;
+    std::vector<RID> instances_3d;       // MAX_VISUALS_3D per item
+    std::vector<Transform3D> local_3d;   // visual relative to the item
+    std::vector<uint8_t> awake_3d;
+    std::unordered_map<uint64_t, int> index_3d;
+
+protected:
+    static void _bind_methods();
+
+public:
+    static HoverSystem *get_singleton();
+
+    HoverSystem();
+    ~HoverSystem();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+
+    void set_cell_size_2d(float p_size);
+    float get_cell_size_2d() const;
+    void set_cell_size_3d(float p_size);
+    float get_cell_size_3d() const;
+    void set_wake_radius_3d(float p_radius);
+    float get_wake_radius_3d() const;
+
+    // p_visual is the child that bobs (usually the Sprite2D)
+    void add_item_2d(Node2D *p_item, Node2D *p_visual, float p_amplitude, float p_speed, float p_range);
+    // p_visuals: MeshInstance3D (or other VisualInstance3D) children that bob and spin
+    void add_item_3d(Node3D *p_item, const Array &p_visuals, float p_amplitude, float p_speed, float p_spin_speed, float p_phase);
+    // Puts the visuals back at rest and forgets the item
+    void remove_item(Node *p_item);
+    bool has_item(Node *p_item) const;
+    // Re-reads the rest position after the item node itself was moved
+    void refresh_item(Node *p_item);
+
+    int get_item_count() const;
+    int get_awake_count() const;
+
+    // Connected to RenderingServer.frame_pre_draw
+    void _update();
+
+private:
+    void _remove_2d(int p_index);
+    void _remove_3d(int p_index);
+    static void _drop_index(std::vector<int> &r_list, int p_removed, int p_moved_from);
+    static void _notify_wake(uint64_t p_id, bool p_awake);
+    void _rest_3d(int p_index);
+    void _refresh_awake_2d(bool p_has_focus, const Vector2 &p_focus);
+    void _refresh_awake_3d(bool p_has_focus, const Vector3 &p_focus);
+    void _update_2d(float p_delta);
+    void _update_3d(float p_delta);
+};
+
+} // namespace godot
+
+#endif // HOVER_SYSTEM_H
@@ -0,0 +1,290 @@
+#include "input_buffer.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/input_event_mouse_motion.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include "input_latency.h"
+#include "input_replay.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+InputBuffer *InputBuffer::singleton = nullptr;
+
+void InputBuffer::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &InputBuffer::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &InputBuffer::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    ClassDB::bind_method(D_METHOD("listen"), &InputBuffer::listen);
+    ClassDB::bind_method(D_METHOD("push_event", "event"), &InputBuffer::push_event);
+    ClassDB::bind_method(D_METHOD("release_all"), &InputBuffer::release_all);
+    ClassDB::bind_method(D_METHOD("get_amount", "action"), &InputBuffer::get_amount);
+    ClassDB::bind_method(D_METHOD("is_held", "action"), &InputBuffer::is_held);
+    ClassDB::bind_method(D_METHOD("was_pressed", "action"), &InputBuffer::was_pressed);
+    ClassDB::bind_method(D_METHOD("was_released", "action"), &InputBuffer::was_released);
+    ClassDB::bind_method(D_METHOD("get_vector", "negative_x", "positive_x", "negative_y", "positive_y"), &InputBuffer::get_vector);
+    ClassDB::bind_method(D_METHOD("get_look"), &InputBuffer::get_look);
+    ClassDB::bind_method(D_METHOD("get_tick"), &InputBuffer::get_tick);
+    ClassDB::bind_method(D_METHOD("get_pending_count"), &InputBuffer::get_pending_count);
+    ClassDB::bind_method(D_METHOD("_build_command"), &InputBuffer::_build_command);
+}
+
+InputBuffer *InputBuffer::get_singleton() {
+    return singleton;
+}
+
+InputBuffer::InputBuffer() {
+    singleton = this;
+    history.resize(HISTORY_SIZE);
+}
+
+InputBuffer::~InputBuffer() {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (tree && tree->is_connected("physics_frame", Callable(this, "_build_command"))) {
+        tree->disconnect("physics_frame", Callable(this, "_build_command"));
+    }
+    // The listener belongs to the root and goes with it
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void InputBuffer::set_enabled(bool p_enabled) {
+    enabled = p_enabled;
+    last_build_usec = 0;
+}
+
+bool InputBuffer::is_enabled() const {
+    return enabled;
+}
+
+void InputBuffer::listen() {
+    if (watching_tree && ObjectDB::get_instance(listener_id)) return;
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || !tree->get_root() || Engine::get_singleton()->is_editor_hint()) return;
+
+    const Callable on_tick(this, "_build_command");
+    if (!tree->is_connected("physics_frame", on_tick)) {
+        tree->connect("physics_frame", on_tick);
+    }
+
+    // Usually called while the root is busy setting up children, hence deferred
+    InputBufferListener *listener = memnew(InputBufferListener);
+    listener->set_name("InputBufferListener");
+    listener->set_process_mode(Node::PROCESS_MODE_ALWAYS); // keeps held state right across pauses
+    tree->get_root()->call_deferred("add_child", listener, false, Node::INTERNAL_MODE_FRONT);
+    listener_id = listener->get_instance_id();
+    watching_tree = true;
+}
+
+void InputBuffer::push_event(const Ref<InputEvent> &p_event) {
+    if (!enabled || p_event.is_null() || p_event->is_echo()) {
+        return;
+    }
+    InputReplay *replay = InputReplay::get_singleton();
+    if (replay && replay->is_replaying()) {
+        return;
+    }
+    // By far the most frequent event, and never an action
+    InputEventMouseMotion *motion = Object::cast_to<InputEventMouseMotion>(p_event.ptr());
+    if (motion) {
+        look += motion->get_relative();
+        return;
+    }
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    if (!snapshot) {
+        return;
+    }
+
+    const uint64_t now = Time::get_singleton()->get_ticks_usec();
+    const int count = snapshot->get_action_count();
+    bool pressed = false;
+    for (int i = 0; i < count; i++) {
+        const StringName action = snapshot->get_action_name(i);
+        if (!p_event->is_action(action)) continue;
+
+        PendingEvent pending_event;
+        pending_event.usec = now;
+        pending_event.action = i;
+        pending_event.strength = p_event->is_action_pressed(action) ? p_event->get_action_strength(action) : 0.0f;
+        pending.push_back(pending_event);
+        pressed = pressed || pending_event.strength > 0.0f;
+    }
+
+    // Releases only ever stop movement
+    InputLatency *latency = InputLatency::get_singleton();
+    if (pressed && latency) {
+        latency->mark_input();
+    }
+}
+
+void InputBuffer::release_all() {
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    if (!snapshot) {
+        return;
+    }
+    // Actions that are already up ignore it
+    const uint64_t now = Time::get_singleton()->get_ticks_usec();
+    const int count = snapshot->get_action_count();
+    for (int i = 0; i < count; i++) {
+        PendingEvent pending_event;
+        pending_event.usec = now;
+        pending_event.action = i;
+        pending_event.strength = 0.0f;
+        pending.push_back(pending_event);
+    }
+}
+
+void InputBuffer::_build_command() {
+    if (!enabled) {
+        return;
+    }
+    PROFILE_ZONE("InputBuffer::_build_command");
+
+    Engine *engine = Engine::get_singleton();
+    InputReplay *replay = InputReplay::get_singleton();
+    if (replay && replay->is_replaying()) {
+        InputCommand command;
+        if (replay->replay_command(engine->get_physics_frames(), command)) {
+            pending.clear();
+            look = Vector2();
+            last_build_usec = Time::get_singleton()->get_ticks_usec();
+            _store(command);
+            return;
+        }
+        // Ran out; back to live input
+    }
+
+    // The window starts where the previous one ended, so ticks run back to back
+    // in one frame don't count the same time twice. The very first covers one tick
+    const uint64_t now = Time::get_singleton()->get_ticks_usec();
+    const uint64_t tick_usec = 1000000 / (uint64_t)MAX(engine->get_physics_ticks_per_second(), 1);
+    const uint64_t window_start = last_build_usec ? MIN(last_build_usec, now) : (now > tick_usec ? now - tick_usec : 0);
+    const uint64_t window_usec = now - window_start;
+    last_build_usec = now;
+
+    InputCommand command;
+    command.tick = engine->get_physics_frames();
+
+    // Integrate each action's strength over [window_start, now]; an event splits its action's span
+    uint64_t span_start[InputSnapshot::MAX_ACTIONS];
+    float press_strength[InputSnapshot::MAX_ACTIONS];
+    for (int i = 0; i < InputSnapshot::MAX_ACTIONS; i++) {
+        span_start[i] = window_start;
+        press_strength[i] = 0.0f;
+    }
+    for (const PendingEvent &event : pending) {
+        const int a = event.action;
+        const uint64_t at = CLAMP(event.usec, window_start, now);
+        command.amount[a] += strengths[a] * (float)(at - span_start[a]);
+        span_start[a] = at;
+
+        const uint64_t bit = uint64_t(1) << a;
+        if (strengths[a] <= 0.0f && event.strength > 0.0f) {
+            command.pressed |= bit;
+            press_strength[a] = MAX(press_strength[a], event.strength);
+        } else if (strengths[a] > 0.0f && event.strength <= 0.0f) {
+            command.released |= bit;
+        }
+        strengths[a] = event.strength;
+    }
+    pending.clear();
+
+    for (int i = 0; i < InputSnapshot::MAX_ACTIONS; i++) {
+        // An empty window (a second tick in the same microsecond) just reports the level
+        command.amount[i] = window_usec > 0
+                ? (command.amount[i] + strengths[i] * (float)(now - span_start[i])) / (float)window_usec
+                : strengths[i];
+        // Delivered just before the tick, a press would otherwise average to ~0
+        if ((command.pressed >> i) & 1) {
+            command.amount[i] = MAX(command.amount[i], strengths[i] > 0.0f ? strengths[i] : press_strength[i]);
+        }
+        if (strengths[i] > 0.0f) {
+            command.held |= uint64_t(1) << i;
+        }
+    }
+
+    command.look = look;
+    look = Vector2();
+
+    _store(command);
+    if (replay && replay->is_recording()) {
+        replay->record_command(command);
+    }
+}
+
+void InputBuffer::_store(const InputCommand &p_command) {
+    current = p_command;
+    history[command_count % HISTORY_SIZE] = p_command;
+    command_count++;
+}
+
+bool InputBuffer::get_history(int p_age, InputCommand &r_command) const {
+    if (p_age < 0 || p_age >= HISTORY_SIZE || (uint64_t)p_age >= command_count) {
+        return false;
+    }
+    r_command = history[(command_count - 1 - p_age) % HISTORY_SIZE];
+    return true;
+}
+
+float InputBuffer::get_amount(int p_action) const {
+    ERR_FAIL_INDEX_V(p_action, InputSnapshot::MAX_ACTIONS, 0.0f);
+    return current.amount[p_action];
+}
+
+bool InputBuffer::is_held(int p_action) const {
+    return (unsigned)p_action < InputSnapshot::MAX_ACTIONS && ((current.held >> p_action) & 1);
+}
+
+bool InputBuffer::was_pressed(int p_action) const {
+    return (unsigned)p_action < InputSnapshot::MAX_ACTIONS && ((current.pressed >> p_action) & 1);
+}
+
+bool InputBuffer::was_released(int p_action) const {
+    return (unsigned)p_action < InputSnapshot::MAX_ACTIONS && ((current.released >> p_action) & 1);
+}
+
+Vector2 InputBuffer::get_vector(int p_negative_x, int p_positive_x, int p_negative_y, int p_positive_y) const {
+    Vector2 vector(get_amount(p_positive_x) - get_amount(p_negative_x), get_amount(p_positive_y) - get_amount(p_negative_y));
+    const float length = vector.length();
+    return length > 1.0f ? vector / length : vector;
+}
+
+Vector2 InputBuffer::get_look() const {
+    return current.look;
+}
+
+int64_t InputBuffer::get_tick() const {
+    return (int64_t)current.tick;
+}
+
+int InputBuffer::get_pending_count() const {
+    return (int)pending.size();
+}
+
+void InputBufferListener::_bind_methods() {
+}
+
+void InputBufferListener::_notification(int p_what) {
+    // Key-up events for keys let go while unfocused never arrive
+    if (p_what == NOTIFICATION_APPLICATION_FOCUS_OUT || p_what == NOTIFICATION_WM_WINDOW_FOCUS_OUT) {
+        InputBuffer *buffer = InputBuffer::get_singleton();
+        if (buffer) {
+            buffer->release_all();
+        }
+    }
+}
+
+void InputBufferListener::_input(const Ref<InputEvent> &p_event) {
+    InputBuffer *buffer = InputBuffer::get_singleton();
+    if (buffer) {
+        buffer->push_event(p_event);
+    }
+}
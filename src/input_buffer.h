@@ -0,0 +1,134 @@
+#ifndef INPUT_BUFFER_H
+#define INPUT_BUFFER_H
+
+#include <godot_cpp/classes/input_event.hpp>
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "input_snapshot.h"
+
+namespace godot {
+
+// What the player did during one physics tick, for the InputSnapshot actions
+struct InputCommand {
+    uint64_t tick = 0;            // Engine physics frame it was built for
+    uint64_t held = 0;            // down at the end of the tick
+    uint64_t pressed = 0;         // went down during the tick, taps included
+    uint64_t released = 0;        // came up during the tick
+    float amount[InputSnapshot::MAX_ACTIONS] = {}; // strength averaged over the tick (1 = held throughout)
+    Vector2 look;                 // mouse motion summed over the tick
+};
+
+// Turns InputEvents into one InputCommand per physics tick, so movement can be
+// applied in _physics_process independent of the render rate and presses
+// shorter than a frame still count.
+//
+// Events are timestamped as they arrive (through a small InputBufferListener
+// node under the root) and queued. On SceneTree.physics_frame the queue is
+// folded into a command covering the time since the previous command: each
+// action's strength is integrated over that window, and any press or release
+// in between sets the matching bit. When a frame runs several ticks back to
+// back, the first one takes the frame's events and the rest see the held state.
+//
+// Godot hands over a frame's input just before its physics ticks, so the
+// arrival times say nothing about when inside the frame a key went down. A
+// press therefore counts from the start of its window: the tick it lands in
+// gets the full pressed strength, the same as a replayed press, and a tap
+// shorter than a frame moves for one whole tick.
+//
+// Held actions are released when the window or application loses focus, since
+// the key-up events then never reach us.
+//
+// The actions are InputSnapshot's; register them there first. Recent commands
+// are kept in a ring for whoever needs the history. While InputReplay is
+// recording, each command is handed to it; while it replays, the recorded
+// commands stand in for live events.
+class InputBuffer : public Object {
+    GDCLASS(InputBuffer, Object);
+
+public:
+    static const int HISTORY_SIZE = 256;
+
+private:
+    struct PendingEvent {
+        uint64_t usec;
+        int action;
+        float strength;
+    };
+
+    static InputBuffer *singleton;
+
+    bool enabled = true;
+    bool watching_tree = false;
+    uint64_t listener_id = 0;
+    uint64_t last_build_usec = 0;        // end of the previous command's window
+
+    std::vector<PendingEvent> pending;
+    float strengths[InputSnapshot::MAX_ACTIONS] = {};   // current level per action
+    Vector2 look;                        // mouse motion since the last command
+    InputCommand current;
+    std::vector<InputCommand> history;   // ring of HISTORY_SIZE
+    uint64_t command_count = 0;
+
+    void _store(const InputCommand &p_command);
+
+protected:
+    static void _bind_methods();
+
+public:
+    static InputBuffer *get_singleton();
+
+    InputBuffer();
+    ~InputBuffer();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+
+    // Puts the listener in the tree and hooks the physics tick; consumers call it
+    // from _ready, and calling it again does nothing
+    void listen();
+
+    // From InputBufferListener::_input
+    void push_event(const Ref<InputEvent> &p_event);
+    // Queues a release for every action, e.g. on focus loss
+    void release_all();
+
+    // The command for the physics tick in progress
+    const InputCommand &get_command() const { return current; }
+    // p_age 0 is the current command; false once it has left the ring
+    bool get_history(int p_age, InputCommand &r_command) const;
+
+    float get_amount(int p_action) const;
+    bool is_held(int p_action) const;
+    bool was_pressed(int p_action) const;
+    bool was_released(int p_action) const;
+    // Like Input.get_vector, but from the tick-averaged amounts
+    Vector2 get_vector(int p_negative_x, int p_positive_x, int p_negative_y, int p_positive_y) const;
+    Vector2 get_look() const;
+    int64_t get_tick() const;
+    int get_pending_count() const;
+
+    // Connected to SceneTree.physics_frame
+    void _build_command();
+};
+
+// Feeds InputBuffer; added under the root by the buffer itself
+class InputBufferListener : public Node {
+    GDCLASS(InputBufferListener, Node);
+
+protected:
+    static void _bind_methods();
+
+public:
+    void _notification(int p_what);
+    void _input(const Ref<InputEvent> &p_event) override;
+};
+
+} // namespace godot
+
+#endif // INPUT_BUFFER_H
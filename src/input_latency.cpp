@@ -0,0 +1,140 @@
+#include "input_latency.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+
+#include "profile_zone.h"
+
+using namespace godot;
+
+InputLatency *InputLatency::singleton = nullptr;
+
+void InputLatency::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &InputLatency::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &InputLatency::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    ClassDB::bind_method(D_METHOD("set_max_pending_ms", "ms"), &InputLatency::set_max_pending_ms);
+    ClassDB::bind_method(D_METHOD("get_max_pending_ms"), &InputLatency::get_max_pending_ms);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_pending_ms"), "set_max_pending_ms", "get_max_pending_ms");
+
+    ClassDB::bind_method(D_METHOD("mark_input"), &InputLatency::mark_input);
+    ClassDB::bind_method(D_METHOD("mark_motion"), &InputLatency::mark_motion);
+    ClassDB::bind_method(D_METHOD("mark_movement", "was_moving", "amount"), &InputLatency::mark_movement);
+    ClassDB::bind_method(D_METHOD("get_percentile_ms", "stage", "percentile"), &InputLatency::get_percentile_ms);
+    ClassDB::bind_method(D_METHOD("get_sample_count"), &InputLatency::get_sample_count);
+    ClassDB::bind_method(D_METHOD("reset"), &InputLatency::reset);
+    ClassDB::bind_method(D_METHOD("_frame_drawn"), &InputLatency::_frame_drawn);
+
+    BIND_CONSTANT(STAGE_INPUT_TO_MOTION);
+    BIND_CONSTANT(STAGE_MOTION_TO_DRAW);
+    BIND_CONSTANT(STAGE_INPUT_TO_DRAW);
+}
+
+InputLatency *InputLatency::get_singleton() {
+    return singleton;
+}
+
+InputLatency::InputLatency() {
+    singleton = this;
+    RenderingServer::get_singleton()->connect("frame_post_draw", Callable(this, "_frame_drawn"));
+}
+
+InputLatency::~InputLatency() {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (rs && rs->is_connected("frame_post_draw", Callable(this, "_frame_drawn"))) {
+        rs->disconnect("frame_post_draw", Callable(this, "_frame_drawn"));
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void InputLatency::set_enabled(bool p_enabled) {
+    enabled = p_enabled;
+    pending_ns = 0;
+    in_flight.clear();
+}
+
+bool InputLatency::is_enabled() const {
+    return enabled;
+}
+
+void InputLatency::set_max_pending_ms(float p_ms) {
+    max_pending_ms = MAX(p_ms, 1.0f);
+}
+
+float InputLatency::get_max_pending_ms() const {
+    return max_pending_ms;
+}
+
+void InputLatency::mark_input() {
+    if (enabled && pending_ns == 0) {
+        pending_ns = ProfileCapture::now_ns();
+    }
+}
+
+void InputLatency::mark_motion() {
+    if (!enabled || pending_ns == 0) {
+        return;
+    }
+    InFlight entry;
+    entry.input_ns = pending_ns;
+    entry.motion_ns = ProfileCapture::now_ns();
+    in_flight.push_back(entry);
+    pending_ns = 0;
+}
+
+bool InputLatency::mark_movement(bool p_was_moving, float p_amount) {
+    const bool moving = p_amount > MOTION_THRESHOLD;
+    if (moving && !p_was_moving) {
+        mark_motion();
+    } else if (moving) {
+        // Already moving: whatever came in (a modifier, another direction) started nothing
+        pending_ns = 0;
+    }
+    return moving;
+}
+
+void InputLatency::_frame_drawn() {
+    if (!enabled) {
+        return;
+    }
+    const uint64_t now = ProfileCapture::now_ns();
+
+    for (const InFlight &entry : in_flight) {
+        histograms[STAGE_INPUT_TO_MOTION].add((entry.motion_ns - entry.input_ns) / 1000);
+        histograms[STAGE_MOTION_TO_DRAW].add((now - entry.motion_ns) / 1000);
+        histograms[STAGE_INPUT_TO_DRAW].add((now - entry.input_ns) / 1000);
+
+        if (ProfileCapture::is_active()) {
+            static const ProfileCapture::Track track = ProfileCapture::get_track("Input latency");
+            ProfileCapture::record_on_track(track, "Input to motion", entry.input_ns, entry.motion_ns);
+            ProfileCapture::record_on_track(track, "Motion to draw", entry.motion_ns, now);
+        }
+    }
+    in_flight.clear();
+
+    // Input that nothing moved for (menus, unbound keys) would otherwise inflate the next sample
+    if (pending_ns != 0 && now - pending_ns > (uint64_t)(max_pending_ms * 1000000.0f)) {
+        pending_ns = 0;
+    }
+}
+
+double InputLatency::get_percentile_ms(int p_stage, double p_percentile) const {
+    ERR_FAIL_INDEX_V(p_stage, STAGE_MAX, 0.0);
+    return (double)histograms[p_stage].percentile_usec(p_percentile) / 1000.0;
+}
+
+int64_t InputLatency::get_sample_count() const {
+    return (int64_t)histograms[STAGE_INPUT_TO_DRAW].get_count();
+}
+
+void InputLatency::reset() {
+    for (LatencyHistogram &histogram : histograms) {
+        histogram.clear();
+    }
+    pending_ns = 0;
+    in_flight.clear();
+}
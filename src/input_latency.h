@@ -0,0 +1,89 @@
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "latency_histogram.h"
+
+namespace godot {
+
+// Input-to-screen latency. An input is stamped (steady clock, same as
+// ProfileCapture) when it reaches the game, again when a movement update first
+// acts on it, and closed when the frame showing that movement has been drawn
+// (RenderingServer.frame_post_draw). Each stage goes into a histogram, the
+// total into the "Native/Input latency" monitors, and while a profile capture
+// runs every span is also written to an "Input latency" trace track.
+//
+// Only the oldest input not yet acted on is tracked, so a burst of mouse
+// motion counts from its first event. Key releases don't count as input, and
+// for movement only an update that starts moving closes a sample: a key
+// pressed while already moving (sprint, a second direction) is dropped, as
+// are inputs nothing moved for within max_pending_ms. What the display does
+// after the draw (vsync, compositor, scanout) is not visible from here.
+class InputLatency : public Object {
+    GDCLASS(InputLatency, Object);
+
+public:
+    // Input strength at or below which an update doesn't count as moving
+    static constexpr float MOTION_THRESHOLD = 0.05f;
+
+    enum Stage {
+        STAGE_INPUT_TO_MOTION,
+        STAGE_MOTION_TO_DRAW,
+        STAGE_INPUT_TO_DRAW,
+        STAGE_MAX
+    };
+
+private:
+    struct InFlight {
+        uint64_t input_ns;
+        uint64_t motion_ns;
+    };
+
+    static InputLatency *singleton;
+
+    bool enabled = true;
+    float max_pending_ms = 250.0f;
+
+    uint64_t pending_ns = 0;            // input waiting for a movement update, 0 if none
+    std::vector<InFlight> in_flight;    // moved, waiting for the frame to be drawn
+    LatencyHistogram histograms[STAGE_MAX];
+
+protected:
+    static void _bind_methods();
+
+public:
+    static InputLatency *get_singleton();
+
+    InputLatency();
+    ~InputLatency();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+    void set_max_pending_ms(float p_ms);
+    float get_max_pending_ms() const;
+
+    // An input arrived
+    void mark_input();
+    // A movement update just applied whatever input was pending
+    void mark_motion();
+    // For movement updates that run every tick: p_amount is the input's
+    // strength this update (0 to 1), p_was_moving what the previous call
+    // returned. Marks motion only when moving starts; returns whether moving
+    bool mark_movement(bool p_was_moving, float p_amount);
+
+    double get_percentile_ms(int p_stage, double p_percentile) const;
+    int64_t get_sample_count() const;
+    void reset();
+
+    // Connected to RenderingServer.frame_post_draw
+    void _frame_drawn();
+};
+
+} // namespace godot
+
+#endif // INPUT_LATENCY_H
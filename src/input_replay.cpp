@@ -0,0 +1,393 @@
+#include "input_replay.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include "input_snapshot.h"
+
+using namespace godot;
+
+InputReplay *InputReplay::singleton = nullptr;
+
+void InputReplay::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("start_recording", "path", "seed"), &InputReplay::start_recording, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("stop_recording"), &InputReplay::stop_recording);
+    ClassDB::bind_method(D_METHOD("start_replay", "path"), &InputReplay::start_replay);
+    ClassDB::bind_method(D_METHOD("stop_replay"), &InputReplay::stop_replay);
+    ClassDB::bind_method(D_METHOD("get_mode"), &InputReplay::get_mode);
+    ClassDB::bind_method(D_METHOD("is_active"), &InputReplay::is_active);
+    ClassDB::bind_method(D_METHOD("is_recording"), &InputReplay::is_recording);
+    ClassDB::bind_method(D_METHOD("is_replaying"), &InputReplay::is_replaying);
+    ClassDB::bind_method(D_METHOD("get_seed"), &InputReplay::get_seed);
+    ClassDB::bind_method(D_METHOD("take_seed"), &InputReplay::take_seed);
+    ClassDB::bind_method(D_METHOD("get_tick_count"), &InputReplay::get_tick_count);
+    ClassDB::bind_method(D_METHOD("get_replay_tick"), &InputReplay::get_replay_tick);
+
+    ClassDB::bind_method(D_METHOD("set_quit_on_finish", "quit"), &InputReplay::set_quit_on_finish);
+    ClassDB::bind_method(D_METHOD("get_quit_on_finish"), &InputReplay::get_quit_on_finish);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quit_on_finish"), "set_quit_on_finish", "get_quit_on_finish");
+
+    ClassDB::bind_method(D_METHOD("_tree_exiting"), &InputReplay::_tree_exiting);
+
+    ADD_SIGNAL(MethodInfo("replay_finished", PropertyInfo(Variant::INT, "ticks"), PropertyInfo(Variant::FLOAT, "seconds")));
+
+    BIND_CONSTANT(MODE_IDLE);
+    BIND_CONSTANT(MODE_RECORDING);
+    BIND_CONSTANT(MODE_REPLAYING);
+}
+
+InputReplay *InputReplay::get_singleton() {
+    return singleton;
+}
+
+// Before the main scene loads, so the seed is in place for everything it creates
+InputReplay::InputReplay() {
+    singleton = this;
+    if (!Engine::get_singleton()->is_editor_hint()) {
+        _apply_cmdline();
+    }
+}
+
+InputReplay::~InputReplay() {
+    if (watching_tree) {
+        SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+        Window *root = tree ? tree->get_root() : nullptr;
+        if (root && root->is_connected("tree_exiting", Callable(this, "_tree_exiting"))) {
+            root->disconnect("tree_exiting", Callable(this, "_tree_exiting"));
+        }
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void InputReplay::_apply_cmdline() {
+    String record;
+    String replay;
+    int64_t seed_arg = 0;
+
+    PackedStringArray args = OS::get_singleton()->get_cmdline_user_args();
+    for (int i = 0; i < args.size(); i++) {
+        const String arg = args[i];
+        const int eq = arg.find("=");
+        if (!arg.begins_with("--") || eq < 0) continue;
+
+        const String key = arg.substr(2, eq - 2);
+        const String value = arg.substr(eq + 1);
+        if (key == "record") record = value;
+        else if (key == "replay") replay = value;
+        else if (key == "seed") seed_arg = value.to_int();
+    }
+
+    if (!replay.is_empty()) {
+        quit_on_finish = true;
+        start_replay(replay);
+    } else if (!record.is_empty()) {
+        start_recording(record, seed_arg);
+    }
+}
+
+// Only the root's tree_exiting is needed, and the tree does not exist yet when
+// the command line starts a run
+void InputReplay::_watch_tree() {
+    if (watching_tree) return;
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree || !tree->get_root()) return;
+
+    const Callable on_exit(this, "_tree_exiting");
+    if (!tree->get_root()->is_connected("tree_exiting", on_exit)) {
+        tree->get_root()->connect("tree_exiting", on_exit);
+    }
+    watching_tree = true;
+}
+
+void InputReplay::_apply_seed() {
+    UtilityFunctions::seed((int64_t)seed);
+    seeds_taken = 0;
+}
+
+void InputReplay::set_quit_on_finish(bool p_quit) {
+    quit_on_finish = p_quit;
+}
+
+bool InputReplay::get_quit_on_finish() const {
+    return quit_on_finish;
+}
+
+int64_t InputReplay::get_seed() const {
+    return (int64_t)seed;
+}
+
+// splitmix64 over the run seed and a counter
+int64_t InputReplay::take_seed() {
+    ERR_FAIL_COND_V_MSG(mode == MODE_IDLE, 0, "InputReplay: not recording or replaying");
+    uint64_t z = seed + (++seeds_taken) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (int64_t)(z ^ (z >> 31));
+}
+
+int64_t InputReplay::get_tick_count() const {
+    return mode == MODE_REPLAYING ? (int64_t)replay_total_ticks : (int64_t)recorded_ticks;
+}
+
+int64_t InputReplay::get_replay_tick() const {
+    return (int64_t)replay_ticks;
+}
+
+bool InputReplay::start_recording(const String &p_path, int64_t p_seed) {
+    ERR_FAIL_COND_V_MSG(mode != MODE_IDLE, false, "InputReplay: already recording or replaying");
+
+    seed = (uint64_t)p_seed;
+    if (seed == 0) {
+        seed = Time::get_singleton()->get_ticks_usec() ^ ((uint64_t)Time::get_singleton()->get_unix_time_from_system() << 20);
+        seed = seed ? seed : 1;
+    }
+    record_path = p_path;
+    writer.clear();
+    recorded_ticks = 0;
+    mode = MODE_RECORDING;
+    _apply_seed();
+    _watch_tree();
+
+    UtilityFunctions::print("InputReplay: recording to ", record_path, " with seed ", (int64_t)seed);
+    return true;
+}
+
+// Little-endian layout:
+//   u32 magic, u32 version, u32 physics_ticks_per_second, u64 seed, u32 tick_count,
+//   u32 action_count, action names (pascal strings), u32 record_bytes, records (replay_format.h)
+bool InputReplay::stop_recording() {
+    if (mode != MODE_RECORDING) {
+        return false;
+    }
+    mode = MODE_IDLE;
+
+    DirAccess::make_dir_recursive_absolute(record_path.get_base_dir());
+    Ref<FileAccess> file = FileAccess::open(record_path, FileAccess::WRITE);
+    if (file.is_null()) {
+        UtilityFunctions::push_warning("InputReplay: could not write ", record_path);
+        return false;
+    }
+
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    const int action_count = snapshot ? snapshot->get_action_count() : 0;
+    const std::vector<uint8_t> &bytes = writer.get_bytes();
+
+    file->store_32(REPLAY_MAGIC);
+    file->store_32(REPLAY_VERSION);
+    file->store_32((uint32_t)Engine::get_singleton()->get_physics_ticks_per_second());
+    file->store_64(seed);
+    file->store_32(recorded_ticks);
+    file->store_32((uint32_t)action_count);
+    for (int i = 0; i < action_count; i++) {
+        file->store_pascal_string(snapshot->get_action_name(i));
+    }
+    file->store_32((uint32_t)bytes.size());
+
+    PackedByteArray data;
+    data.resize((int64_t)bytes.size());
+    if (!bytes.empty()) {
+        memcpy(data.ptrw(), bytes.data(), bytes.size());
+    }
+    file->store_buffer(data);
+    file->close();
+
+    UtilityFunctions::print("InputReplay: ", (int64_t)recorded_ticks, " ticks (", (int64_t)bytes.size(),
+            " bytes) written to ", record_path);
+    writer.clear();
+    return true;
+}
+
+bool InputReplay::start_replay(const String &p_path) {
+    ERR_FAIL_COND_V_MSG(mode != MODE_IDLE, false, "InputReplay: already recording or replaying");
+
+    Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+    if (file.is_null()) {
+        UtilityFunctions::push_warning("InputReplay: could not read ", p_path);
+        return false;
+    }
+    ERR_FAIL_COND_V_MSG(file->get_32() != REPLAY_MAGIC, false, "InputReplay: not a replay file: " + p_path);
+    ERR_FAIL_COND_V_MSG(file->get_32() != REPLAY_VERSION, false, "InputReplay: unsupported replay version: " + p_path);
+
+    const int ticks_per_second = (int)file->get_32();
+    seed = file->get_64();
+    replay_total_ticks = file->get_32();
+    const uint32_t action_count = file->get_32();
+    ERR_FAIL_COND_V_MSG(action_count > (uint32_t)InputSnapshot::MAX_ACTIONS, false, "InputReplay: corrupt replay file: " + p_path);
+
+    replay_actions.clear();
+    for (uint32_t i = 0; i < action_count; i++) {
+        replay_actions.push_back(StringName(file->get_pascal_string()));
+    }
+    const uint32_t byte_count = file->get_32();
+    replay_data = file->get_buffer(byte_count);
+    ERR_FAIL_COND_V_MSG((uint32_t)replay_data.size() != byte_count, false, "InputReplay: truncated replay file: " + p_path);
+
+    // The commands only mean the same thing at the rate they were built for
+    if (ticks_per_second > 0 && ticks_per_second != Engine::get_singleton()->get_physics_ticks_per_second()) {
+        Engine::get_singleton()->set_physics_ticks_per_second(ticks_per_second);
+    }
+
+    action_map.assign(action_count, -1);
+    replay_offset = 0;
+    replay_run_left = 0;
+    replayed = InputCommand();
+    replayed_tick = UINT64_MAX;
+    replay_ticks = 0;
+    replay_start_usec = Time::get_singleton()->get_ticks_usec();
+    replay_start_frame = Engine::get_singleton()->get_process_frames();
+    mode = MODE_REPLAYING;
+    _apply_seed();
+    _watch_tree();
+
+    UtilityFunctions::print("InputReplay: replaying ", p_path, ", ", (int64_t)replay_total_ticks, " ticks with seed ", (int64_t)seed);
+    return true;
+}
+
+void InputReplay::stop_replay() {
+    if (mode != MODE_REPLAYING) {
+        return;
+    }
+    mode = MODE_IDLE;
+    replay_data = PackedByteArray();
+    replay_actions.clear();
+    action_map.clear();
+}
+
+// Actions are resolved by name, so a recording survives consumers registering
+// in a different order; ones nobody has registered yet are retried later
+void InputReplay::_map_actions() {
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    if (!snapshot) return;
+    for (int i = 0; i < (int)action_map.size(); i++) {
+        if (action_map[i] < 0) {
+            action_map[i] = snapshot->get_action_index(replay_actions[i]);
+        }
+    }
+}
+
+void InputReplay::_warn_unmapped() const {
+    String missing;
+    for (int i = 0; i < (int)action_map.size(); i++) {
+        if (action_map[i] >= 0) continue;
+        if (!missing.is_empty()) missing += ", ";
+        missing += String(replay_actions[i]);
+    }
+    if (!missing.is_empty()) {
+        UtilityFunctions::push_warning("InputReplay: recorded actions not registered with InputSnapshot, not replayed: ", missing);
+    }
+}
+
+void InputReplay::_finish_replay() {
+    const double seconds = (double)(Time::get_singleton()->get_ticks_usec() - replay_start_usec) / 1000000.0;
+    const uint64_t frames = Engine::get_singleton()->get_process_frames() - replay_start_frame;
+    const int64_t ticks = (int64_t)replay_ticks;
+    stop_replay();
+
+    UtilityFunctions::print("InputReplay: ", ticks, " ticks, ", (int64_t)frames, " frames in ", String::num(seconds, 3), " s (",
+            String::num(seconds > 0.0 ? (double)ticks / seconds : 0.0, 1), " ticks/s, ",
+            String::num(frames ? seconds * 1000.0 / (double)frames : 0.0, 3), " ms/frame)");
+    emit_signal("replay_finished", ticks, seconds);
+
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (quit_on_finish && tree) {
+        tree->quit();
+    }
+}
+
+void InputReplay::record_command(const InputCommand &p_command) {
+    if (mode != MODE_RECORDING) {
+        return;
+    }
+    ReplayRecord record;
+    record.held = p_command.held;
+    record.pressed = p_command.pressed;
+    record.released = p_command.released;
+    for (int i = 0; i < InputSnapshot::MAX_ACTIONS; i++) {
+        record.amounts[i] = ReplayRecord::quantize(p_command.amount[i]);
+        if (record.amounts[i]) {
+            record.amount_mask |= uint64_t(1) << i;
+        }
+    }
+    record.look_x = p_command.look.x;
+    record.look_y = p_command.look.y;
+
+    _watch_tree();
+    writer.add(record);
+    recorded_ticks++;
+}
+
+bool InputReplay::replay_command(uint64_t p_tick, InputCommand &r_command) {
+    if (mode != MODE_REPLAYING) {
+        return false;
+    }
+    if (p_tick == replayed_tick) {
+        r_command = replayed;
+        return true;
+    }
+
+    if (replay_run_left == 0) {
+        ReplayReader reader(replay_data.ptr(), (size_t)replay_data.size());
+        reader.set_position(replay_offset);
+        if (!reader.get_record(replay_record)) {
+            _finish_replay();
+            return false;
+        }
+        replay_offset = reader.get_position();
+        replay_run_left = replay_record.run;
+        _map_actions();
+    }
+
+    if (replay_ticks == 0) {
+        // Nothing waits on the display from here on
+        Engine::get_singleton()->set_max_fps(0);
+        DisplayServer *display = DisplayServer::get_singleton();
+        if (display) {
+            display->window_set_vsync_mode(DisplayServer::VSYNC_DISABLED);
+        }
+        replay_start_usec = Time::get_singleton()->get_ticks_usec();
+        replay_start_frame = Engine::get_singleton()->get_process_frames();
+        _watch_tree();
+    } else if (replay_ticks == 1) {
+        // Consumers register their actions in _ready, which has run for all of them by now
+        _map_actions();
+        _warn_unmapped();
+    }
+
+    InputCommand command;
+    command.tick = p_tick;
+    for (int i = 0; i < (int)action_map.size(); i++) {
+        const int action = action_map[i];
+        if (action < 0) continue;
+        const uint64_t bit = uint64_t(1) << action;
+        if ((replay_record.held >> i) & 1) command.held |= bit;
+        if ((replay_record.pressed >> i) & 1) command.pressed |= bit;
+        if ((replay_record.released >> i) & 1) command.released |= bit;
+        if ((replay_record.amount_mask >> i) & 1) {
+            command.amount[action] = ReplayRecord::dequantize(replay_record.amounts[i]);
+        }
+    }
+    command.look = Vector2(replay_record.look_x, replay_record.look_y);
+
+    replay_run_left--;
+    replay_ticks++;
+    replayed = command;
+    replayed_tick = p_tick;
+    r_command = command;
+    return true;
+}
+
+void InputReplay::_tree_exiting() {
+    stop_recording();
+    stop_replay();
+}
@@ -0,0 +1,132 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "input_buffer.h"
+#include "replay_format.h"
+
+namespace godot {
+
+// Records the InputBuffer command stream, one command per physics tick, and
+// plays it back so a session can be re-run headless as a benchmark.
+//
+// A recording holds the physics tick rate, a seed, the InputSnapshot action
+// names and the run-length encoded commands (replay_format.h). The seed goes
+// into the global RNG (randi/randf) and, through take_seed(), into every
+// AIOrchestrator created while recording or replaying, so both runs make the
+// same choices given the same inputs. While replaying, InputBuffer and
+// InputSnapshot serve the recorded commands instead of live input, which is
+// what KeyInput, EnhancedInputHandling and the proto controller read; mouse
+// look is carried per tick alongside.
+//
+// Started from the command line, after the "--" separator:
+//   godot --path game-engine-assignment -- --record=user://replays/run.irec [--seed=N]
+//   godot --headless --fixed-fps 60 --path game-engine-assignment -- --replay=user://replays/run.irec
+// A replay lifts the frame rate cap and quits when the commands run out,
+// printing the wall time; --fixed-fps keeps the simulated deltas identical to
+// the recording's while the frames run as fast as they can.
+class InputReplay : public Object {
+    GDCLASS(InputReplay, Object);
+
+public:
+    enum {
+        MODE_IDLE,
+        MODE_RECORDING,
+        MODE_REPLAYING
+    };
+
+    static const uint32_t REPLAY_MAGIC = 0x4C505249;   // "IRPL"
+    static const uint32_t REPLAY_VERSION = 1;
+
+private:
+    static InputReplay *singleton;
+
+    int mode = MODE_IDLE;
+    bool quit_on_finish = false;
+    uint64_t seed = 0;
+    uint64_t seeds_taken = 0;
+    bool watching_tree = false;
+
+    // Recording
+    String record_path;
+    ReplayWriter writer;
+    uint32_t recorded_ticks = 0;
+
+    // Replaying
+    PackedByteArray replay_data;
+    size_t replay_offset = 0;            // next record in replay_data
+    ReplayRecord replay_record;
+    uint32_t replay_run_left = 0;        // ticks left on replay_record
+    std::vector<StringName> replay_actions;
+    std::vector<int> action_map;         // file action -> InputSnapshot index, -1 until registered
+    InputCommand replayed;
+    uint64_t replayed_tick = UINT64_MAX;
+    uint32_t replay_ticks = 0;
+    uint32_t replay_total_ticks = 0;
+    uint64_t replay_start_usec = 0;
+    uint64_t replay_start_frame = 0;
+
+    void _apply_cmdline();
+    void _watch_tree();
+    void _apply_seed();
+    void _map_actions();
+    void _warn_unmapped() const;
+    void _finish_replay();
+
+protected:
+    static void _bind_methods();
+
+public:
+    static InputReplay *get_singleton();
+
+    InputReplay();
+    ~InputReplay();
+
+    // p_seed 0 picks one
+    bool start_recording(const String &p_path, int64_t p_seed = 0);
+    bool stop_recording();
+    bool start_replay(const String &p_path);
+    void stop_replay();
+
+    int get_mode() const { return mode; }
+    bool is_active() const { return mode != MODE_IDLE; }
+    bool is_recording() const { return mode == MODE_RECORDING; }
+    bool is_replaying() const { return mode == MODE_REPLAYING; }
+    void set_quit_on_finish(bool p_quit);
+    bool get_quit_on_finish() const;
+
+    int64_t get_seed() const;
+    // A fresh seed derived from the run's, for each RNG that should repeat
+    // across record and replay. Seeds are handed out by call order, not by
+    // caller: the n-th take_seed() of a replay gets the n-th seed of the
+    // recording. Anything that takes one only sometimes (a temporary node, a
+    // tool script, an instance that exists in one run but not the other)
+    // shifts every later seed, so take them from nodes that are created the
+    // same way in both runs.
+    int64_t take_seed();
+
+    int64_t get_tick_count() const;
+    int64_t get_replay_tick() const;
+
+    // From InputBuffer::_build_command
+    void record_command(const InputCommand &p_command);
+    // The recorded command for physics tick p_tick. Asking for the same tick
+    // again returns the same command; false once the recording has run out
+    bool replay_command(uint64_t p_tick, InputCommand &r_command);
+    // The last command replay_command produced
+    const InputCommand &get_replayed_command() const { return replayed; }
+
+    // Connected to the root's tree_exiting, so a recording is saved on quit
+    void _tree_exiting();
+};
+
+} // namespace godot
+
+#endif // INPUT_REPLAY_H
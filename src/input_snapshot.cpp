@@ -0,0 +1,281 @@
+#include "input_snapshot.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/input.hpp>
+#include <godot_cpp/classes/input_map.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/core/math.hpp>
+
+#include "input_replay.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+InputSnapshot *InputSnapshot::singleton = nullptr;
+
+void InputSnapshot::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("register_action", "action"), &InputSnapshot::register_action);
+    ClassDB::bind_method(D_METHOD("register_axis", "negative", "positive"), &InputSnapshot::register_axis);
+    ClassDB::bind_method(D_METHOD("register_vector", "negative_x", "positive_x", "negative_y", "positive_y"),
+            &InputSnapshot::register_vector);
+    ClassDB::bind_method(D_METHOD("get_action_index", "action"), &InputSnapshot::get_action_index);
+    ClassDB::bind_method(D_METHOD("get_action_name", "action"), &InputSnapshot::get_action_name);
+    ClassDB::bind_method(D_METHOD("get_action_count"), &InputSnapshot::get_action_count);
+
+    ClassDB::bind_method(D_METHOD("is_pressed_index", "action"), &InputSnapshot::is_pressed_index);
+    ClassDB::bind_method(D_METHOD("is_just_pressed_index", "action"), &InputSnapshot::is_just_pressed_index);
+    ClassDB::bind_method(D_METHOD("is_just_released_index", "action"), &InputSnapshot::is_just_released_index);
+    ClassDB::bind_method(D_METHOD("is_pressed", "action"), &InputSnapshot::is_pressed);
+    ClassDB::bind_method(D_METHOD("is_just_pressed", "action"), &InputSnapshot::is_just_pressed);
+    ClassDB::bind_method(D_METHOD("is_just_released", "action"), &InputSnapshot::is_just_released);
+    ClassDB::bind_method(D_METHOD("get_axis", "axis"), &InputSnapshot::get_axis);
+    ClassDB::bind_method(D_METHOD("get_vector", "vector"), &InputSnapshot::get_vector);
+    ClassDB::bind_method(D_METHOD("get_pressed_mask"), &InputSnapshot::get_pressed_mask);
+    ClassDB::bind_method(D_METHOD("get_just_pressed_mask"), &InputSnapshot::get_just_pressed_mask);
+    ClassDB::bind_method(D_METHOD("get_just_released_mask"), &InputSnapshot::get_just_released_mask);
+
+    ClassDB::bind_method(D_METHOD("_sample_frame"), &InputSnapshot::_sample_frame);
+    ClassDB::bind_method(D_METHOD("_sample_physics"), &InputSnapshot::_sample_physics);
+}
+
+InputSnapshot *InputSnapshot::get_singleton() {
+    return singleton;
+}
+
+InputSnapshot::InputSnapshot() {
+    singleton = this;
+}
+
+InputSnapshot::~InputSnapshot() {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (tree) {
+        if (tree->is_connected("process_frame", Callable(this, "_sample_frame"))) {
+            tree->disconnect("process_frame", Callable(this, "_sample_frame"));
+        }
+        if (tree->is_connected("physics_frame", Callable(this, "_sample_physics"))) {
+            tree->disconnect("physics_frame", Callable(this, "_sample_physics"));
+        }
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+// Both signals fire before the nodes' own _process / _physics_process
+void InputSnapshot::_watch_tree() {
+    if (watching_tree) return;
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree) return;
+
+    const Callable on_frame(this, "_sample_frame");
+    if (!tree->is_connected("process_frame", on_frame)) {
+        tree->connect("process_frame", on_frame);
+    }
+    const Callable on_physics(this, "_sample_physics");
+    if (!tree->is_connected("physics_frame", on_physics)) {
+        tree->connect("physics_frame", on_physics);
+    }
+    watching_tree = true;
+}
+
+int InputSnapshot::register_action(const StringName &p_action) {
+    const int existing = get_action_index(p_action);
+    if (existing >= 0) {
+        return existing;
+    }
+    ERR_FAIL_COND_V_MSG((int)actions.size() >= MAX_ACTIONS, -1, "InputSnapshot: too many actions, " + String(p_action) + " not added");
+    ERR_FAIL_COND_V_MSG(!InputMap::get_singleton()->has_action(p_action), -1, "InputSnapshot: unknown action " + String(p_action));
+
+    actions.push_back(p_action);
+    _watch_tree();
+    return (int)actions.size() - 1;
+}
+
+int InputSnapshot::register_axis(const StringName &p_negative, const StringName &p_positive) {
+    Axis axis;
+    axis.negative = register_action(p_negative);
+    axis.positive = register_action(p_positive);
+    ERR_FAIL_COND_V(axis.negative < 0 || axis.positive < 0, -1);
+
+    for (int i = 0; i < (int)axes.size(); i++) {
+        if (axes[i].negative == axis.negative && axes[i].positive == axis.positive) return i;
+    }
+    ERR_FAIL_COND_V_MSG((int)axes.size() >= MAX_AXES, -1, "InputSnapshot: too many axes");
+
+    axis_actions |= (uint64_t(1) << axis.negative) | (uint64_t(1) << axis.positive);
+    axes.push_back(axis);
+    return (int)axes.size() - 1;
+}
+
+int InputSnapshot::register_vector(const StringName &p_negative_x, const StringName &p_positive_x,
+        const StringName &p_negative_y, const StringName &p_positive_y) {
+    VectorAxes vector;
+    vector.negative_x = register_action(p_negative_x);
+    vector.positive_x = register_action(p_positive_x);
+    vector.negative_y = register_action(p_negative_y);
+    vector.positive_y = register_action(p_positive_y);
+    ERR_FAIL_COND_V(vector.negative_x < 0 || vector.positive_x < 0 || vector.negative_y < 0 || vector.positive_y < 0, -1);
+
+    for (int i = 0; i < (int)vectors.size(); i++) {
+        const VectorAxes &other = vectors[i];
+        if (other.negative_x == vector.negative_x && other.positive_x == vector.positive_x &&
+                other.negative_y == vector.negative_y && other.positive_y == vector.positive_y) {
+            return i;
+        }
+    }
+    ERR_FAIL_COND_V_MSG((int)vectors.size() >= MAX_VECTORS, -1, "InputSnapshot: too many vectors");
+
+    InputMap *input_map = InputMap::get_singleton();
+    vector.deadzone = 0.25f * (input_map->action_get_deadzone(p_negative_x) + input_map->action_get_deadzone(p_positive_x) +
+            input_map->action_get_deadzone(p_negative_y) + input_map->action_get_deadzone(p_positive_y));
+
+    vector_actions |= (uint64_t(1) << vector.negative_x) | (uint64_t(1) << vector.positive_x) |
+            (uint64_t(1) << vector.negative_y) | (uint64_t(1) << vector.positive_y);
+    vectors.push_back(vector);
+    return (int)vectors.size() - 1;
+}
+
+int InputSnapshot::get_action_index(const StringName &p_action) const {
+    for (int i = 0; i < (int)actions.size(); i++) {
+        if (actions[i] == p_action) return i;
+    }
+    return -1;
+}
+
+StringName InputSnapshot::get_action_name(int p_action) const {
+    ERR_FAIL_INDEX_V(p_action, (int)actions.size(), StringName());
+    return actions[p_action];
+}
+
+int InputSnapshot::get_action_count() const {
+    return (int)actions.size();
+}
+
+const InputSnapshot::State &InputSnapshot::_current() const {
+    return Engine::get_singleton()->is_in_physics_frame() ? physics_state : frame_state;
+}
+
+void InputSnapshot::_sample_input(uint64_t &r_pressed) {
+    Input *input = Input::get_singleton();
+    for (int i = 0; i < (int)actions.size(); i++) {
+        const uint64_t bit = uint64_t(1) << i;
+        if (input->is_action_pressed(actions[i])) {
+            r_pressed |= bit;
+        }
+        if (axis_actions & bit) {
+            strengths[i] = input->get_action_strength(actions[i]);
+        }
+        if (vector_actions & bit) {
+            raw_strengths[i] = input->get_action_raw_strength(actions[i]);
+        }
+    }
+}
+
+// A held action reads at its tick-averaged amount, or fully down on the tick it
+// was pressed (where the average undercounts); edges still come from the masks
+bool InputSnapshot::_sample_replay(bool p_physics, uint64_t p_sample, uint64_t &r_pressed) {
+    InputReplay *replay = InputReplay::get_singleton();
+    if (!replay || !replay->is_replaying()) {
+        return false;
+    }
+    InputCommand command;
+    if (p_physics) {
+        if (!replay->replay_command(p_sample, command)) return false;
+    } else {
+        command = replay->get_replayed_command();
+    }
+
+    r_pressed = command.held;
+    for (int i = 0; i < (int)actions.size(); i++) {
+        const uint64_t bit = uint64_t(1) << i;
+        float strength = 0.0f;
+        if (command.held & bit) {
+            strength = (command.pressed & bit) || command.amount[i] <= 0.0f ? 1.0f : command.amount[i];
+        }
+        strengths[i] = strength;
+        raw_strengths[i] = strength;
+    }
+    return true;
+}
+
+void InputSnapshot::_sample(State &r_state, uint64_t p_sample) {
+    if (r_state.sample == p_sample || actions.empty()) {
+        return;
+    }
+    PROFILE_ZONE("InputSnapshot::_sample");
+
+    uint64_t pressed = 0;
+    if (!_sample_replay(&r_state == &physics_state, p_sample, pressed)) {
+        _sample_input(pressed);
+    }
+
+    const uint64_t previous = r_state.pressed;
+    r_state.pressed = pressed;
+    r_state.just_pressed = pressed & ~previous;
+    r_state.just_released = previous & ~pressed;
+    r_state.sample = p_sample;
+
+    for (int i = 0; i < (int)axes.size(); i++) {
+        r_state.axes[i] = strengths[axes[i].positive] - strengths[axes[i].negative];
+    }
+
+    // Same shaping as Input.get_vector
+    for (int i = 0; i < (int)vectors.size(); i++) {
+        const VectorAxes &axes_of = vectors[i];
+        Vector2 vector(raw_strengths[axes_of.positive_x] - raw_strengths[axes_of.negative_x],
+                raw_strengths[axes_of.positive_y] - raw_strengths[axes_of.negative_y]);
+        const float length = vector.length();
+        if (length <= axes_of.deadzone) {
+            vector = Vector2();
+        } else if (length > 1.0f) {
+            vector /= length;
+        } else {
+            vector *= Math::inverse_lerp(axes_of.deadzone, 1.0f, length) / length;
+        }
+        r_state.vectors[i] = vector;
+    }
+}
+
+void InputSnapshot::_sample_frame() {
+    _sample(frame_state, Engine::get_singleton()->get_process_frames());
+}
+
+void InputSnapshot::_sample_physics() {
+    _sample(physics_state, Engine::get_singleton()->get_physics_frames());
+}
+
+bool InputSnapshot::is_pressed(const StringName &p_action) const {
+    return is_pressed_index(get_action_index(p_action));
+}
+
+bool InputSnapshot::is_just_pressed(const StringName &p_action) const {
+    return is_just_pressed_index(get_action_index(p_action));
+}
+
+bool InputSnapshot::is_just_released(const StringName &p_action) const {
+    return is_just_released_index(get_action_index(p_action));
+}
+
+float InputSnapshot::get_axis(int p_axis) const {
+    ERR_FAIL_INDEX_V(p_axis, (int)axes.size(), 0.0f);
+    return _current().axes[p_axis];
+}
+
+Vector2 InputSnapshot::get_vector(int p_vector) const {
+    ERR_FAIL_INDEX_V(p_vector, (int)vectors.size(), Vector2());
+    return _current().vectors[p_vector];
+}
+
+int64_t InputSnapshot::get_pressed_mask() const {
+    return (int64_t)_current().pressed;
+}
+
+int64_t InputSnapshot::get_just_pressed_mask() const {
+    return (int64_t)_current().just_pressed;
+}
+
+int64_t InputSnapshot::get_just_released_mask() const {
+    return (int64_t)_current().just_released;
+}
@@ -0,0 +1,118 @@
+#ifndef INPUT_SNAPSHOT_H
+#define INPUT_SNAPSHOT_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+// Action state sampled once per frame and once per physics tick, for every
+// input-driven node to share. Actions are registered up front and get a bit
+// index; each sample polls Input once per registered action with a cached
+// StringName and packs the results into pressed / just-pressed /
+// just-released masks, plus the registered axes (negative/positive action
+// pairs) and vectors (two axes with Input.get_vector's circular deadzone).
+//
+// Reads return the physics-tick sample while Engine.is_in_physics_frame() and
+// the frame sample otherwise, so _process and _physics_process code each see
+// edges relative to their own previous sample, as with Input.is_action_just_pressed.
+// While InputReplay is replaying, samples come from the recorded commands.
+class InputSnapshot : public Object {
+    GDCLASS(InputSnapshot, Object);
+
+public:
+    static const int MAX_ACTIONS = 64;
+    static const int MAX_AXES = 16;
+    static const int MAX_VECTORS = 8;
+
+    struct State {
+        uint64_t pressed = 0;
+        uint64_t just_pressed = 0;
+        uint64_t just_released = 0;
+        float axes[MAX_AXES] = {};
+        Vector2 vectors[MAX_VECTORS];
+        uint64_t sample = 0;   // frame or physics tick it was taken on
+    };
+
+private:
+    struct Axis {
+        int negative = -1;
+        int positive = -1;
+    };
+
+    struct VectorAxes {
+        int negative_x = -1, positive_x = -1;
+        int negative_y = -1, positive_y = -1;
+        float deadzone = 0.0f;   // average of the four actions', as Input.get_vector uses
+    };
+
+    static InputSnapshot *singleton;
+
+    std::vector<StringName> actions;
+    std::vector<Axis> axes;
+    std::vector<VectorAxes> vectors;
+    uint64_t axis_actions = 0;        // actions whose strength feeds an axis
+    uint64_t vector_actions = 0;      // actions whose raw strength feeds a vector
+    float strengths[MAX_ACTIONS] = {};        // scratch for one sample
+    float raw_strengths[MAX_ACTIONS] = {};
+
+    State frame_state;
+    State physics_state;
+    bool watching_tree = false;
+
+    void _watch_tree();
+    void _sample(State &r_state, uint64_t p_sample);
+    void _sample_input(uint64_t &r_pressed);
+    bool _sample_replay(bool p_physics, uint64_t p_sample, uint64_t &r_pressed);
+    const State &_current() const;
+    static bool _bit(uint64_t p_mask, int p_action) { return (unsigned)p_action < MAX_ACTIONS && ((p_mask >> p_action) & 1); }
+
+protected:
+    static void _bind_methods();
+
+public:
+    static InputSnapshot *get_singleton();
+
+    InputSnapshot();
+    ~InputSnapshot();
+
+    // Main thread. Returns the existing index for a known action, -1 when full
+    int register_action(const StringName &p_action);
+    int register_axis(const StringName &p_negative, const StringName &p_positive);
+    int register_vector(const StringName &p_negative_x, const StringName &p_positive_x,
+            const StringName &p_negative_y, const StringName &p_positive_y);
+    int get_action_index(const StringName &p_action) const;
+    StringName get_action_name(int p_action) const;
+    int get_action_count() const;
+
+    // Native consumers read the masks directly
+    const State &get_state() const { return _current(); }
+    bool is_pressed_index(int p_action) const { return _bit(_current().pressed, p_action); }
+    bool is_just_pressed_index(int p_action) const { return _bit(_current().just_pressed, p_action); }
+    bool is_just_released_index(int p_action) const { return _bit(_current().just_released, p_action); }
+
+    // By name, for scripts; unknown actions read as released
+    bool is_pressed(const StringName &p_action) const;
+    bool is_just_pressed(const StringName &p_action) const;
+    bool is_just_released(const StringName &p_action) const;
+
+    float get_axis(int p_axis) const;
+    Vector2 get_vector(int p_vector) const;
+
+    int64_t get_pressed_mask() const;
+    int64_t get_just_pressed_mask() const;
+    int64_t get_just_released_mask() const;
+
+    // Connected to SceneTree.process_frame / physics_frame
+    void _sample_frame();
+    void _sample_physics();
+};
+
+} // namespace godot
+
+#endif // INPUT_SNAPSHOT_H
@@ -1,11 +1,16 @@
 #include "keyinput.h"
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/input.hpp>
 #include <godot_cpp/classes/node2d.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
 #include <godot_cpp/classes/viewport.hpp>
 
+#include "input_buffer.h"
+#include "input_latency.h"
+#include "input_snapshot.h"
+
 using namespace godot;
 
 void KeyInput::_bind_methods() {
@@ -31,21 +36,39 @@ void KeyInput::set_speed(const double p_speed) {
     speed = p_speed;
 }
 
+void KeyInput::_ready() {
+    // Resolve the actions once; the snapshot polls them for everyone each frame
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    if (snapshot && !Engine::get_singleton()->is_editor_hint()) {
+        action_left = snapshot->register_action("ui_left");
+        action_right = snapshot->register_action("ui_right");
+
+        // Only so key presses get stamped for InputLatency; movement still reads the snapshot
+        if (InputBuffer::get_singleton()) {
+            InputBuffer::get_singleton()->listen();
+        }
+    }
+}
+
 // Called every frame by Godot
 void KeyInput::_process(double delta) {
-    Input* input = Input::get_singleton();
+    InputSnapshot *snapshot = InputSnapshot::get_singleton();
+    if (!snapshot) return;
     Vector2 dir(0, 0);
 
     // Move left/right using custom actions or raw checks
-    if (input->is_action_pressed("ui_left")) {
+    if (snapshot->is_pressed_index(action_left)) {
         dir.x -= 1;
     }
-    if (input->is_action_pressed("ui_right")) {
+    if (snapshot->is_pressed_index(action_right)) {
         dir.x += 1;
     }
 
     // Move the player
     translate(dir.normalized() * speed * delta);
+    if (InputLatency::get_singleton()) {
+        latency_moving = InputLatency::get_singleton()->mark_movement(latency_moving, dir.length());
+    }
 
     // Optional: clamp to screen & fix at bottom
     if (auto viewport = get_viewport()) {
@@ -11,6 +11,9 @@ namespace godot{
 
 	private:
 		double speed;
+		int action_left = -1;	// InputSnapshot indices
+		int action_right = -1;
+		bool latency_moving = false;	// for InputLatency::mark_movement
 
 	protected:
 		static void _bind_methods();
@@ -19,6 +22,7 @@ namespace godot{
 		KeyInput();
 		~KeyInput();
 
+		void _ready() override;
 		void _process(double delta) override;
 		void move(Vector2 direction);
 
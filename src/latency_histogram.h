@@ -0,0 +1,57 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace godot {
+
+// Fixed-bucket latency histogram: 100 us buckets up to 250 ms plus one
+// overflow bucket. Adding is O(1) and percentiles walk the buckets, so it can
+// take samples forever without growing; percentiles are accurate to a bucket.
+class LatencyHistogram {
+public:
+    static const uint32_t BUCKET_USEC = 100;
+    static const uint32_t BUCKET_COUNT = 2500;
+
+    void add(uint64_t p_usec) {
+        const uint64_t bucket = p_usec / BUCKET_USEC;
+        buckets[bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT]++;
+        count++;
+        if (p_usec > max_usec) max_usec = p_usec;
+    }
+
+    void clear() {
+        memset(buckets, 0, sizeof(buckets));
+        count = 0;
+        max_usec = 0;
+    }
+
+    uint64_t get_count() const { return count; }
+    uint64_t get_max_usec() const { return max_usec; }
+
+    // Upper edge of the bucket holding the p-th percentile (0-100), 0 when empty.
+    // Overflowed samples report the largest one seen.
+    uint64_t percentile_usec(double p_percentile) const {
+        if (count == 0) return 0;
+        uint64_t rank = (uint64_t)(p_percentile / 100.0 * (double)count + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > count) rank = count;
+
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += buckets[i];
+            if (seen >= rank) return (uint64_t)(i + 1) * BUCKET_USEC;
+        }
+        return max_usec;
+    }
+
+private:
+    uint32_t buckets[BUCKET_COUNT + 1] = {};
+    uint64_t count = 0;
+    uint64_t max_usec = 0;
+};
+
+} // namespace godot
+
+#endif // LATENCY_HISTOGRAM_H
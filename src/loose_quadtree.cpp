@@ -0,0 +1,194 @@
+#include "loose_quadtree.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+LooseQuadtree::LooseQuadtree(float p_half_extent) {
+    QuadNode root;
+    root.half = std::max(p_half_extent, 1.0f);
+    nodes.push_back(root);
+    node_parent.push_back(-1);
+}
+
+void LooseQuadtree::clear() {
+    float half = nodes[0].half;
+    nodes.clear();
+    node_parent.clear();
+    items.clear();
+    free_items.clear();
+    item_count = 0;
+
+    QuadNode root;
+    root.half = half;
+    nodes.push_back(root);
+    node_parent.push_back(-1);
+}
+
+// Walk down while the item still fits a child cell; create children on demand
+int LooseQuadtree::_find_node(const Box &p_box) {
+    float cx = (p_box.min_x + p_box.max_x) * 0.5f;
+    float cy = (p_box.min_y + p_box.max_y) * 0.5f;
+    float extent = std::max(p_box.max_x - p_box.min_x, p_box.max_y - p_box.min_y) * 0.5f;
+
+    int node = 0;
+    for (int depth = 0; depth < MAX_DEPTH; depth++) {
+        float child_half = nodes[node].half * 0.5f;
+        if (extent > child_half) break;
+
+        int quadrant = (cx >= nodes[node].cx ? 1 : 0) | (cy >= nodes[node].cy ? 2 : 0);
+        int child = nodes[node].children[quadrant];
+        if (child < 0) {
+            QuadNode created;
+            created.half = child_half;
+            created.depth = depth + 1;
+            created.cx = nodes[node].cx + ((quadrant & 1) ? child_half : -child_half);
+            created.cy = nodes[node].cy + ((quadrant & 2) ? child_half : -child_half);
+            child = (int)nodes.size();
+            nodes.push_back(created);
+            node_parent.push_back(node);
+            nodes[node].children[quadrant] = child;
+        }
+        node = child;
+    }
+    return node;
+}
+
+void LooseQuadtree::_attach(int p_handle, int p_node) {
+    Item &item = items[p_handle];
+    item.node = p_node;
+    item.slot = (int)nodes[p_node].items.size();
+    nodes[p_node].items.push_back(p_handle);
+    for (int n = p_node; n >= 0; n = node_parent[n]) {
+        nodes[n].subtree_items++;
+    }
+}
+
+// Swap-remove from the owning node's list
+void LooseQuadtree::_detach(int p_handle) {
+    Item &item = items[p_handle];
+    std::vector<int> &list = nodes[item.node].items;
+    int moved = list.back();
+    list[item.slot] = moved;
+    items[moved].slot = item.slot;
+    list.pop_back();
+    for (int n = item.node; n >= 0; n = node_parent[n]) {
+        nodes[n].subtree_items--;
+    }
+    item.node = -1;
+    item.slot = -1;
+}
+
+// Double the root until the box center is inside it, then reinsert everything.
+// Only happens when objects leave the world bounds, so a full rebuild is fine.
+void LooseQuadtree::_grow_to_fit(const Box &p_box) {
+    float cx = (p_box.min_x + p_box.max_x) * 0.5f;
+    float cy = (p_box.min_y + p_box.max_y) * 0.5f;
+    float half = nodes[0].half;
+    if (cx >= -half && cx < half && cy >= -half && cy < half) return;
+
+    while (!(cx >= -half && cx < half && cy >= -half && cy < half)) {
+        half *= 2.0f;
+    }
+
+    nodes.clear();
+    node_parent.clear();
+    QuadNode root;
+    root.half = half;
+    nodes.push_back(root);
+    node_parent.push_back(-1);
+
+    for (int h = 0; h < (int)items.size(); h++) {
+        if (items[h].node < 0) continue;
+        items[h].node = -1;
+        _attach(h, _find_node(items[h].box));
+    }
+}
+
+bool LooseQuadtree::_is_finite(const Box &p_box) {
+    return std::isfinite(p_box.min_x) && std::isfinite(p_box.min_y) && std::isfinite(p_box.max_x) &&
+            std::isfinite(p_box.max_y);
+}
+
+int LooseQuadtree::insert(const Box &p_box, int p_user) {
+    if (!_is_finite(p_box)) return -1;
+
+    int handle;
+    if (!free_items.empty()) {
+        handle = free_items.back();
+        free_items.pop_back();
+    } else {
+        handle = (int)items.size();
+        items.push_back(Item());
+    }
+
+    // Keep the slot marked free until attached so a rebuild skips it
+    items[handle].box = p_box;
+    items[handle].user = p_user;
+    items[handle].node = -1;
+    _grow_to_fit(p_box);
+    _attach(handle, _find_node(p_box));
+    item_count++;
+    return handle;
+}
+
+bool LooseQuadtree::update(int p_handle, const Box &p_box) {
+    if (!_is_finite(p_box)) return false;
+
+    Item &item = items[p_handle];
+    item.box = p_box;
+
+    // Still inside the same cell and not too large or small for it: nothing to move
+    const QuadNode &node = nodes[item.node];
+    float cx = (p_box.min_x + p_box.max_x) * 0.5f;
+    float cy = (p_box.min_y + p_box.max_y) * 0.5f;
+    float extent = std::max(p_box.max_x - p_box.min_x, p_box.max_y - p_box.min_y) * 0.5f;
+    bool inside = cx >= node.cx - node.half && cx < node.cx + node.half &&
+                  cy >= node.cy - node.half && cy < node.cy + node.half;
+    bool deepest = node.depth == MAX_DEPTH || extent > node.half * 0.5f;
+    if (inside && (extent <= node.half || item.node == 0) && deepest) return true;
+
+    _detach(p_handle);
+    _grow_to_fit(p_box);
+    _attach(p_handle, _find_node(p_box));
+    return true;
+}
+
+void LooseQuadtree::remove(int p_handle) {
+    if (p_handle < 0 || p_handle >= (int)items.size() || items[p_handle].node < 0) return;
+    _detach(p_handle);
+    items[p_handle].user = -1;
+    free_items.push_back(p_handle);
+    item_count--;
+}
+
+void LooseQuadtree::query(const Box &p_box, std::vector<int> &r_users) const {
+    _query(0, p_box, r_users);
+}
+
+void LooseQuadtree::_query(int p_node, const Box &p_box, std::vector<int> &r_users) const {
+    const QuadNode &node = nodes[p_node];
+    if (node.subtree_items == 0) return;
+
+    // Loose bounds: the cell grown by half its size on each side.
+    // The root also holds items larger than itself, so it is never rejected.
+    float loose = node.half * 2.0f;
+    if (p_node != 0 &&
+        (p_box.max_x < node.cx - loose || p_box.min_x > node.cx + loose ||
+         p_box.max_y < node.cy - loose || p_box.min_y > node.cy + loose)) {
+        return;
+    }
+
+    for (int handle : node.items) {
+        const Box &b = items[handle].box;
+        if (b.max_x >= p_box.min_x && b.min_x <= p_box.max_x &&
+            b.max_y >= p_box.min_y && b.min_y <= p_box.max_y) {
+            r_users.push_back(items[handle].user);
+        }
+    }
+
+    for (int c = 0; c < 4; c++) {
+        if (node.children[c] >= 0) _query(node.children[c], p_box, r_users);
+    }
+}
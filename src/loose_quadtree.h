@@ -0,0 +1,72 @@
+#ifndef LOOSE_QUADTREE_H
+#define LOOSE_QUADTREE_H
+
+#include <vector>
+
+namespace godot {
+
+// Loose quadtree over axis-aligned boxes, independent of the engine types.
+// Each item lives in exactly one node: the deepest one whose cell is at least as
+// large as the item and contains the item's center. A node's loose bounds are its
+// cell grown by half a cell on every side, so an item never straddles nodes and
+// moving it a little usually only rewrites its box.
+class LooseQuadtree {
+public:
+    struct Box {
+        float min_x = 0.0f, min_y = 0.0f;
+        float max_x = 0.0f, max_y = 0.0f;
+    };
+
+    static const int MAX_DEPTH = 10;
+
+    // p_half_extent is the initial half size of the root cell (centered on the origin).
+    // The root grows automatically when an item falls outside it.
+    explicit LooseQuadtree(float p_half_extent = 4096.0f);
+
+    // Returns a handle that stays valid until remove(), or -1 for a box with a
+    // NaN or infinite coordinate (the root could never grow to hold it)
+    int insert(const Box &p_box, int p_user);
+    // False, keeping the old box, when p_box is not finite
+    bool update(int p_handle, const Box &p_box);
+    void remove(int p_handle);
+    void set_user(int p_handle, int p_user) { items[p_handle].user = p_user; }
+    void clear();
+
+    // Appends the user value of every item whose box overlaps p_box
+    void query(const Box &p_box, std::vector<int> &r_users) const;
+
+    int size() const { return item_count; }
+
+private:
+    struct Item {
+        Box box;
+        int user = -1;
+        int node = -1;   // -1 when the slot is free
+        int slot = -1;   // index into the node's item list
+    };
+
+    struct QuadNode {
+        float cx = 0.0f, cy = 0.0f, half = 0.0f;  // strict cell
+        int depth = 0;
+        int children[4] = { -1, -1, -1, -1 };
+        std::vector<int> items;                   // item handles
+        int subtree_items = 0;                    // items in this node and below
+    };
+
+    int _find_node(const Box &p_box);
+    void _attach(int p_handle, int p_node);
+    void _detach(int p_handle);
+    void _grow_to_fit(const Box &p_box);
+    static bool _is_finite(const Box &p_box);
+    void _query(int p_node, const Box &p_box, std::vector<int> &r_users) const;
+
+    std::vector<QuadNode> nodes;    // nodes[0] is the root
+    std::vector<int> node_parent;
+    std::vector<Item> items;
+    std::vector<int> free_items;
+    int item_count = 0;
+};
+
+} // namespace godot
+
+#endif // LOOSE_QUADTREE_H
@@ -5,8 +5,13 @@
 #include <godot_cpp/classes/rigid_body2d.hpp>
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/physics_direct_body_state2d.hpp>
+#include <godot_cpp/classes/physics_server2d.hpp>
+#include <godot_cpp/classes/collision_object2d.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include "native_stats.h"
+#include "profile_zone.h"
+
 using namespace godot;
 
 // Registers class methods and properties in Godot
@@ -37,6 +42,12 @@ void MagneticOrbit::_bind_methods() {
     ClassDB::bind_method(D_METHOD("set_swirl_factor", "val"), &MagneticOrbit::set_swirl_factor);
     ClassDB::bind_method(D_METHOD("get_swirl_factor"), &MagneticOrbit::get_swirl_factor);
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "swirl_factor"), "set_swirl_factor", "get_swirl_factor");
+
+    // Target cache management
+    ClassDB::bind_method(D_METHOD("refresh_targets"), &MagneticOrbit::refresh_targets);
+    ClassDB::bind_method(D_METHOD("_on_player_tree_exiting"), &MagneticOrbit::_on_player_tree_exiting);
+    ClassDB::bind_method(D_METHOD("_on_orbit_object_tree_exiting"), &MagneticOrbit::_on_orbit_object_tree_exiting);
+    ClassDB::bind_method(D_METHOD("_on_target_tree_entered"), &MagneticOrbit::_on_target_tree_entered);
 }
 
 // Constructor: Initializes default values
@@ -55,6 +66,10 @@ MagneticOrbit::~MagneticOrbit() {
 // Setters and getters for player node path
 void MagneticOrbit::set_player_path(const NodePath &p_path) {
     player_path = p_path;
+    // Scene loading sets the path before the siblings exist; _ready resolves it then
+    if (is_node_ready() && is_inside_tree()) {
+        _resolve_player();
+    }
 }
 NodePath MagneticOrbit::get_player_path() const {
     return player_path;
@@ -63,6 +78,9 @@ NodePath MagneticOrbit::get_player_path() const {
 // Setters and getters for orbit object node path
 void MagneticOrbit::set_orbit_object_path(const NodePath &p_path) {
     orbit_object_path = p_path;
+    if (is_node_ready() && is_inside_tree()) {
+        _resolve_orbit_object();
+    }
 }
 NodePath MagneticOrbit::get_orbit_object_path() const {
     return orbit_object_path;
@@ -97,76 +115,175 @@ float MagneticOrbit::get_swirl_factor() const {
     return swirl_factor;
 }
 
-// Overriding _integrate_forces to apply magnetic force in physics step
-void MagneticOrbit::_integrate_forces(PhysicsDirectBodyState2D *state) {
-    // Step 1: Resolve the player node reference if it's not already found
-    if (!player && !player_path.is_empty()) {
-        Node *maybe_player = get_node<Node>(player_path);
-        if (maybe_player) {
-            player = Object::cast_to<CharacterBody2D>(maybe_player);
-            if (!player) {
-                UtilityFunctions::print("MagneticOrbit: 'player_path' node is not a CharacterBody2D!");
-            }
+OrbitParams MagneticOrbit::get_orbit_params() const {
+    OrbitParams params;
+    params.max_distance   = max_distance;
+    params.orbit_distance = orbit_distance;
+    params.magnetic_force = magnetic_force;
+    params.swirl_factor   = swirl_factor;
+    return params;
+}
+
+// Resolve the targets once the sibling nodes exist
+void MagneticOrbit::_ready() {
+    add_to_group(GROUP_NAME);
+    refresh_targets();
+}
+
+// Re-added after a remove_child: _ready doesn't run again, so resolve here
+void MagneticOrbit::_enter_tree() {
+    if (is_node_ready()) {
+        refresh_targets();
+    }
+}
+
+// Paths are relative to this node, so the cache means nothing outside the tree
+void MagneticOrbit::_exit_tree() {
+    _release_player();
+    _release_orbit_object();
+}
+
+void MagneticOrbit::refresh_targets() {
+    _resolve_player();
+    _resolve_orbit_object();
+}
+
+// Look up player_path once and cache its ObjectID + physics RID
+void MagneticOrbit::_resolve_player() {
+    _release_player();
+    if (player_path.is_empty()) {
+        return;
+    }
+
+    Node *node = get_node_or_null(player_path);
+    CollisionObject2D *body = Object::cast_to<CollisionObject2D>(node);
+    if (!body) {
+        // A missing node may still turn up; refresh_targets picks it up then
+        if (node) {
+            UtilityFunctions::print("MagneticOrbit: 'player_path' node is not a physics body!");
         }
+        return;
     }
 
-    // Step 2: Resolve the orbit object reference if applicable
-    if (!orbit_object && !orbit_object_path.is_empty()) {
-        Node *maybe_orbit = get_node<Node>(orbit_object_path);
-        if (maybe_orbit) {
-            orbit_object = Object::cast_to<RigidBody2D>(maybe_orbit);
-            if (!orbit_object) {
-                UtilityFunctions::print("MagneticOrbit: 'orbit_object_path' is not RigidBody2D!");
-            }
+    player_id = ObjectID(body->get_instance_id());
+    player_rid = body->get_rid();
+    body->connect("tree_exiting", Callable(this, "_on_player_tree_exiting"));
+}
+
+// Look up orbit_object_path once and cache its ObjectID + physics RID
+void MagneticOrbit::_resolve_orbit_object() {
+    _release_orbit_object();
+    if (orbit_object_path.is_empty()) {
+        return;
+    }
+
+    Node *node = get_node_or_null(orbit_object_path);
+    RigidBody2D *body = Object::cast_to<RigidBody2D>(node);
+    if (!body) {
+        if (node) {
+            UtilityFunctions::print("MagneticOrbit: 'orbit_object_path' is not RigidBody2D!");
         }
+        return;
     }
 
-    // If there's no valid player node, we cannot compute forces, so exit early
-    if (!player) {
+    orbit_object_id = ObjectID(body->get_instance_id());
+    orbit_object_rid = body->get_rid();
+    body->connect("tree_exiting", Callable(this, "_on_orbit_object_tree_exiting"));
+}
+
+// Drop the cached player, disconnecting from it if it is still alive
+void MagneticOrbit::_release_player() {
+    Object *obj = player_id.is_valid() ? ObjectDB::get_instance(player_id) : nullptr;
+    Callable cb(this, "_on_player_tree_exiting");
+    if (obj && obj->is_connected("tree_exiting", cb)) {
+        obj->disconnect("tree_exiting", cb);
+    }
+    player_id = ObjectID();
+    player_rid = RID();
+}
+
+// Drop the cached orbit object, disconnecting from it if it is still alive
+void MagneticOrbit::_release_orbit_object() {
+    Object *obj = orbit_object_id.is_valid() ? ObjectDB::get_instance(orbit_object_id) : nullptr;
+    Callable cb(this, "_on_orbit_object_tree_exiting");
+    if (obj && obj->is_connected("tree_exiting", cb)) {
+        obj->disconnect("tree_exiting", cb);
+    }
+    orbit_object_id = ObjectID();
+    orbit_object_rid = RID();
+}
+
+void MagneticOrbit::_on_player_tree_exiting() {
+    const ObjectID target = player_id;
+    _release_player();
+    _wait_for_return(target);
+}
+
+void MagneticOrbit::_on_orbit_object_tree_exiting() {
+    const ObjectID target = orbit_object_id;
+    _release_orbit_object();
+    _wait_for_return(target);
+}
+
+// A target that is only being moved (remove_child / add_child) comes back; a
+// freed one takes the connection with it
+void MagneticOrbit::_wait_for_return(const ObjectID &p_target) {
+    Object *obj = p_target.is_valid() ? ObjectDB::get_instance(p_target) : nullptr;
+    Callable cb(this, "_on_target_tree_entered");
+    if (obj && !obj->is_connected("tree_entered", cb)) {
+        obj->connect("tree_entered", cb, CONNECT_ONE_SHOT | CONNECT_DEFERRED);
+    }
+}
+
+void MagneticOrbit::_on_target_tree_entered() {
+    if (is_inside_tree()) {
+        refresh_targets();
+    }
+}
+
+// Overriding _integrate_forces to apply magnetic force in physics step.
+// Targets are only touched through their cached RIDs, never through Node calls.
+void MagneticOrbit::_integrate_forces(PhysicsDirectBodyState2D *state) {
+    PROFILE_ZONE("MagneticOrbit::_integrate_forces");
+
+    // If there's no valid player body, we cannot compute forces, so exit early
+    if (!player_rid.is_valid()) {
         last_force = Vector2(0,0);
         return;
     }
 
+    PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
     // Get the positions of the player and orbiting object
-    Vector2 player_pos = player->get_global_position();
+    Transform2D player_xf = ps->body_get_state(player_rid, PhysicsServer2D::BODY_STATE_TRANSFORM);
+    Vector2 player_pos = player_xf.get_origin();
     Vector2 orbit_pos;
 
     // Determine whether to use a separate orbit object or this node
-    if (orbit_object) {
-        orbit_pos = orbit_object->get_global_position();
+    bool use_orbit_object = orbit_object_rid.is_valid();
+    if (use_orbit_object) {
+        Transform2D orbit_xf = ps->body_get_state(orbit_object_rid, PhysicsServer2D::BODY_STATE_TRANSFORM);
+        orbit_pos = orbit_xf.get_origin();
     } else {
         orbit_pos = state->get_transform().get_origin();
     }
 
-    // Compute direction vector from orbit object to player
+    // Compute the magnetic + swirl force pulling the orbit object toward the player
     Vector2 dir = player_pos - orbit_pos;
-    float dist = dir.length(); // Distance between objects
-
-    // If distance is too small or exceeds max range, apply no force
-    if (dist <= 0.001f || dist > max_distance) {
+    float fx, fy;
+    if (!compute_orbit_force(dir.x, dir.y, get_orbit_params(), fx, fy)) {
         last_force = Vector2(0,0);
         return;
     }
 
-    // Compute radial magnetic force: follows an inverse square law (F ∝ 1/d²)
-    float force_mag = magnetic_force / (dist * dist);
-    Vector2 radial_force = dir.normalized() * force_mag;
-
-    // Compute tangential (swirl) force if within orbit distance
-    Vector2 tangential_force(0,0);
-    if (dist < orbit_distance) {
-        Vector2 tangent = Vector2(-dir.y, dir.x).normalized(); // Perpendicular vector
-        tangential_force = tangent * (force_mag * swirl_factor);
-    }
-
-    // Sum up radial and tangential forces
-    Vector2 total_force = radial_force + tangential_force;
+    Vector2 total_force(fx, fy);
     last_force = total_force; // Store for debugging
+    NativeStats::add(NativeStats::ORBIT_BODIES);
 
-    // Step 3: Apply force
-    if (orbit_object) {
-        // Apply force to the separate orbit object (RigidBody2D)
-        orbit_object->apply_central_impulse(total_force);
+    // Apply force
+    if (use_orbit_object) {
+        // Apply force to the separate orbit object straight through the physics server
+        ps->body_apply_central_impulse(orbit_object_rid, total_force);
     } else {
         // Apply force directly to this object
         state->apply_central_impulse(total_force);
@@ -6,6 +6,10 @@
 #include <godot_cpp/core/binder_common.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 #include <godot_cpp/classes/physics_direct_body_state2d.hpp>
+#include <godot_cpp/core/object_id.hpp>
+#include <godot_cpp/variant/rid.hpp>
+
+#include "orbit_force.h"
 
 namespace godot {
 
@@ -24,9 +28,14 @@ private:
     NodePath player_path;
     NodePath orbit_object_path;
 
-    // pointers once resolved
-    CharacterBody2D *player = nullptr;
-    RigidBody2D *orbit_object = nullptr;
+    // Targets resolved once (on ready / path change) into an ObjectID plus the
+    // physics body RID. Both are cleared when the target leaves the tree, so the
+    // physics callback never touches a freed node, and resolved again when it
+    // (or this node) comes back.
+    ObjectID player_id;
+    ObjectID orbit_object_id;
+    RID player_rid;
+    RID orbit_object_rid;
 
     // custom magnet / orbit params
     float max_distance   = 300.0f;
@@ -38,6 +47,9 @@ private:
     Vector2 last_force = Vector2(0,0);
 
 public:
+    // Every MagneticOrbit joins this group so tools can find them cheaply
+    static constexpr const char *GROUP_NAME = "MagneticOrbit";
+
     MagneticOrbit();
     ~MagneticOrbit();
 
@@ -61,10 +73,35 @@ public:
     void set_swirl_factor(float val);
     float get_swirl_factor() const;
 
+    OrbitParams get_orbit_params() const;
+
+    void _ready() override;
+    void _enter_tree() override;
+    void _exit_tree() override;
     virtual void _integrate_forces(PhysicsDirectBodyState2D *state) override;
 
+    // Re-resolve player/orbit object paths (e.g. after a target re-entered the tree)
+    void refresh_targets();
+
     // Debug getter
     Vector2 get_last_force() const { return last_force; }
+
+    // Cached physics bodies (invalid RID when unresolved)
+    RID get_player_rid() const { return player_rid; }
+    RID get_orbit_object_rid() const { return orbit_object_rid; }
+
+private:
+    void _resolve_player();
+    void _resolve_orbit_object();
+    void _release_player();
+    void _release_orbit_object();
+
+    // "tree_exiting" handlers of the resolved targets
+    void _on_player_tree_exiting();
+    void _on_orbit_object_tree_exiting();
+    // One-shot "tree_entered" of a target that left, to pick it up again
+    void _on_target_tree_entered();
+    void _wait_for_return(const ObjectID &p_target);
 };
 
 } // namespace godot
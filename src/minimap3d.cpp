@@ -4,6 +4,11 @@
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
 
+#include "frame_arena.h"
+#include "native_stats.h"
+#include "profile_zone.h"
+#include "minimap_core.h"
+
 using namespace godot;
 
 /* ------------ binding ------------ */
@@ -107,6 +112,8 @@ void MiniMap3D::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "glow_size",
                              PROPERTY_HINT_RANGE, "1,10,0.1,or_greater"),
     "set_glow_size", "get_glow_size");
+
+    ClassDB::bind_method(D_METHOD("_on_tree_changed", "node"), &MiniMap3D::_on_tree_changed);
 }
 
 
@@ -142,14 +149,28 @@ void MiniMap3D::_ready() {
     if (player_color == Color()) player_color = Color(0.2,0.5,1,1);
     if (enemy_color  == Color()) enemy_color  = Color(1,0.2,0.2,1);
     if (enemy_group.is_empty())  enemy_group  = "Enemy";
+
+    diamond_outline.resize(4);
+    diamond_fill.resize(4);
     
     // Print debug information when running in game mode
     if (!Engine::get_singleton()->is_editor_hint()) {
+        // Group membership can only change the cached enemy list when nodes come and go
+        SceneTree *tree = get_tree();
+        if (!tree->is_connected("node_added", Callable(this, "_on_tree_changed"))) {
+            tree->connect("node_added", Callable(this, "_on_tree_changed"));
+            tree->connect("node_removed", Callable(this, "_on_tree_changed"));
+        }
+
         // Delayed initialization to allow enemy nodes to register first
         call_deferred("_debug_enemy_groups");
     }
 }
 
+void MiniMap3D::_on_tree_changed(Node *node) {
+    enemies_dirty = true;
+}
+
 void MiniMap3D::_notification(int what) {
     if (what == NOTIFICATION_RESIZED && mini_vp) {
         mini_vp->set("size", Vector2i(get_size()));
@@ -190,6 +211,7 @@ void MiniMap3D::_process(double) {
 }
 
 void MiniMap3D::_draw() {
+    PROFILE_ZONE("MiniMap3D::_draw");
     if (!cam) return;
 
     // Get player
@@ -234,12 +256,18 @@ void MiniMap3D::_draw() {
     // Draw player at center
     draw_circle(center, dot_radius * 1.2f, Color(1, 1, 1, 0.5)); // White outline
     draw_circle(center, dot_radius, player_color);
+
+    // Background, grid, axes, axis labels and player so far
+    int canvas_commands = 1 + 22 + 2 + 2 + 2;
     
     // Scale for converting world distances to minimap distances
     float scale = viewport_size.x / (ortho_size );
     
     // Get all enemies in the Enemy group
-    Array enemies = get_tree()->get_nodes_in_group(enemy_group);
+    if (enemies_dirty || get_tree()->get_frame() % ENEMY_REFRESH_FRAMES == 0) {
+        enemies = get_tree()->get_nodes_in_group(enemy_group);
+        enemies_dirty = false;
+    }
     
     // Debug enemy count periodically
     if (get_tree()->get_frame() % 60 == 0) {
@@ -256,97 +284,123 @@ void MiniMap3D::_draw() {
         }
     }
     
-    // Draw each enemy
-    for (int i = 0; i < enemies.size(); ++i) {
+    // Gather enemy positions, then project and cull them in one pass.
+    // The scratch arrays live in the frame arena and are dropped with the frame.
+    int enemy_count = (int)enemies.size();
+    FrameArena &arena = FrameArena::frame(Engine::get_singleton()->get_process_frames());
+    FrameAllocator<float> floats(arena);
+    FrameAllocator<int> ints(arena);
+    FrameVector<float> marker_world_x(enemy_count, 0.0f, floats);
+    FrameVector<float> marker_world_z(enemy_count, 0.0f, floats);
+    FrameVector<int>   marker_source(enemy_count, 0, ints);   // index in the enemy group
+    FrameVector<int>   marker_visible(enemy_count, 0, ints);
+    FrameVector<float> marker_map_x(enemy_count, 0.0f, floats);
+    FrameVector<float> marker_map_y(enemy_count, 0.0f, floats);
+
+    const StringName group(enemy_group);
+    int gathered = 0;
+    for (int i = 0; i < enemy_count; ++i) {
         Node3D* enemy = Object::cast_to<Node3D>(enemies[i]);
         if (!enemy) continue;
-        
-        // Get enemy position
-        Vector3 enemy_pos = enemy->get_global_position();
-        
-        // Calculate offset from player (in world coordinates)
-        Vector3 enemy_offset = enemy_pos - player_pos;
-        
+        if (!enemy->is_in_group(group)) {
+            // Left the group while staying in the tree
+            enemies_dirty = true;
+            continue;
+        }
+
         // Map world coordinates to minimap:
         // - X (left/right) maps to minimap X
         // - Z (forward/backward) maps to minimap Y
         // - Y (up/down) is ignored for 2D representation
-        Vector2 enemy_minimap_offset = Vector2(enemy_offset.x, enemy_offset.z) * scale;
-        
-        // Position on minimap (player at center + offset)
-        Vector2 enemy_minimap_pos = center + enemy_minimap_offset;
+        Vector3 enemy_pos = enemy->get_global_position();
+        marker_world_x[gathered] = enemy_pos.x;
+        marker_world_z[gathered] = enemy_pos.z;
+        marker_source[gathered] = i; // group index picks the marker shape below
+        gathered++;
+    }
+
+    MinimapProjection projection;
+    projection.player_x = player_pos.x;
+    projection.player_z = player_pos.z;
+    projection.scale = scale;
+    projection.center_x = center.x;
+    projection.center_y = center.y;
+    projection.width = viewport_size.x;
+    projection.height = viewport_size.y;
+
+    int visible = minimap_cull_markers(projection, marker_world_x.data(), marker_world_z.data(), gathered,
+            marker_visible.data(), marker_map_x.data(), marker_map_y.data());
+
+    // Draw each enemy inside the minimap
+    int markers_drawn = 0;
+    for (int v = 0; v < visible; ++v) {
+        int i = marker_source[marker_visible[v]];
+        Vector2 enemy_minimap_pos(marker_map_x[v], marker_map_y[v]);
+
+        markers_drawn++;
+        canvas_commands += enemy_glow ? 5 : 3; // link line, optional glow, outline + fill
+
+        // Draw line connecting player to enemy for better visualization
+        draw_line(center, enemy_minimap_pos, Color(0.5, 0.5, 0.5, 0.3), 1.0);
         
-        // Debug enemy positions periodically
-        if (get_tree()->get_frame() % 120 == 0) {
-            //UtilityFunctions::print("Enemy ", i, ": ", enemy->get_name(), " at position (", 
-            //                enemy_pos.x, " (left/right), ", enemy_pos.y, " (up/down), ", enemy_pos.z, " (forward/backward))");
-            //UtilityFunctions::print("  Offset from player: X=", enemy_offset.x, " (left/right), Z=", enemy_offset.z, " (forward/backward)");
-            //UtilityFunctions::print("  Minimap position: (", enemy_minimap_pos.x, ", ", enemy_minimap_pos.y, ")");
+        // Draw glow effect
+        if (enemy_glow) {
+            Color glow_color = enemy_color;
+            glow_color.a = 0.3f;
+            draw_circle(enemy_minimap_pos, enemy_dot_radius * glow_size, glow_color);
+            
+            glow_color.a = 0.5f;
+            draw_circle(enemy_minimap_pos, enemy_dot_radius * (glow_size * 0.7f), glow_color);
         }
         
-        // Check if in viewport bounds
-        if (enemy_minimap_pos.x >= 0 && enemy_minimap_pos.x <= viewport_size.x && 
-            enemy_minimap_pos.y >= 0 && enemy_minimap_pos.y <= viewport_size.y) {
-            
-            // Draw line connecting player to enemy for better visualization
-            draw_line(center, enemy_minimap_pos, Color(0.5, 0.5, 0.5, 0.3), 1.0);
+        // Draw enemy with different shapes based on index
+        if (i == 0) {
+            // First enemy as circle
+            draw_circle(enemy_minimap_pos, enemy_dot_radius * 1.2f, Color(1, 1, 1, 0.5)); // White outline
+            draw_circle(enemy_minimap_pos, enemy_dot_radius, enemy_color);
+        } 
+        else if (i == 1) {
+            // Second enemy as diamond
+            float size = enemy_dot_radius * 1.5f;
+            _set_diamond(diamond_outline, enemy_minimap_pos, size);
+            // Scale down for inner shape
+            _set_diamond(diamond_fill, enemy_minimap_pos, size * 0.8f);
             
-            // Draw glow effect
-            if (enemy_glow) {
-                Color glow_color = enemy_color;
-                glow_color.a = 0.3f;
-                draw_circle(enemy_minimap_pos, enemy_dot_radius * glow_size, glow_color);
-                
-                glow_color.a = 0.5f;
-                draw_circle(enemy_minimap_pos, enemy_dot_radius * (glow_size * 0.7f), glow_color);
-            }
+            // White outline, then the fill on top
+            Color outline_color = Color(1, 1, 1, 0.5);
+            draw_colored_polygon(diamond_outline, outline_color);
+            draw_colored_polygon(diamond_fill, enemy_color);
+        }
+        else {
+            // Other enemies as squares
+            float size = enemy_dot_radius * 1.0f;
+            draw_rect(Rect2(enemy_minimap_pos.x - size, enemy_minimap_pos.y - size, size * 2, size * 2), 
+                    Color(1, 1, 1, 0.5), true); // White outline
             
-            // Draw enemy with different shapes based on index
-            if (i == 0) {
-                // First enemy as circle
-                draw_circle(enemy_minimap_pos, enemy_dot_radius * 1.2f, Color(1, 1, 1, 0.5)); // White outline
-                draw_circle(enemy_minimap_pos, enemy_dot_radius, enemy_color);
-            } 
-            else if (i == 1) {
-                // Second enemy as diamond
-                float size = enemy_dot_radius * 1.5f;
-                PackedVector2Array points;
-                points.push_back(Vector2(enemy_minimap_pos.x, enemy_minimap_pos.y - size));      // Top
-                points.push_back(Vector2(enemy_minimap_pos.x + size, enemy_minimap_pos.y));      // Right
-                points.push_back(Vector2(enemy_minimap_pos.x, enemy_minimap_pos.y + size));      // Bottom
-                points.push_back(Vector2(enemy_minimap_pos.x - size, enemy_minimap_pos.y));      // Left
-                
-                // White outline
-                Color outline_color = Color(1, 1, 1, 0.5);
-                draw_colored_polygon(points, outline_color);
-                
-                // Scale down for inner shape
-                size *= 0.8f;
-                PackedVector2Array inner_points;
-                inner_points.push_back(Vector2(enemy_minimap_pos.x, enemy_minimap_pos.y - size));
-                inner_points.push_back(Vector2(enemy_minimap_pos.x + size, enemy_minimap_pos.y));
-                inner_points.push_back(Vector2(enemy_minimap_pos.x, enemy_minimap_pos.y + size));
-                inner_points.push_back(Vector2(enemy_minimap_pos.x - size, enemy_minimap_pos.y));
-                draw_colored_polygon(inner_points, enemy_color);
-            }
-            else {
-                // Other enemies as squares
-                float size = enemy_dot_radius * 1.0f;
-                draw_rect(Rect2(enemy_minimap_pos.x - size, enemy_minimap_pos.y - size, size * 2, size * 2), 
-                        Color(1, 1, 1, 0.5), true); // White outline
-                
-                // Inner square
-                float inner_size = size * 0.8f;
-                draw_rect(Rect2(enemy_minimap_pos.x - inner_size, enemy_minimap_pos.y - inner_size, inner_size * 2, inner_size * 2), 
-                        enemy_color, true);
-            }
+            // Inner square
+            float inner_size = size * 0.8f;
+            draw_rect(Rect2(enemy_minimap_pos.x - inner_size, enemy_minimap_pos.y - inner_size, inner_size * 2, inner_size * 2), 
+                    enemy_color, true);
         }
     }
     
+    NativeStats::add(NativeStats::MINIMAP_MARKERS, markers_drawn);
+    NativeStats::add(NativeStats::MINIMAP_CANVAS_COMMANDS, canvas_commands + 1);
+
     // Draw border
     draw_rect(Rect2(Vector2(0, 0), viewport_size), Color(0.2, 0.2, 0.2, 0.7), false, 2.0);
 }
 
+// Overwrites the four corners in place; only allocation-free while the canvas
+// no longer holds r_points from an earlier draw
+void MiniMap3D::_set_diamond(PackedVector2Array &r_points, const Vector2 &pos, float size) {
+    Vector2 *w = r_points.ptrw();
+    w[0] = Vector2(pos.x, pos.y - size);      // Top
+    w[1] = Vector2(pos.x + size, pos.y);      // Right
+    w[2] = Vector2(pos.x, pos.y + size);      // Bottom
+    w[3] = Vector2(pos.x - size, pos.y);      // Left
+}
+
 /* helper: convert world 3‑D position to 2‑D SubViewport coords */
 Vector2 MiniMap3D::_world_to_map(const Vector3 &world_pos) const {
     if (!cam) return Vector2();
@@ -395,6 +449,7 @@ void MiniMap3D::_debug_enemy_groups() {
             if (test_list.size() > 0) {
                 //UtilityFunctions::print("Found ", test_list.size(), " enemies in alternative group: '", group, "'");
                 enemy_group = group; // Update to use this group
+                enemies_dirty = true;
                 list = test_list;
                 break;
             }
@@ -407,6 +462,7 @@ void MiniMap3D::_debug_enemy_groups() {
     Node* root_node = get_tree()->get_current_scene();
     if (root_node) {
         _scan_for_enemies(root_node, 0);
+        enemies_dirty = true;
         
         // Get the updated list
         list = get_tree()->get_nodes_in_group(enemy_group);
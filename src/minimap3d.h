@@ -9,6 +9,7 @@
 #include <godot_cpp/variant/color.hpp> 
 #include <godot_cpp/classes/scene_tree.hpp>
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
 
 namespace godot {
 
@@ -34,6 +35,19 @@ class MiniMap3D : public SubViewportContainer {
     SubViewport *mini_vp = nullptr;
     Camera3D    *cam     = nullptr;
 
+    /* Enemy group members, re-queried after nodes enter or leave the tree and every
+       ENEMY_REFRESH_FRAMES for nodes that join the group later; ones that left the
+       group are skipped when drawing */
+    static const int ENEMY_REFRESH_FRAMES = 30;
+    Array enemies;
+    bool  enemies_dirty = true;
+
+    /* Diamond marker corners, outline and fill. Both are written before either is
+       drawn: a drawn array is shared with the canvas until the next redraw clears
+       it, and writing it then would copy */
+    PackedVector2Array diamond_outline;
+    PackedVector2Array diamond_fill;
+
 protected:
     static void _bind_methods();
     void _notification(int p_what);
@@ -43,6 +57,7 @@ public:
     void _process(double delta) override;
     void _debug_enemy_groups();
     void _scan_for_enemies(Node* node, int depth);
+    void _on_tree_changed(Node *node);
 
     /* setters / getters */
     void set_player_path(const NodePath &p) { player_path = p; }
@@ -67,7 +82,7 @@ public:
     void set_enemy_color(Color c)  { enemy_color = c; }
     Color get_enemy_color() const  { return enemy_color; }
 
-    void set_enemy_group(String g) { enemy_group = g; }
+    void set_enemy_group(String g) { enemy_group = g; enemies_dirty = true; }
     String get_enemy_group() const { return enemy_group; }
 
     void set_dot_radius(float r) { dot_radius = r; }
@@ -86,6 +101,7 @@ public:
 
 private:
     Vector2 _world_to_map(const Vector3 &world_pos) const;
+    static void _set_diamond(PackedVector2Array &r_points, const Vector2 &pos, float size);
 
 };
 
@@ -0,0 +1,41 @@
+#ifndef MINIMAP_CORE_H
+#define MINIMAP_CORE_H
+
+// Engine-independent minimap math used by MiniMap3D and the benchmarks.
+
+namespace godot {
+
+// Player-centered top-down projection: world X -> map x, world Z -> map y
+struct MinimapProjection {
+    float player_x = 0.0f, player_z = 0.0f;
+    float scale = 1.0f;             // map pixels per world unit
+    float center_x = 0.0f, center_y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+};
+
+inline void minimap_project(const MinimapProjection &p, float world_x, float world_z, float &r_x, float &r_y) {
+    r_x = p.center_x + (world_x - p.player_x) * p.scale;
+    r_y = p.center_y + (world_z - p.player_z) * p.scale;
+}
+
+// Projects every marker and keeps the ones inside the map (edges included).
+// Writes the surviving marker indices and map positions; returns how many survived.
+inline int minimap_cull_markers(const MinimapProjection &p, const float *world_x, const float *world_z, int count,
+        int *r_indices, float *r_map_x, float *r_map_y) {
+    int visible = 0;
+    for (int i = 0; i < count; i++) {
+        float x, y;
+        minimap_project(p, world_x[i], world_z[i], x, y);
+        if (x >= 0.0f && x <= p.width && y >= 0.0f && y <= p.height) {
+            r_indices[visible] = i;
+            r_map_x[visible] = x;
+            r_map_y[visible] = y;
+            visible++;
+        }
+    }
+    return visible;
+}
+
+} // namespace godot
+
+#endif // MINIMAP_CORE_H
@@ -0,0 +1,345 @@
+#include "mover_server.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/area2d.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/physics_server2d.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <cmath>
+
+#include "native_stats.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+KinematicMoverServer *KinematicMoverServer::singleton = nullptr;
+
+void KinematicMoverServer::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &KinematicMoverServer::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &KinematicMoverServer::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    ClassDB::bind_method(D_METHOD("add_ping_pong", "node", "from", "to", "speed"), &KinematicMoverServer::add_ping_pong);
+    ClassDB::bind_method(D_METHOD("add_waypoints", "node", "points", "speed"), &KinematicMoverServer::add_waypoints);
+    ClassDB::bind_method(D_METHOD("add_sine", "node", "velocity", "amplitude", "frequency", "phase"),
+            &KinematicMoverServer::add_sine, DEFVAL(0.0f));
+    ClassDB::bind_method(D_METHOD("remove_mover", "node", "sync"), &KinematicMoverServer::remove_mover, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("has_mover", "node"), &KinematicMoverServer::has_mover);
+    ClassDB::bind_method(D_METHOD("clear"), &KinematicMoverServer::clear);
+    ClassDB::bind_method(D_METHOD("get_mover_position", "node"), &KinematicMoverServer::get_mover_position);
+    ClassDB::bind_method(D_METHOD("sync_node", "node"), &KinematicMoverServer::sync_node);
+    ClassDB::bind_method(D_METHOD("get_mover_count"), &KinematicMoverServer::get_mover_count);
+    ClassDB::bind_method(D_METHOD("_step"), &KinematicMoverServer::_step);
+}
+
+KinematicMoverServer *KinematicMoverServer::get_singleton() {
+    return singleton;
+}
+
+KinematicMoverServer::KinematicMoverServer() {
+    singleton = this;
+}
+
+KinematicMoverServer::~KinematicMoverServer() {
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (tree && tree->is_connected("physics_frame", Callable(this, "_step"))) {
+        tree->disconnect("physics_frame", Callable(this, "_step"));
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void KinematicMoverServer::set_enabled(bool p_enabled) {
+    enabled = p_enabled;
+}
+
+bool KinematicMoverServer::is_enabled() const {
+    return enabled;
+}
+
+void KinematicMoverServer::_watch_tree() {
+    if (watching_tree) return;
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!tree) return;
+
+    // physics_frame fires before the nodes' _physics_process and the physics step
+    const Callable step(this, "_step");
+    if (!tree->is_connected("physics_frame", step)) {
+        tree->connect("physics_frame", step);
+    }
+    watching_tree = true;
+}
+
+int KinematicMoverServer::_add(Node2D *p_node, Motion p_motion) {
+    remove_mover(p_node, false);
+
+    const uint64_t id = p_node->get_instance_id();
+    const Transform2D local = p_node->get_transform();
+    Area2D *area = Object::cast_to<Area2D>(p_node);
+
+    const int i = (int)ids.size();
+    index[id] = i;
+    ids.push_back(id);
+    canvas_items.push_back(p_node->get_canvas_item());
+    areas.push_back(area ? area->get_rid() : RID());
+    rest.push_back(local);
+    parents.push_back(p_node->get_global_transform() * local.affine_inverse());
+    motions.push_back((uint8_t)p_motion);
+    origins.push_back(local.get_origin());
+    extents.push_back(Vector2());
+    axes.push_back(Vector2());
+    speeds.push_back(0.0f);
+    lengths.push_back(0.0f);
+    travel.push_back(0.0f);
+    segments.push_back(0);
+    paths.push_back(-1);
+    positions.push_back(local.get_origin());
+
+    _watch_tree();
+    return i;
+}
+
+void KinematicMoverServer::add_ping_pong(Node2D *p_node, const Vector2 &p_from, const Vector2 &p_to, float p_speed) {
+    ERR_FAIL_NULL(p_node);
+    const int i = _add(p_node, MOTION_PING_PONG);
+
+    const Vector2 extent = p_to - p_from;
+    const float length = extent.length();
+    origins[i] = p_from;
+    extents[i] = extent;
+    lengths[i] = length;
+    speeds[i] = std::fabs(p_speed);
+
+    // travel runs 0..2*length: out to p_to, then back. Negative speed starts on the way back.
+    float along = 0.0f;
+    if (length > 0.0f) {
+        along = CLAMP((positions[i] - p_from).dot(extent) / length, 0.0f, length);
+        positions[i] = p_from + extent * (along / length);
+    } else {
+        positions[i] = p_from;
+    }
+    travel[i] = p_speed < 0.0f ? 2.0f * length - along : along;
+    _write(i);
+}
+
+void KinematicMoverServer::add_waypoints(Node2D *p_node, const PackedVector2Array &p_points, float p_speed) {
+    ERR_FAIL_NULL(p_node);
+    ERR_FAIL_COND_MSG(p_points.is_empty(), "KinematicMoverServer: add_waypoints needs at least one point");
+    const int i = _add(p_node, MOTION_WAYPOINTS);
+
+    int slot;
+    if (!free_paths.empty()) {
+        slot = free_paths.back();
+        free_paths.pop_back();
+    } else {
+        slot = (int)path_points.size();
+        path_points.emplace_back();
+        path_distances.emplace_back();
+    }
+    std::vector<Vector2> &points = path_points[slot];
+    std::vector<float> &distances = path_distances[slot];
+    const int count = (int)p_points.size();
+    points.assign(p_points.ptr(), p_points.ptr() + count);
+    distances.resize(count + 1);
+    distances[0] = 0.0f;
+    for (int k = 0; k < count; k++) {
+        distances[k + 1] = distances[k] + points[k].distance_to(points[(k + 1) % count]);
+    }
+
+    paths[i] = slot;
+    lengths[i] = distances[count];
+    speeds[i] = std::fabs(p_speed);
+    positions[i] = points[0];
+    _write(i);
+}
+
+void KinematicMoverServer::add_sine(Node2D *p_node, const Vector2 &p_velocity, const Vector2 &p_amplitude, float p_frequency, float p_phase) {
+    ERR_FAIL_NULL(p_node);
+    const int i = _add(p_node, MOTION_SINE);
+
+    // The phase becomes a head start in time; the origin is shifted back so the drift starts here
+    const float start = p_frequency > 0.0f ? p_phase / p_frequency : 0.0f;
+    origins[i] = positions[i] - p_velocity * start;
+    extents[i] = p_velocity;
+    axes[i] = p_amplitude;
+    speeds[i] = p_frequency;
+    travel[i] = start;
+    positions[i] = origins[i] + p_velocity * start + p_amplitude * std::sin((float)Math_TAU * p_frequency * start);
+    _write(i);
+}
+
+void KinematicMoverServer::remove_mover(Node2D *p_node, bool p_sync) {
+    if (!p_node) return;
+    auto it = index.find(p_node->get_instance_id());
+    if (it != index.end()) {
+        _remove_at(it->second, p_sync);
+    }
+}
+
+bool KinematicMoverServer::has_mover(Node2D *p_node) const {
+    return p_node && index.count(p_node->get_instance_id());
+}
+
+void KinematicMoverServer::_remove_at(int p_index, bool p_sync) {
+    if (p_sync) {
+        Node2D *node = Object::cast_to<Node2D>(ObjectDB::get_instance(ids[p_index]));
+        if (node) {
+            node->set_position(positions[p_index]);
+        }
+    }
+    if (paths[p_index] >= 0) {
+        path_points[paths[p_index]].clear();
+        path_distances[paths[p_index]].clear();
+        free_paths.push_back(paths[p_index]);
+    }
+    index.erase(ids[p_index]);
+
+    const int last = (int)ids.size() - 1;
+    if (p_index != last) {
+        ids[p_index] = ids[last];
+        canvas_items[p_index] = canvas_items[last];
+        areas[p_index] = areas[last];
+        rest[p_index] = rest[last];
+        parents[p_index] = parents[last];
+        motions[p_index] = motions[last];
+        origins[p_index] = origins[last];
+        extents[p_index] = extents[last];
+        axes[p_index] = axes[last];
+        speeds[p_index] = speeds[last];
+        lengths[p_index] = lengths[last];
+        travel[p_index] = travel[last];
+        segments[p_index] = segments[last];
+        paths[p_index] = paths[last];
+        positions[p_index] = positions[last];
+        index[ids[p_index]] = p_index;
+    }
+    ids.pop_back();
+    canvas_items.pop_back();
+    areas.pop_back();
+    rest.pop_back();
+    parents.pop_back();
+    motions.pop_back();
+    origins.pop_back();
+    extents.pop_back();
+    axes.pop_back();
+    speeds.pop_back();
+    lengths.pop_back();
+    travel.pop_back();
+    segments.pop_back();
+    paths.pop_back();
+    positions.pop_back();
+}
+
+// Drops every mover without touching the nodes
+void KinematicMoverServer::clear() {
+    while (!ids.empty()) {
+        _remove_at((int)ids.size() - 1, false);
+    }
+}
+
+Vector2 KinematicMoverServer::get_mover_position(Node2D *p_node) const {
+    ERR_FAIL_NULL_V(p_node, Vector2());
+    auto it = index.find(p_node->get_instance_id());
+    if (it == index.end()) {
+        return p_node->get_position();
+    }
+    return positions[it->second];
+}
+
+void KinematicMoverServer::sync_node(Node2D *p_node) {
+    ERR_FAIL_NULL(p_node);
+    auto it = index.find(p_node->get_instance_id());
+    if (it != index.end()) {
+        p_node->set_position(positions[it->second]);
+    }
+}
+
+int KinematicMoverServer::get_mover_count() const {
+    return (int)ids.size();
+}
+
+void KinematicMoverServer::_write(int p_index) const {
+    Transform2D local = rest[p_index];
+    local.set_origin(positions[p_index]);
+    RenderingServer::get_singleton()->canvas_item_set_transform(canvas_items[p_index], local);
+    if (areas[p_index].is_valid()) {
+        PhysicsServer2D::get_singleton()->area_set_transform(areas[p_index], parents[p_index] * local);
+    }
+}
+
+void KinematicMoverServer::_step() {
+    if (!enabled || ids.empty()) {
+        return;
+    }
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (tree && tree->is_paused()) {
+        return;
+    }
+    PROFILE_ZONE("KinematicMoverServer::_step");
+
+    Engine *engine = Engine::get_singleton();
+    const float delta = (float)(engine->get_time_scale() / MAX(engine->get_physics_ticks_per_second(), 1));
+    const int count = (int)ids.size();
+
+    // Integrate everything first; only plain arrays are touched here
+    for (int i = 0; i < count; i++) {
+        switch (motions[i]) {
+            case MOTION_PING_PONG: {
+                const float length = lengths[i];
+                if (length <= 0.0f) break;
+                const float s = std::fmod(travel[i] + speeds[i] * delta, 2.0f * length);
+                travel[i] = s;
+                const float along = s <= length ? s : 2.0f * length - s;
+                positions[i] = origins[i] + extents[i] * (along / length);
+            } break;
+
+            case MOTION_WAYPOINTS: {
+                const float length = lengths[i];
+                if (length <= 0.0f) break;
+                const std::vector<Vector2> &points = path_points[paths[i]];
+                const std::vector<float> &distances = path_distances[paths[i]];
+                const int point_count = (int)points.size();
+
+                float s = travel[i] + speeds[i] * delta;
+                int segment = segments[i];
+                if (s >= length) {
+                    s = std::fmod(s, length);
+                    segment = 0;
+                }
+                while (segment < point_count - 1 && distances[segment + 1] <= s) {
+                    segment++;
+                }
+                travel[i] = s;
+                segments[i] = segment;
+
+                const float segment_length = distances[segment + 1] - distances[segment];
+                const float t = segment_length > 0.0f ? (s - distances[segment]) / segment_length : 0.0f;
+                positions[i] = points[segment].lerp(points[(segment + 1) % point_count], t);
+            } break;
+
+            case MOTION_SINE: {
+                const float t = travel[i] + delta;
+                travel[i] = t;
+                positions[i] = origins[i] + extents[i] * t + axes[i] * std::sin((float)Math_TAU * speeds[i] * t);
+            } break;
+        }
+    }
+
+    // Then hand the results to the servers, dropping movers whose node is gone
+    int i = 0;
+    while (i < (int)ids.size()) {
+        if (!ObjectDB::get_instance(ids[i])) {
+            _remove_at(i, false);
+            continue;
+        }
+        _write(i);
+        i++;
+    }
+    NativeStats::add(NativeStats::MOVERS_UPDATED, ids.size());
+}
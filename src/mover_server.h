@@ -0,0 +1,111 @@
+#ifndef MOVER_SERVER_H
+#define MOVER_SERVER_H
+
+#include <godot_cpp/classes/node2d.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/transform2d.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace godot {
+
+// Moves many kinematic 2D patrollers (AutoMover blocks, bullets, hazards) in
+// one pass per physics tick instead of one _physics_process per node.
+// Results go straight to the servers: the node's canvas item through
+// RenderingServer and, for an Area2D, its area through PhysicsServer2D, so
+// overlaps and area_entered keep working while the nodes themselves are never
+// touched. Positions are in the node's parent space (like set_position) and the
+// parent is assumed not to move. A node's own position is stale while it is
+// driven; get_mover_position() or sync_node() give the current one, and
+// remove_mover() writes it back.
+//
+// Motions:
+//   ping-pong  - back and forth between two points at a constant speed
+//   waypoints  - around a closed loop of points at a constant speed
+//   sine       - drifts along a velocity while oscillating along an axis
+//
+// Movers are kept in structure-of-arrays form, keyed by node, and swap-removed.
+// Freed nodes are dropped on the next tick. Nothing moves while the tree is paused.
+class KinematicMoverServer : public Object {
+    GDCLASS(KinematicMoverServer, Object);
+
+private:
+    enum Motion {
+        MOTION_PING_PONG,
+        MOTION_WAYPOINTS,
+        MOTION_SINE,
+    };
+
+    static KinematicMoverServer *singleton;
+
+    bool enabled = true;
+    bool watching_tree = false;
+
+    std::vector<uint64_t> ids;
+    std::vector<RID> canvas_items;
+    std::vector<RID> areas;              // invalid for nodes that aren't an Area2D
+    std::vector<Transform2D> rest;       // node's local transform, origin replaced each tick
+    std::vector<Transform2D> parents;    // parent's global transform when added
+    std::vector<uint8_t> motions;
+    std::vector<Vector2> origins;        // ping-pong start, sine center
+    std::vector<Vector2> extents;        // ping-pong end - start, sine velocity
+    std::vector<Vector2> axes;           // sine amplitude along x/y
+    std::vector<float> speeds;           // ping-pong/waypoint speed, sine frequency
+    std::vector<float> lengths;          // ping-pong segment or waypoint loop length
+    std::vector<float> travel;           // distance along the path, or sine time
+    std::vector<int> segments;           // current waypoint segment
+    std::vector<int> paths;              // index into path_points, -1 if none
+    std::vector<Vector2> positions;
+    std::unordered_map<uint64_t, int> index;
+
+    // Waypoint loops; slots are reused once their mover is gone
+    std::vector<std::vector<Vector2>> path_points;
+    std::vector<std::vector<float>> path_distances;   // distance at each point, plus the closing one
+    std::vector<int> free_paths;
+
+    int _add(Node2D *p_node, Motion p_motion);
+    void _remove_at(int p_index, bool p_sync);
+    void _write(int p_index) const;
+    void _watch_tree();
+
+protected:
+    static void _bind_methods();
+
+public:
+    static KinematicMoverServer *get_singleton();
+
+    KinematicMoverServer();
+    ~KinematicMoverServer();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+
+    // Starts at the node's position projected onto the segment, heading for p_to
+    // (or for p_from when p_speed is negative)
+    void add_ping_pong(Node2D *p_node, const Vector2 &p_from, const Vector2 &p_to, float p_speed);
+    // Snaps to the first point and loops back to it after the last
+    void add_waypoints(Node2D *p_node, const PackedVector2Array &p_points, float p_speed);
+    // Centered on the node's position; p_phase is in cycles
+    void add_sine(Node2D *p_node, const Vector2 &p_velocity, const Vector2 &p_amplitude, float p_frequency, float p_phase);
+    // Leaves the node where it was driven to unless p_sync is false
+    void remove_mover(Node2D *p_node, bool p_sync);
+    bool has_mover(Node2D *p_node) const;
+    void clear();
+
+    Vector2 get_mover_position(Node2D *p_node) const;
+    // Writes the driven position back into the node
+    void sync_node(Node2D *p_node);
+    int get_mover_count() const;
+
+    // Connected to SceneTree.physics_frame
+    void _step();
+};
+
+} // namespace godot
+
+#endif // MOVER_SERVER_H
@@ -0,0 +1,90 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace godot {
+
+// Bounded lock-free queue for many producer threads and one consumer
+// (Vyukov's sequence-numbered ring). Each slot carries a sequence number that
+// says whose turn it is: producers claim a slot with one CAS on the head and
+// publish it by bumping the sequence, the consumer reads slots in order without
+// any atomics read-modify-write. try_push fails instead of blocking when full.
+// T should be a small trivially copyable struct.
+template <typename T>
+class MpscRing {
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscRing(size_t p_capacity) {
+        size_t capacity = 2;
+        while (capacity < p_capacity) {
+            capacity <<= 1;
+        }
+        mask = capacity - 1;
+        slots.reset(new Slot[capacity]);
+        for (size_t i = 0; i < capacity; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    // Any thread
+    bool try_push(const T &p_value) {
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot &slot = slots[pos & mask];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const int64_t diff = (int64_t)sequence - (int64_t)pos;
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = p_value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full: the consumer hasn't freed this slot yet
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. Also fails while the next slot is claimed but not yet written.
+    bool try_pop(T &r_value) {
+        Slot &slot = slots[tail & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            return false;
+        }
+        r_value = slot.value;
+        slot.sequence.store(tail + mask + 1, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Approximate when producers are running
+    size_t size() const {
+        return (size_t)(head.load(std::memory_order_relaxed) - tail);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+    alignas(64) std::atomic<uint64_t> head{ 0 }; // next slot producers claim
+    alignas(64) uint64_t tail = 0;               // next slot the consumer reads
+};
+
+} // namespace godot
+
+#endif // MPSC_RING_H
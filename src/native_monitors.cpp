@@ -0,0 +1,109 @@
+#include "native_monitors.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/performance.hpp>
+
+#include "input_latency.h"
+
+using namespace godot;
+
+struct MonitorDef {
+    const char *id;
+    const char *method;
+    int arg;    // counter, or the percentile for latency rows; -1 for none
+};
+
+static const MonitorDef MONITORS[] = {
+    { "Native/AI decisions per frame", "_per_frame", NativeStats::AI_DECISIONS },
+    { "Native/AI decision mean latency (us)", "_ai_mean_latency_usec", -1 },
+    { "Native/MiniMap markers per frame", "_per_frame", NativeStats::MINIMAP_MARKERS },
+    { "Native/MiniMap canvas commands per frame", "_per_frame", NativeStats::MINIMAP_CANVAS_COMMANDS },
+    { "Native/MagneticOrbit bodies per physics tick", "_per_physics_tick", NativeStats::ORBIT_BODIES },
+    { "Native/DebugVisualizer shapes per frame", "_per_frame", NativeStats::DEBUG_SHAPES },
+    { "Native/Pool hits", "_total", NativeStats::POOL_HITS },
+    { "Native/Pool misses", "_total", NativeStats::POOL_MISSES },
+    { "Native/Frame arena allocations per frame", "_per_frame", NativeStats::FRAME_ARENA_ALLOCATIONS },
+    { "Native/Frame arena bytes per frame", "_per_frame", NativeStats::FRAME_ARENA_BYTES },
+    { "Native/Frame arena heap blocks", "_total", NativeStats::FRAME_ARENA_HEAP_BLOCKS },
+    { "Native/Hover items updated per frame", "_per_frame", NativeStats::HOVER_ITEMS_UPDATED },
+    { "Native/Magnet gems pulled per frame", "_per_frame", NativeStats::MAGNET_GEMS_PULLED },
+    { "Native/Outline uploads per frame", "_per_frame", NativeStats::OUTLINE_UPLOADS },
+    { "Native/Kinematic movers per physics tick", "_per_physics_tick", NativeStats::MOVERS_UPDATED },
+    { "Native/Input latency p50 (ms)", "_input_latency_ms", 50 },
+    { "Native/Input latency p95 (ms)", "_input_latency_ms", 95 },
+    { "Native/Input latency p99 (ms)", "_input_latency_ms", 99 },
+};
+
+void NativeMonitors::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("_per_frame", "counter"), &NativeMonitors::_per_frame);
+    ClassDB::bind_method(D_METHOD("_per_physics_tick", "counter"), &NativeMonitors::_per_physics_tick);
+    ClassDB::bind_method(D_METHOD("_total", "counter"), &NativeMonitors::_total);
+    ClassDB::bind_method(D_METHOD("_ai_mean_latency_usec"), &NativeMonitors::_ai_mean_latency_usec);
+    ClassDB::bind_method(D_METHOD("_input_latency_ms", "percentile"), &NativeMonitors::_input_latency_ms);
+}
+
+void NativeMonitors::add_monitors() {
+    Performance *perf = Performance::get_singleton();
+    for (const MonitorDef &def : MONITORS) {
+        Array args;
+        if (def.arg >= 0) {
+            args.push_back(def.arg);
+        }
+        perf->add_custom_monitor(def.id, Callable(this, def.method), args);
+    }
+}
+
+void NativeMonitors::remove_monitors() {
+    Performance *perf = Performance::get_singleton();
+    for (const MonitorDef &def : MONITORS) {
+        if (perf->has_custom_monitor(def.id)) {
+            perf->remove_custom_monitor(def.id);
+        }
+    }
+}
+
+// Counter growth per frame since the last read; repeats the last value when
+// read twice in the same frame.
+double NativeMonitors::_rate(int p_counter, uint64_t p_frame) {
+    ERR_FAIL_INDEX_V(p_counter, NativeStats::COUNTER_MAX, 0.0);
+    RateState &state = rates[p_counter];
+
+    uint64_t value = NativeStats::get((NativeStats::Counter)p_counter);
+    if (p_frame > state.last_frame) {
+        state.last_rate = (double)(value - state.last_value) / (double)(p_frame - state.last_frame);
+        state.last_value = value;
+        state.last_frame = p_frame;
+    }
+    return state.last_rate;
+}
+
+double NativeMonitors::_per_frame(int p_counter) {
+    return _rate(p_counter, Engine::get_singleton()->get_process_frames());
+}
+
+double NativeMonitors::_per_physics_tick(int p_counter) {
+    return _rate(p_counter, Engine::get_singleton()->get_physics_frames());
+}
+
+double NativeMonitors::_total(int p_counter) {
+    ERR_FAIL_INDEX_V(p_counter, NativeStats::COUNTER_MAX, 0.0);
+    return (double)NativeStats::get((NativeStats::Counter)p_counter);
+}
+
+double NativeMonitors::_ai_mean_latency_usec() {
+    uint64_t count = NativeStats::get(NativeStats::AI_DECISIONS);
+    uint64_t nsec = NativeStats::get(NativeStats::AI_DECISION_NSEC);
+    if (count > latency_last_count) {
+        latency_last_usec = (double)(nsec - latency_last_nsec) / (double)(count - latency_last_count) / 1000.0;
+        latency_last_count = count;
+        latency_last_nsec = nsec;
+    }
+    return latency_last_usec;
+}
+
+// Input to drawn frame, over every sample since InputLatency was last reset
+double NativeMonitors::_input_latency_ms(int p_percentile) {
+    InputLatency *latency = InputLatency::get_singleton();
+    return latency ? latency->get_percentile_ms(InputLatency::STAGE_INPUT_TO_DRAW, p_percentile) : 0.0;
+}
@@ -0,0 +1,49 @@
+#ifndef NATIVE_MONITORS_H
+#define NATIVE_MONITORS_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+
+#include "native_stats.h"
+
+namespace godot {
+
+// Publishes NativeStats counters as Performance custom monitors, so they show up
+// in the editor's Monitors tab under "Native" and can be read from scripts with
+// Performance.get_custom_monitor("Native/...").
+// Rates are averaged over the frames since the monitor was last read.
+class NativeMonitors : public Object {
+    GDCLASS(NativeMonitors, Object);
+
+private:
+    struct RateState {
+        uint64_t last_value = 0;
+        uint64_t last_frame = 0;
+        double last_rate = 0.0;
+    };
+
+    RateState rates[NativeStats::COUNTER_MAX];
+    uint64_t latency_last_count = 0;
+    uint64_t latency_last_nsec = 0;
+    double latency_last_usec = 0.0;
+
+    double _rate(int p_counter, uint64_t p_frame);
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Adds / removes every monitor; called from register_types.cpp
+    void add_monitors();
+    void remove_monitors();
+
+    double _per_frame(int p_counter);
+    double _per_physics_tick(int p_counter);
+    double _total(int p_counter);
+    double _ai_mean_latency_usec();
+    double _input_latency_ms(int p_percentile);
+};
+
+} // namespace godot
+
+#endif // NATIVE_MONITORS_H
@@ -0,0 +1,80 @@
+#include "native_profiler.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include "profile_zone.h"
+
+using namespace godot;
+
+NativeProfiler *NativeProfiler::singleton = nullptr;
+
+void NativeProfiler::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("is_available"), &NativeProfiler::is_available);
+    ClassDB::bind_method(D_METHOD("start_capture"), &NativeProfiler::start_capture);
+    ClassDB::bind_method(D_METHOD("stop_capture"), &NativeProfiler::stop_capture);
+    ClassDB::bind_method(D_METHOD("is_capturing"), &NativeProfiler::is_capturing);
+    ClassDB::bind_method(D_METHOD("get_event_count"), &NativeProfiler::get_event_count);
+    ClassDB::bind_method(D_METHOD("get_dropped_count"), &NativeProfiler::get_dropped_count);
+    ClassDB::bind_method(D_METHOD("save_chrome_trace", "path"), &NativeProfiler::save_chrome_trace);
+}
+
+NativeProfiler *NativeProfiler::get_singleton() {
+    return singleton;
+}
+
+NativeProfiler::NativeProfiler() {
+    singleton = this;
+    // Created at extension init, which runs on the main thread
+    PROFILE_THREAD_NAME("Main Thread");
+}
+
+NativeProfiler::~NativeProfiler() {
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+bool NativeProfiler::is_available() const {
+#ifdef GDE_PROFILING_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NativeProfiler::start_capture() {
+    if (!is_available()) {
+        UtilityFunctions::push_warning("NativeProfiler: zones were compiled out (profiling=no), the capture will be empty");
+    }
+    ProfileCapture::start();
+}
+
+void NativeProfiler::stop_capture() {
+    ProfileCapture::stop();
+}
+
+bool NativeProfiler::is_capturing() const {
+    return ProfileCapture::is_active();
+}
+
+int64_t NativeProfiler::get_event_count() const {
+    return (int64_t)ProfileCapture::get_event_count();
+}
+
+int64_t NativeProfiler::get_dropped_count() const {
+    return (int64_t)ProfileCapture::get_dropped_count();
+}
+
+Error NativeProfiler::save_chrome_trace(const String &p_path) const {
+    Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+    if (file.is_null()) {
+        return FileAccess::get_open_error();
+    }
+
+    std::string json = ProfileCapture::export_chrome_json();
+    file->store_string(String::utf8(json.c_str(), (int)json.size()));
+    file->close();
+    return OK;
+}
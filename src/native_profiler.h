@@ -0,0 +1,47 @@
+#ifndef NATIVE_PROFILER_H
+#define NATIVE_PROFILER_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+namespace godot {
+
+// Script-facing control of PROFILE_ZONE captures (see profile_zone.h).
+//   NativeProfiler.start_capture()
+//   ...
+//   NativeProfiler.stop_capture()
+//   NativeProfiler.save_chrome_trace("user://capture.json")
+// The saved file opens in ui.perfetto.dev or chrome://tracing.
+class NativeProfiler : public Object {
+    GDCLASS(NativeProfiler, Object);
+
+private:
+    static NativeProfiler *singleton;
+
+protected:
+    static void _bind_methods();
+
+public:
+    static NativeProfiler *get_singleton();
+
+    NativeProfiler();
+    ~NativeProfiler();
+
+    // False when the extension was built with profiling=no
+    bool is_available() const;
+
+    void start_capture();
+    void stop_capture();
+    bool is_capturing() const;
+
+    int64_t get_event_count() const;
+    int64_t get_dropped_count() const;
+
+    // Writes the current capture as Chrome trace JSON
+    Error save_chrome_trace(const String &p_path) const;
+};
+
+} // namespace godot
+
+#endif // NATIVE_PROFILER_H
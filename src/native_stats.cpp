@@ -0,0 +1,5 @@
+#include "native_stats.h"
+
+using namespace godot;
+
+std::atomic<uint64_t> NativeStats::counters[NativeStats::COUNTER_MAX] = {};
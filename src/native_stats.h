@@ -0,0 +1,63 @@
+#ifndef NATIVE_STATS_H
+#define NATIVE_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace godot {
+
+// Process-wide counters bumped by the native subsystems from any thread.
+// Counters only ever grow; consumers (FrameRecorder, monitors) diff them per frame.
+class NativeStats {
+public:
+    enum Counter {
+        AI_DECISIONS = 0,       // AIOrchestrator::next_enemy_state calls
+        MINIMAP_MARKERS,        // enemy markers drawn by MiniMap3D
+        ORBIT_BODIES,           // bodies pushed by MagneticOrbit::_integrate_forces
+        DEBUG_SHAPES,           // shape outlines drawn by DebugVisualizer
+        AI_DECISION_NSEC,       // time spent in AIOrchestrator::next_enemy_state
+        MINIMAP_CANVAS_COMMANDS,// draw_* calls issued by MiniMap3D::_draw
+        POOL_HITS,              // pooled node requests served from the pool
+        POOL_MISSES,            // pooled node requests that had to instantiate
+        FRAME_ARENA_ALLOCATIONS,// FrameArena allocations (published when the frame is rewound)
+        FRAME_ARENA_BYTES,      // bytes requested from FrameArena
+        FRAME_ARENA_HEAP_BLOCKS,// FrameArena blocks taken from the heap
+        HOVER_ITEMS_UPDATED,    // awake items stepped by HoverSystem
+        MAGNET_GEMS_PULLED,     // gems moved by GemMagnet3D
+        OUTLINE_UPLOADS,        // instance uniform and overlay changes made by OutlineManager
+        MOVERS_UPDATED,         // movers stepped by KinematicMoverServer
+        COUNTER_MAX
+    };
+
+    static void add(Counter p_counter, uint64_t p_amount = 1) {
+        counters[p_counter].fetch_add(p_amount, std::memory_order_relaxed);
+    }
+
+    static uint64_t get(Counter p_counter) {
+        return counters[p_counter].load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<uint64_t> counters[COUNTER_MAX];
+};
+
+// Adds the lifetime of the enclosing scope, in nanoseconds, to a counter
+class ScopedStatTimer {
+public:
+    explicit ScopedStatTimer(NativeStats::Counter p_counter) :
+            counter(p_counter), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedStatTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        NativeStats::add(counter, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+private:
+    NativeStats::Counter counter;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace godot
+
+#endif // NATIVE_STATS_H
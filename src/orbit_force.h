@@ -0,0 +1,67 @@
+#ifndef ORBIT_FORCE_H
+#define ORBIT_FORCE_H
+
+#include <cmath>
+
+namespace godot {
+
+// Tunables of the magnetic orbit model (see MagneticOrbit)
+struct OrbitParams {
+    float max_distance   = 300.0f;
+    float orbit_distance = 80.0f;
+    float magnetic_force = 10000.0f;
+    float swirl_factor   = 0.5f;
+};
+
+// Engine-independent orbit force shared by MagneticOrbit and OrbitPredictor.
+// (dx, dy) is the offset from the orbiting body to the center it is pulled to.
+// Returns false (and a zero force) when the body is out of range.
+inline bool compute_orbit_force(float dx, float dy, const OrbitParams &p, float &r_fx, float &r_fy) {
+    float dist = std::sqrt(dx * dx + dy * dy);
+    if (dist <= 0.001f || dist > p.max_distance) {
+        r_fx = 0.0f;
+        r_fy = 0.0f;
+        return false;
+    }
+
+    // Radial pull follows an inverse square law (F ∝ 1/d²)
+    float force_mag = p.magnetic_force / (dist * dist);
+    float nx = dx / dist;
+    float ny = dy / dist;
+
+    // Tangential (swirl) component only inside the orbit distance
+    float swirl = dist < p.orbit_distance ? p.swirl_factor : 0.0f;
+
+    r_fx = (nx - ny * swirl) * force_mag;
+    r_fy = (ny + nx * swirl) * force_mag;
+    return true;
+}
+
+// 3D form of the same model (GemMagnet3D): the pull is along the full offset,
+// the swirl circles the world up axis, so on the XZ plane it matches the 2D force
+// with (x, y) -> (x, z).
+inline bool compute_orbit_force_3d(float dx, float dy, float dz, const OrbitParams &p, float &r_fx, float &r_fy, float &r_fz) {
+    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (dist <= 0.001f || dist > p.max_distance) {
+        r_fx = 0.0f;
+        r_fy = 0.0f;
+        r_fz = 0.0f;
+        return false;
+    }
+
+    float force_mag = p.magnetic_force / (dist * dist);
+    float nx = dx / dist;
+    float ny = dy / dist;
+    float nz = dz / dist;
+
+    float swirl = dist < p.orbit_distance ? p.swirl_factor : 0.0f;
+
+    r_fx = (nx - nz * swirl) * force_mag;
+    r_fy = ny * force_mag;
+    r_fz = (nz + nx * swirl) * force_mag;
+    return true;
+}
+
+} // namespace godot
+
+#endif // ORBIT_FORCE_H
@@ -0,0 +1,177 @@
+#include "orbit_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "profile_zone.h"
+
+using namespace godot;
+
+OrbitPredictor::OrbitPredictor() {
+}
+
+OrbitPredictor::~OrbitPredictor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    cv_job.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void OrbitPredictor::submit(const std::vector<BodyState> &p_bodies, int p_steps, float p_step_time) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Start the worker lazily so visualizers that never predict cost nothing
+    if (!worker.joinable()) {
+        worker = std::thread(&OrbitPredictor::_worker_loop, this);
+    }
+
+    // Never overwrite inputs the worker is still reading
+    cv_done.wait(lock, [this]() { return !job_running; });
+
+    job_bodies = p_bodies;
+    job_steps = std::max(p_steps, 0);
+    job_step_time = p_step_time;
+    job_pending = true;
+    job_running = true;
+
+    lock.unlock();
+    cv_job.notify_one();
+}
+
+bool OrbitPredictor::fetch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!job_pending) {
+        return false;
+    }
+
+    cv_done.wait(lock, [this]() { return !job_running; });
+
+    segments.swap(job_segments);
+    body_count = (int)job_bodies.size();
+    step_count = job_steps;
+    job_pending = false;
+    return true;
+}
+
+void OrbitPredictor::_worker_loop() {
+    PROFILE_THREAD_NAME("OrbitPredictor");
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv_job.wait(lock, [this]() { return quit || job_running; });
+        if (quit) {
+            return;
+        }
+
+        // Inputs are stable while job_running is set, so integrate unlocked
+        lock.unlock();
+        {
+            PROFILE_ZONE("OrbitPredictor::predict");
+            predict(job_bodies, job_steps, job_step_time, job_segments);
+        }
+        lock.lock();
+
+        job_running = false;
+        cv_done.notify_all();
+    }
+}
+
+// One tick for `count` bodies in structure-of-arrays form. Mirrors a MagneticOrbit
+// physics tick: impulse from the orbit force, gravity, linear damping, then the
+// position update. Written with selects only so the compiler can vectorize it.
+static void _step_bodies(int count, float step_time,
+        float *__restrict px, float *__restrict py, float *__restrict vx, float *__restrict vy,
+        const float *__restrict cx, const float *__restrict cy,
+        const float *__restrict gx, const float *__restrict gy,
+        const float *__restrict inv_mass, const float *__restrict damp,
+        const float *__restrict max_d2, const float *__restrict orbit_d2,
+        const float *__restrict force, const float *__restrict swirl) {
+    const float min_d2 = 0.001f * 0.001f;
+
+    for (int i = 0; i < count; i++) {
+        float dx = cx[i] - px[i];
+        float dy = cy[i] - py[i];
+        float d2 = dx * dx + dy * dy;
+
+        // Same model as compute_orbit_force(), with range checks on squared distances
+        float in_range = (float)((d2 > min_d2) & (d2 <= max_d2[i]));
+        float inv_dist = in_range / std::sqrt(std::max(d2, min_d2));
+        float mag = force[i] * inv_dist * inv_dist;
+        float sw = (float)(d2 < orbit_d2[i]) * swirl[i];
+        float nx = dx * inv_dist;
+        float ny = dy * inv_dist;
+        float fx = (nx - ny * sw) * mag;
+        float fy = (ny + nx * sw) * mag;
+
+        vx[i] = (vx[i] + fx * inv_mass[i] + gx[i]) * damp[i];
+        vy[i] = (vy[i] + fy * inv_mass[i] + gy[i]) * damp[i];
+        px[i] += vx[i] * step_time;
+        py[i] += vy[i] * step_time;
+    }
+}
+
+// Integrates every body for p_steps ticks and emits one segment per body per tick
+void OrbitPredictor::predict(const std::vector<BodyState> &p_bodies, int p_steps, float p_step_time, std::vector<float> &r_segments) {
+    const int count = (int)p_bodies.size();
+    r_segments.resize((size_t)count * (size_t)std::max(p_steps, 0) * 4);
+    if (count == 0 || p_steps <= 0) {
+        return;
+    }
+
+    // Unpack into structure-of-arrays
+    std::vector<float> soa((size_t)count * 14);
+    float *px = soa.data();
+    float *py = px + count;
+    float *vx = py + count;
+    float *vy = vx + count;
+    float *cx = vy + count;
+    float *cy = cx + count;
+    float *gx = cy + count;
+    float *gy = gx + count;
+    float *inv_mass = gy + count;
+    float *damp = inv_mass + count;
+    float *max_d2 = damp + count;
+    float *orbit_d2 = max_d2 + count;
+    float *force = orbit_d2 + count;
+    float *swirl = force + count;
+
+    for (int i = 0; i < count; i++) {
+        const BodyState &b = p_bodies[i];
+        px[i] = b.px;
+        py[i] = b.py;
+        vx[i] = b.vx;
+        vy[i] = b.vy;
+        cx[i] = b.cx;
+        cy[i] = b.cy;
+        gx[i] = b.gx * p_step_time;
+        gy[i] = b.gy * p_step_time;
+        inv_mass[i] = b.inv_mass;
+        damp[i] = std::max(1.0f - b.linear_damp * p_step_time, 0.0f);
+        max_d2[i] = b.params.max_distance * b.params.max_distance;
+        orbit_d2[i] = b.params.orbit_distance * b.params.orbit_distance;
+        force[i] = b.params.magnetic_force;
+        swirl[i] = b.params.swirl_factor;
+    }
+
+    // Segments are written step-major so the stores stay contiguous;
+    // draw_multiline does not care about segment order.
+    float *out = r_segments.data();
+
+    for (int s = 0; s < p_steps; s++) {
+        float *seg = out + (size_t)s * (size_t)count * 4;
+        for (int i = 0; i < count; i++) {
+            seg[i * 4 + 0] = px[i];
+            seg[i * 4 + 1] = py[i];
+        }
+
+        _step_bodies(count, p_step_time, px, py, vx, vy, cx, cy, gx, gy, inv_mass, damp, max_d2, orbit_d2, force, swirl);
+
+        for (int i = 0; i < count; i++) {
+            seg[i * 4 + 2] = px[i];
+            seg[i * 4 + 3] = py[i];
+        }
+    }
+}
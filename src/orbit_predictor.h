@@ -0,0 +1,74 @@
+#ifndef ORBIT_PREDICTOR_H
+#define ORBIT_PREDICTOR_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "orbit_force.h"
+
+namespace godot {
+
+// Predicts future paths of orbiting bodies without touching the physics server.
+// Bodies are integrated in structure-of-arrays form on a persistent worker thread;
+// results are returned as line segment endpoints ready for a single draw_multiline.
+class OrbitPredictor {
+public:
+    // Snapshot of one body taken on the main thread
+    struct BodyState {
+        float px = 0.0f, py = 0.0f;   // body position
+        float vx = 0.0f, vy = 0.0f;   // body linear velocity
+        float cx = 0.0f, cy = 0.0f;   // center the body orbits (assumed static)
+        float gx = 0.0f, gy = 0.0f;   // gravity acceleration (already scaled)
+        float inv_mass = 1.0f;
+        float linear_damp = 0.0f;
+        OrbitParams params;
+    };
+
+    OrbitPredictor();
+    ~OrbitPredictor();
+
+    // Queue a prediction of `steps` ticks of `step_time` seconds. Returns immediately;
+    // an older job that is still running is left to finish first.
+    void submit(const std::vector<BodyState> &p_bodies, int p_steps, float p_step_time);
+
+    // Wait for the last submitted job and swap its results in.
+    // Returns false when nothing was pending.
+    bool fetch();
+
+    // Interleaved x,y pairs: two endpoints per segment, body_count * steps segments
+    const std::vector<float> &get_segments() const { return segments; }
+    int get_body_count() const { return body_count; }
+    int get_step_count() const { return step_count; }
+
+    // Synchronous kernel used by the worker (and usable headless).
+    // Writes body_count * steps segments into r_segments.
+    static void predict(const std::vector<BodyState> &p_bodies, int p_steps, float p_step_time, std::vector<float> &r_segments);
+
+private:
+    void _worker_loop();
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable cv_job;
+    std::condition_variable cv_done;
+    bool job_pending = false;   // submitted, not yet picked up by fetch()
+    bool job_running = false;   // worker has work to do
+    bool quit = false;
+
+    // Job input / output owned by the worker while job_running
+    std::vector<BodyState> job_bodies;
+    std::vector<float> job_segments;
+    int job_steps = 0;
+    float job_step_time = 0.0f;
+
+    // Last fetched results, owned by the main thread
+    std::vector<float> segments;
+    int body_count = 0;
+    int step_count = 0;
+};
+
+} // namespace godot
+
+#endif // ORBIT_PREDICTOR_H
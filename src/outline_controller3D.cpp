@@ -50,6 +50,7 @@ OutlineController3D::~OutlineController3D() {
 
 void OutlineController3D::set_material(const Ref<ShaderMaterial> &p_material) {
     material = p_material;
+    _mark_dirty(DIRTY_ALL);
 }
 
 Ref<ShaderMaterial> OutlineController3D::get_material() const {
@@ -57,7 +58,9 @@ Ref<ShaderMaterial> OutlineController3D::get_material() const {
 }
 
 void OutlineController3D::set_outline_color(const Color &p_color) {
+    if (outline_color == p_color) return;
     outline_color = p_color;
+    _mark_dirty(DIRTY_OUTLINE_COLOR);
 }
 
 Color OutlineController3D::get_outline_color() const {
@@ -65,7 +68,9 @@ Color OutlineController3D::get_outline_color() const {
 }
 
 void OutlineController3D::set_noise_scale(float p_scale) {
+    if (noise_scale == p_scale) return;
     noise_scale = p_scale;
+    _mark_dirty(DIRTY_NOISE_SCALE);
 }
 
 float OutlineController3D::get_noise_scale() const {
@@ -73,7 +78,9 @@ float OutlineController3D::get_noise_scale() const {
 }
 
 void OutlineController3D::set_deformation_strength(float p_strength) {
+    if (deformation_strength == p_strength) return;
     deformation_strength = p_strength;
+    _mark_dirty(DIRTY_DEFORMATION_STRENGTH);
 }
 
 float OutlineController3D::get_deformation_strength() const {
@@ -81,20 +88,40 @@ float OutlineController3D::get_deformation_strength() const {
 }
 
 void OutlineController3D::set_outline_thickness(float p_thickness) {
+    if (outline_thickness == p_thickness) return;
     outline_thickness = p_thickness;
+    _mark_dirty(DIRTY_OUTLINE_THICKNESS);
 }
 
 float OutlineController3D::get_outline_thickness() const {
     return outline_thickness;
 }
 
+void OutlineController3D::_mark_dirty(uint32_t p_flags) {
+    dirty |= p_flags;
+    // Several setters in one frame still mean one upload per uniform
+    set_process(true);
+}
+
+void OutlineController3D::_ready() {
+    // Node turns processing on for overridden _process; keep it only while there is work
+    set_process(dirty != 0);
+}
+
 void OutlineController3D::_process(double delta) {
-    // If we have a valid ShaderMaterial, keep pushing our property values into the shader.
-    // This allows real-time tweaking of the shader’s uniforms from the editor or at runtime.
-    if (material.is_valid()) {
-        material->set_shader_parameter("outline_color", outline_color);
-        material->set_shader_parameter("noise_scale", noise_scale);
-        material->set_shader_parameter("deformation_strength", deformation_strength);
-        material->set_shader_parameter("outline_thickness", outline_thickness);
+    // Push only the uniforms that changed into the shader, then go idle until a setter
+    // (editor or runtime tweak) marks something dirty again.
+    if (material.is_valid() && dirty) {
+        static const StringName outline_color_name("outline_color");
+        static const StringName noise_scale_name("noise_scale");
+        static const StringName deformation_strength_name("deformation_strength");
+        static const StringName outline_thickness_name("outline_thickness");
+
+        if (dirty & DIRTY_OUTLINE_COLOR) material->set_shader_parameter(outline_color_name, outline_color);
+        if (dirty & DIRTY_NOISE_SCALE) material->set_shader_parameter(noise_scale_name, noise_scale);
+        if (dirty & DIRTY_DEFORMATION_STRENGTH) material->set_shader_parameter(deformation_strength_name, deformation_strength);
+        if (dirty & DIRTY_OUTLINE_THICKNESS) material->set_shader_parameter(outline_thickness_name, outline_thickness);
     }
+    dirty = 0;
+    set_process(false);
 }
@@ -22,6 +22,18 @@ private:
     float deformation_strength;
     float outline_thickness;
 
+    // Uniforms changed since the last upload; _process only runs while non-zero
+    enum DirtyFlags {
+        DIRTY_OUTLINE_COLOR = 1 << 0,
+        DIRTY_NOISE_SCALE = 1 << 1,
+        DIRTY_DEFORMATION_STRENGTH = 1 << 2,
+        DIRTY_OUTLINE_THICKNESS = 1 << 3,
+        DIRTY_ALL = (1 << 4) - 1,
+    };
+    uint32_t dirty = DIRTY_ALL;
+
+    void _mark_dirty(uint32_t p_flags);
+
 protected:
     static void _bind_methods();
 
@@ -29,7 +41,8 @@ public:
     OutlineController3D();
     ~OutlineController3D();
 
-    // Called every frame; we’ll update the shader parameters here.
+    void _ready() override;
+    // Uploads the changed uniforms once, then switches processing off again
     void _process(double delta) override;
 
     // -- Material Accessors --
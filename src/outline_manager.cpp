@@ -0,0 +1,275 @@
+#include "outline_manager.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/camera3d.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <algorithm>
+
+#include "native_stats.h"
+#include "profile_zone.h"
+
+using namespace godot;
+
+OutlineManager *OutlineManager::singleton = nullptr;
+
+void OutlineManager::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &OutlineManager::set_enabled);
+    ClassDB::bind_method(D_METHOD("is_enabled"), &OutlineManager::is_enabled);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+
+    ClassDB::bind_method(D_METHOD("set_material_path", "path"), &OutlineManager::set_material_path);
+    ClassDB::bind_method(D_METHOD("get_material_path"), &OutlineManager::get_material_path);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "material_path", PROPERTY_HINT_FILE, "*.tres"), "set_material_path", "get_material_path");
+
+    ClassDB::bind_method(D_METHOD("set_material", "material"), &OutlineManager::set_material);
+    ClassDB::bind_method(D_METHOD("get_material"), &OutlineManager::get_material);
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "material", PROPERTY_HINT_RESOURCE_TYPE, "ShaderMaterial"), "set_material", "get_material");
+
+    ClassDB::bind_method(D_METHOD("set_lod_distance", "distance"), &OutlineManager::set_lod_distance);
+    ClassDB::bind_method(D_METHOD("get_lod_distance"), &OutlineManager::get_lod_distance);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance"), "set_lod_distance", "get_lod_distance");
+
+    ClassDB::bind_method(D_METHOD("set_lod_checks_per_frame", "count"), &OutlineManager::set_lod_checks_per_frame);
+    ClassDB::bind_method(D_METHOD("get_lod_checks_per_frame"), &OutlineManager::get_lod_checks_per_frame);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_checks_per_frame"), "set_lod_checks_per_frame", "get_lod_checks_per_frame");
+
+    ClassDB::bind_method(D_METHOD("add_outline", "mesh", "tint", "thickness_scale"), &OutlineManager::add_outline,
+            DEFVAL(Color(0, 0, 0, 0)), DEFVAL(1.0f));
+    ClassDB::bind_method(D_METHOD("remove_outline", "mesh"), &OutlineManager::remove_outline);
+    ClassDB::bind_method(D_METHOD("has_outline", "mesh"), &OutlineManager::has_outline);
+    ClassDB::bind_method(D_METHOD("set_outline_tint", "mesh", "tint"), &OutlineManager::set_outline_tint);
+    ClassDB::bind_method(D_METHOD("set_outline_thickness_scale", "mesh", "scale"), &OutlineManager::set_outline_thickness_scale);
+    ClassDB::bind_method(D_METHOD("get_outline_count"), &OutlineManager::get_outline_count);
+    ClassDB::bind_method(D_METHOD("get_shown_count"), &OutlineManager::get_shown_count);
+    ClassDB::bind_method(D_METHOD("_update"), &OutlineManager::_update);
+}
+
+OutlineManager *OutlineManager::get_singleton() {
+    return singleton;
+}
+
+OutlineManager::OutlineManager() {
+    singleton = this;
+    RenderingServer::get_singleton()->connect("frame_pre_draw", Callable(this, "_update"));
+}
+
+OutlineManager::~OutlineManager() {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (rs && rs->is_connected("frame_pre_draw", Callable(this, "_update"))) {
+        rs->disconnect("frame_pre_draw", Callable(this, "_update"));
+    }
+
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void OutlineManager::set_enabled(bool p_enabled) {
+    enabled = p_enabled;
+}
+
+bool OutlineManager::is_enabled() const {
+    return enabled;
+}
+
+void OutlineManager::set_material_path(const String &p_path) {
+    material_path = p_path;
+}
+
+String OutlineManager::get_material_path() const {
+    return material_path;
+}
+
+void OutlineManager::set_material(const Ref<ShaderMaterial> &p_material) {
+    material = p_material;
+    // Swap the overlay on everything currently shown
+    for (int i = 0; i < (int)ids.size(); i++) {
+        GeometryInstance3D *mesh = Object::cast_to<GeometryInstance3D>(ObjectDB::get_instance(ids[i]));
+        if (mesh && shown[i]) {
+            mesh->set_material_overlay(material);
+        }
+    }
+}
+
+Ref<ShaderMaterial> OutlineManager::get_material() const {
+    return material;
+}
+
+void OutlineManager::set_lod_distance(float p_distance) {
+    lod_distance = MAX(p_distance, 0.0f);
+}
+
+float OutlineManager::get_lod_distance() const {
+    return lod_distance;
+}
+
+void OutlineManager::set_lod_checks_per_frame(int p_count) {
+    lod_checks_per_frame = MAX(p_count, 1);
+}
+
+int OutlineManager::get_lod_checks_per_frame() const {
+    return lod_checks_per_frame;
+}
+
+Ref<ShaderMaterial> OutlineManager::_get_material() {
+    if (material.is_null() && !material_path.is_empty()) {
+        material = ResourceLoader::get_singleton()->load(material_path);
+        ERR_FAIL_COND_V_MSG(material.is_null(), material, "OutlineManager: could not load " + material_path);
+    }
+    return material;
+}
+
+void OutlineManager::_show(GeometryInstance3D *p_mesh, int p_index, bool p_show) {
+    if ((bool)shown[p_index] == p_show) return;
+    p_mesh->set_material_overlay(p_show ? Ref<Material>(material) : Ref<Material>());
+    shown[p_index] = p_show;
+    NativeStats::add(NativeStats::OUTLINE_UPLOADS);
+}
+
+void OutlineManager::add_outline(GeometryInstance3D *p_mesh, const Color &p_tint, float p_thickness_scale) {
+    ERR_FAIL_NULL(p_mesh);
+    const uint64_t id = p_mesh->get_instance_id();
+    if (index.count(id)) {
+        set_outline_tint(p_mesh, p_tint);
+        set_outline_thickness_scale(p_mesh, p_thickness_scale);
+        return;
+    }
+
+    Ref<ShaderMaterial> shared = _get_material();
+    ERR_FAIL_COND(shared.is_null());
+    Ref<Material> overlay = p_mesh->get_material_overlay();
+    ERR_FAIL_COND_MSG(overlay.is_valid() && overlay != shared,
+            "OutlineManager: " + String(p_mesh->get_name()) + " already has a material_overlay");
+
+    static const StringName tint_name("outline_tint");
+    static const StringName scale_name("outline_scale");
+    p_mesh->set_instance_shader_parameter(tint_name, p_tint);
+    p_mesh->set_instance_shader_parameter(scale_name, p_thickness_scale);
+    NativeStats::add(NativeStats::OUTLINE_UPLOADS, 2);
+
+    index[id] = (int)ids.size();
+    ids.push_back(id);
+    tints.push_back(p_tint);
+    scales.push_back(p_thickness_scale);
+    shown.push_back(0);
+    // Shown right away; the LOD pass hides it if it turns out to be far away
+    _show(p_mesh, (int)ids.size() - 1, true);
+}
+
+void OutlineManager::remove_outline(GeometryInstance3D *p_mesh) {
+    if (!p_mesh) return;
+    auto it = index.find(p_mesh->get_instance_id());
+    if (it != index.end()) {
+        _remove_at(it->second, true);
+    }
+}
+
+void OutlineManager::_remove_at(int p_index, bool p_restore) {
+    GeometryInstance3D *mesh = p_restore ? Object::cast_to<GeometryInstance3D>(ObjectDB::get_instance(ids[p_index])) : nullptr;
+    if (mesh) {
+        static const StringName tint_name("outline_tint");
+        static const StringName scale_name("outline_scale");
+        if (shown[p_index]) {
+            mesh->set_material_overlay(Ref<Material>());
+        }
+        // A nil value drops the instance parameter again
+        mesh->set_instance_shader_parameter(tint_name, Variant());
+        mesh->set_instance_shader_parameter(scale_name, Variant());
+    }
+    index.erase(ids[p_index]);
+
+    const int last = (int)ids.size() - 1;
+    if (p_index != last) {
+        ids[p_index] = ids[last];
+        tints[p_index] = tints[last];
+        scales[p_index] = scales[last];
+        shown[p_index] = shown[last];
+        index[ids[p_index]] = p_index;
+    }
+    ids.pop_back();
+    tints.pop_back();
+    scales.pop_back();
+    shown.pop_back();
+}
+
+bool OutlineManager::has_outline(GeometryInstance3D *p_mesh) const {
+    return p_mesh && index.count(p_mesh->get_instance_id());
+}
+
+void OutlineManager::set_outline_tint(GeometryInstance3D *p_mesh, const Color &p_tint) {
+    ERR_FAIL_NULL(p_mesh);
+    auto it = index.find(p_mesh->get_instance_id());
+    ERR_FAIL_COND_MSG(it == index.end(), "OutlineManager: mesh has no outline");
+    if (tints[it->second] == p_tint) return;
+
+    static const StringName tint_name("outline_tint");
+    tints[it->second] = p_tint;
+    p_mesh->set_instance_shader_parameter(tint_name, p_tint);
+    NativeStats::add(NativeStats::OUTLINE_UPLOADS);
+}
+
+void OutlineManager::set_outline_thickness_scale(GeometryInstance3D *p_mesh, float p_scale) {
+    ERR_FAIL_NULL(p_mesh);
+    auto it = index.find(p_mesh->get_instance_id());
+    ERR_FAIL_COND_MSG(it == index.end(), "OutlineManager: mesh has no outline");
+    if (scales[it->second] == p_scale) return;
+
+    static const StringName scale_name("outline_scale");
+    scales[it->second] = p_scale;
+    p_mesh->set_instance_shader_parameter(scale_name, p_scale);
+    NativeStats::add(NativeStats::OUTLINE_UPLOADS);
+}
+
+int OutlineManager::get_outline_count() const {
+    return (int)ids.size();
+}
+
+int OutlineManager::get_shown_count() const {
+    return (int)std::count(shown.begin(), shown.end(), (uint8_t)1);
+}
+
+void OutlineManager::_update() {
+    if (!enabled || ids.empty()) {
+        return;
+    }
+    PROFILE_ZONE("OutlineManager::_update");
+
+    SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    Camera3D *camera = tree && tree->get_root() ? tree->get_root()->get_camera_3d() : nullptr;
+    if (!camera) {
+        return;
+    }
+    const Vector3 eye = camera->get_global_position();
+
+    // Hysteresis so objects right at the boundary don't flip every check
+    const float show_sq = lod_distance * lod_distance;
+    const float hide_sq = show_sq * 1.21f;
+
+    // A round-robin slice per frame; outlines far away can wait a few frames
+    int checks = MIN(lod_checks_per_frame, (int)ids.size());
+    while (checks-- > 0 && !ids.empty()) {
+        if (lod_cursor >= ids.size()) lod_cursor = 0;
+        const int i = (int)lod_cursor;
+
+        GeometryInstance3D *mesh = Object::cast_to<GeometryInstance3D>(ObjectDB::get_instance(ids[i]));
+        if (!mesh) {
+            _remove_at(i, false); // freed; the swapped-in entry is checked next
+            continue;
+        }
+        lod_cursor++;
+        if (!mesh->is_inside_tree()) continue;
+
+        const float dist_sq = eye.distance_squared_to(mesh->get_global_position());
+        if (shown[i] && dist_sq > hide_sq) {
+            _show(mesh, i, false);
+        } else if (!shown[i] && dist_sq < show_sq) {
+            _show(mesh, i, true);
+        }
+    }
+}
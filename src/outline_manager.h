@@ -0,0 +1,84 @@
+#ifndef OUTLINE_MANAGER_H
+#define OUTLINE_MANAGER_H
+
+#include <godot_cpp/classes/geometry_instance3d.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/classes/shader_material.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace godot {
+
+// Outlines for any number of meshes with one shared Outline.gdshader material.
+// The material goes on each mesh as its material_overlay; per-object color
+// and thickness are the shader's instance uniforms (outline_tint,
+// outline_scale), uploaded only when they change. Objects farther than
+// lod_distance from the camera lose the overlay, so the outline pass is not
+// drawn for them at all; a slice of the objects is checked every frame.
+//
+// Meshes that already use material_overlay for something else are refused.
+class OutlineManager : public Object {
+    GDCLASS(OutlineManager, Object);
+
+private:
+    static OutlineManager *singleton;
+
+    bool enabled = true;
+    String material_path = "res://assets/shaders/OutlineMaterial.tres";
+    Ref<ShaderMaterial> material;
+    float lod_distance = 40.0f;
+    int lod_checks_per_frame = 256;
+    size_t lod_cursor = 0;
+
+    // Registered meshes, structure-of-arrays and swap-removed
+    std::vector<uint64_t> ids;
+    std::vector<Color> tints;
+    std::vector<float> scales;
+    std::vector<uint8_t> shown;   // overlay currently assigned
+    std::unordered_map<uint64_t, int> index;
+
+    Ref<ShaderMaterial> _get_material();
+    void _remove_at(int p_index, bool p_restore);
+    void _show(GeometryInstance3D *p_mesh, int p_index, bool p_show);
+
+protected:
+    static void _bind_methods();
+
+public:
+    static OutlineManager *get_singleton();
+
+    OutlineManager();
+    ~OutlineManager();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const;
+    void set_material_path(const String &p_path);
+    String get_material_path() const;
+    void set_material(const Ref<ShaderMaterial> &p_material);
+    Ref<ShaderMaterial> get_material() const;
+    void set_lod_distance(float p_distance);
+    float get_lod_distance() const;
+    void set_lod_checks_per_frame(int p_count);
+    int get_lod_checks_per_frame() const;
+
+    // A tint alpha of 0 keeps the material's outline_color
+    void add_outline(GeometryInstance3D *p_mesh, const Color &p_tint = Color(0, 0, 0, 0), float p_thickness_scale = 1.0f);
+    void remove_outline(GeometryInstance3D *p_mesh);
+    bool has_outline(GeometryInstance3D *p_mesh) const;
+    void set_outline_tint(GeometryInstance3D *p_mesh, const Color &p_tint);
+    void set_outline_thickness_scale(GeometryInstance3D *p_mesh, float p_scale);
+
+    int get_outline_count() const;
+    int get_shown_count() const;
+
+    // Connected to RenderingServer.frame_pre_draw
+    void _update();
+};
+
+} // namespace godot
+
+#endif // OUTLINE_MANAGER_H
@@ -0,0 +1,198 @@
+#include "physics_shape_registry.h"
+
+#include <godot_cpp/classes/static_body2d.hpp>
+#include <godot_cpp/classes/rigid_body2d.hpp>
+#include <godot_cpp/classes/character_body2d.hpp>
+#include <godot_cpp/classes/animatable_body2d.hpp>
+#include <godot_cpp/classes/collision_shape2d.hpp>
+#include <godot_cpp/classes/collision_polygon2d.hpp>
+#include <godot_cpp/classes/rectangle_shape2d.hpp>
+#include <godot_cpp/classes/circle_shape2d.hpp>
+
+using namespace godot;
+
+// Same body types the old per-frame tree walk looked for
+int PhysicsShapeRegistry::_body_ancestor_kind(Node *p_node) {
+    for (Node *n = p_node->get_parent(); n; n = n->get_parent()) {
+        if (Object::cast_to<RigidBody2D>(n) ||
+            Object::cast_to<CharacterBody2D>(n) ||
+            Object::cast_to<AnimatableBody2D>(n))
+        {
+            return 2;
+        }
+        if (Object::cast_to<StaticBody2D>(n)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+Rect2 PhysicsShapeRegistry::_compute_local_bounds(const Entry &p_entry) {
+    if (p_entry.kind == SHAPE_RECT) {
+        Vector2 size = static_cast<RectangleShape2D *>(*p_entry.shape)->get_size();
+        return Rect2(-size * 0.5f, size);
+    }
+    if (p_entry.kind == SHAPE_CIRCLE) {
+        float radius = static_cast<CircleShape2D *>(*p_entry.shape)->get_radius();
+        return Rect2(-radius, -radius, radius * 2.0f, radius * 2.0f);
+    }
+    if (p_entry.kind == SHAPE_POLYGON && p_entry.polygon.size() > 0) {
+        Rect2 bounds(p_entry.polygon[0], Vector2());
+        for (int i = 1; i < p_entry.polygon.size(); i++) {
+            bounds.expand_to(p_entry.polygon[i]);
+        }
+        return bounds;
+    }
+    // Unknown shapes only draw a label at the origin
+    return Rect2();
+}
+
+LooseQuadtree::Box PhysicsShapeRegistry::_to_box(const Rect2 &p_rect) {
+    LooseQuadtree::Box box;
+    box.min_x = p_rect.position.x;
+    box.min_y = p_rect.position.y;
+    box.max_x = p_rect.position.x + p_rect.size.x;
+    box.max_y = p_rect.position.y + p_rect.size.y;
+    return box;
+}
+
+// Kind and shape resource of a CollisionShape2D entry
+void PhysicsShapeRegistry::_read_shape(Entry &r_entry) {
+    r_entry.shape = static_cast<CollisionShape2D *>(r_entry.node)->get_shape();
+    r_entry.kind = SHAPE_UNKNOWN;
+    if (Object::cast_to<RectangleShape2D>(*r_entry.shape)) {
+        r_entry.kind = SHAPE_RECT;
+    } else if (Object::cast_to<CircleShape2D>(*r_entry.shape)) {
+        r_entry.kind = SHAPE_CIRCLE;
+    }
+}
+
+bool PhysicsShapeRegistry::add_node(Node *p_node) {
+    // Nodes still on their way into the tree have no global transform yet;
+    // node_added brings them in once they are inside
+    if (!p_node || !p_node->is_inside_tree()) return false;
+
+    Entry entry;
+    if (CollisionShape2D *cshape = Object::cast_to<CollisionShape2D>(p_node)) {
+        entry.node = cshape;
+        _read_shape(entry);
+    } else if (CollisionPolygon2D *cpoly = Object::cast_to<CollisionPolygon2D>(p_node)) {
+        entry.node = cpoly;
+        entry.kind = SHAPE_POLYGON;
+        entry.polygon = cpoly->get_polygon();
+    } else {
+        return false;
+    }
+
+    int body_kind = _body_ancestor_kind(p_node);
+    if (body_kind == 0) return false;
+
+    uint64_t id = p_node->get_instance_id();
+    if (index_by_id.count(id)) return false;
+
+    entry.moving = body_kind == 2;
+    entry.local_bounds = _compute_local_bounds(entry);
+    entry.last_xform = entry.node->get_global_transform();
+    entry.tree_handle = tree.insert(_to_box(entry.last_xform.xform(entry.local_bounds)), (int)entries.size());
+    ERR_FAIL_COND_V_MSG(entry.tree_handle < 0, false, "PhysicsShapeRegistry: " + String(p_node->get_path()) + " has non-finite bounds");
+
+    index_by_id[id] = (int)entries.size();
+    entries.push_back(entry);
+    if (entry.moving) moving_dirty = true;
+    return true;
+}
+
+// Swap-remove so the list stays dense
+void PhysicsShapeRegistry::remove_node(Node *p_node) {
+    if (!p_node) return;
+
+    auto it = index_by_id.find(p_node->get_instance_id());
+    if (it == index_by_id.end()) return;
+
+    int index = it->second;
+    int last = (int)entries.size() - 1;
+    index_by_id.erase(it);
+    tree.remove(entries[index].tree_handle);
+    if (entries[index].moving || entries[last].moving) moving_dirty = true;
+    if (index != last) {
+        entries[index] = entries[last];
+        index_by_id[entries[index].node->get_instance_id()] = index;
+        tree.set_user(entries[index].tree_handle, index);
+    }
+    entries.pop_back();
+}
+
+void PhysicsShapeRegistry::scan(Node *p_root) {
+    if (!p_root || !p_root->is_inside_tree()) return;
+    add_node(p_root);
+    int cc = p_root->get_child_count();
+    for (int i = 0; i < cc; i++) {
+        scan(p_root->get_child(i));
+    }
+}
+
+void PhysicsShapeRegistry::clear() {
+    entries.clear();
+    index_by_id.clear();
+    moving_entries.clear();
+    moving_dirty = false;
+    sync_cursor = 0;
+    tree.clear();
+}
+
+bool PhysicsShapeRegistry::sync_entry(int p_index) {
+    Entry &entry = entries[p_index];
+    bool changed = false;
+
+    if (entry.kind == SHAPE_POLYGON) {
+        // get_polygon shares the node's buffer, so an unchanged polygon has the same data pointer
+        PackedVector2Array current = static_cast<CollisionPolygon2D *>(entry.node)->get_polygon();
+        if (current.ptr() != entry.polygon.ptr()) {
+            changed = current != entry.polygon;
+            entry.polygon = current;
+        }
+    } else if (static_cast<CollisionShape2D *>(entry.node)->get_shape() != entry.shape) {
+        _read_shape(entry);
+        changed = true;
+    }
+
+    // Also catches a resized RectangleShape2D / CircleShape2D
+    Rect2 bounds = _compute_local_bounds(entry);
+    if (bounds != entry.local_bounds) {
+        entry.local_bounds = bounds;
+        tree.update(entry.tree_handle, _to_box(entry.last_xform.xform(bounds)));
+        changed = true;
+    }
+    return changed;
+}
+
+void PhysicsShapeRegistry::sync_some(int p_budget) {
+    const int count = (int)entries.size();
+    for (int i = 0; i < MIN(p_budget, count); i++) {
+        if (sync_cursor >= count) sync_cursor = 0;
+        sync_entry(sync_cursor++);
+    }
+}
+
+void PhysicsShapeRegistry::refresh_moving() {
+    if (moving_dirty) {
+        moving_entries.clear();
+        for (int i = 0; i < (int)entries.size(); i++) {
+            if (entries[i].moving) moving_entries.push_back(i);
+        }
+        moving_dirty = false;
+    }
+
+    for (int index : moving_entries) {
+        Entry &entry = entries[index];
+        Transform2D xform = entry.node->get_global_transform();
+        if (xform == entry.last_xform) continue;
+
+        entry.last_xform = xform;
+        tree.update(entry.tree_handle, _to_box(xform.xform(entry.local_bounds)));
+    }
+}
+
+void PhysicsShapeRegistry::query(const Rect2 &p_rect, std::vector<int> &r_indices) const {
+    tree.query(_to_box(p_rect), r_indices);
+}
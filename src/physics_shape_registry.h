@@ -0,0 +1,86 @@
+#ifndef PHYSICS_SHAPE_REGISTRY_H
+#define PHYSICS_SHAPE_REGISTRY_H
+
+#include <godot_cpp/classes/node2d.hpp>
+#include <godot_cpp/classes/shape2d.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/transform2d.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+#include "loose_quadtree.h"
+
+namespace godot {
+
+// Flat list of the collision shapes that belong to 2D physics bodies.
+// Fed incrementally (SceneTree node_added / node_removed) so nobody has to walk
+// the scene every frame; per frame only the cached entries are read.
+// World bounds of every entry are kept in a loose quadtree so callers can ask
+// for just the shapes inside a rect; only shapes under moving bodies are refreshed.
+class PhysicsShapeRegistry {
+public:
+    enum ShapeKind {
+        SHAPE_RECT = 0,
+        SHAPE_CIRCLE,
+        SHAPE_POLYGON,   // CollisionPolygon2D node
+        SHAPE_UNKNOWN
+    };
+
+    struct Entry {
+        Node2D *node = nullptr;   // CollisionShape2D or CollisionPolygon2D, valid while registered
+        ShapeKind kind = SHAPE_UNKNOWN;
+        Ref<Shape2D> shape;       // cached shape resource (CollisionShape2D only)
+        PackedVector2Array polygon; // cached local points (CollisionPolygon2D only)
+        Rect2 local_bounds;       // shape bounds in the node's local space
+        Transform2D last_xform;   // global transform the tree bounds were built from
+        bool moving = false;      // owned by a rigid, character or animatable body
+        int tree_handle = -1;
+    };
+
+    // Register p_node if it is a collision shape owned by a physics body and
+    // inside the tree. Returns true when it was added.
+    bool add_node(Node *p_node);
+    void remove_node(Node *p_node);
+
+    // Register every shape under p_root that is already inside the tree (used
+    // once when the registry starts; the rest arrive through node_added)
+    void scan(Node *p_root);
+    void clear();
+
+    // Re-read global transforms of shapes under moving bodies and update the
+    // spatial index for those that changed. Static shapes are never touched.
+    void refresh_moving();
+
+    // Re-read the shape resource / polygon of one entry, and its bounds, in case
+    // set_shape, set_polygon or a resize changed them. Returns true on a change.
+    bool sync_entry(int p_index);
+    // sync_entry on up to p_budget entries, continuing where the last call
+    // stopped, so shapes off screen catch up too
+    void sync_some(int p_budget);
+
+    // Appends indices (into get_entries()) of shapes whose bounds overlap p_rect
+    void query(const Rect2 &p_rect, std::vector<int> &r_indices) const;
+
+    const std::vector<Entry> &get_entries() const { return entries; }
+    int size() const { return (int)entries.size(); }
+
+private:
+    // 0 = no physics body above p_node, 1 = static body, 2 = moving body
+    static int _body_ancestor_kind(Node *p_node);
+    static Rect2 _compute_local_bounds(const Entry &p_entry);
+    static void _read_shape(Entry &r_entry);
+    static LooseQuadtree::Box _to_box(const Rect2 &p_rect);
+
+    std::vector<Entry> entries;
+    std::unordered_map<uint64_t, int> index_by_id; // instance id -> index in entries
+    std::vector<int> moving_entries;                // indices of entries with moving == true, rebuilt lazily
+    bool moving_dirty = false;
+    int sync_cursor = 0;
+    LooseQuadtree tree;
+};
+
+} // namespace godot
+
+#endif // PHYSICS_SHAPE_REGISTRY_H
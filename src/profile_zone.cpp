@@ -0,0 +1,175 @@
+#include "profile_zone.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace godot;
+
+std::atomic<bool> ProfileCapture::active{ false };
+std::atomic<uint32_t> ProfileCapture::epoch{ 0 };
+std::atomic<uint64_t> ProfileCapture::origin_ns{ 0 };
+std::mutex ProfileCapture::registry_mutex;
+std::vector<ProfileCapture::ThreadBuffer *> ProfileCapture::buffers;
+std::vector<std::pair<std::string, ProfileCapture::ThreadBuffer *>> ProfileCapture::tracks;
+
+uint64_t ProfileCapture::now_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+ProfileCapture::ThreadBuffer *ProfileCapture::_get_thread_buffer() {
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer) {
+        buffer = new ThreadBuffer();
+        buffer->events.reset(new ProfileEvent[EVENTS_PER_THREAD]);
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        buffer->thread_index = (uint32_t)buffers.size() + 1;
+        buffer->thread_name = "Thread " + std::to_string(buffer->thread_index);
+        buffers.push_back(buffer);
+    }
+    return buffer;
+}
+
+ProfileCapture::Track ProfileCapture::get_track(const char *p_name) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const std::pair<std::string, ThreadBuffer *> &track : tracks) {
+        if (track.first == p_name) return track.second;
+    }
+
+    ThreadBuffer *buffer = new ThreadBuffer();
+    buffer->events.reset(new ProfileEvent[EVENTS_PER_THREAD]);
+    buffer->thread_index = (uint32_t)buffers.size() + 1;
+    buffer->thread_name = p_name;
+    buffers.push_back(buffer);
+    tracks.emplace_back(p_name, buffer);
+    return buffer;
+}
+
+void ProfileCapture::set_thread_name(const char *p_name) {
+    ThreadBuffer *buffer = _get_thread_buffer();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer->thread_name = p_name;
+}
+
+void ProfileCapture::start() {
+    // Buffers from the old epoch are reset by their own thread on next record
+    origin_ns.store(now_ns(), std::memory_order_relaxed);
+    epoch.fetch_add(1, std::memory_order_release);
+    active.store(true, std::memory_order_release);
+}
+
+void ProfileCapture::stop() {
+    active.store(false, std::memory_order_release);
+}
+
+void ProfileCapture::record(const char *p_name, uint64_t p_start_ns, uint64_t p_end_ns) {
+    _append(_get_thread_buffer(), p_name, p_start_ns, p_end_ns);
+}
+
+void ProfileCapture::record_on_track(Track p_track, const char *p_name, uint64_t p_start_ns, uint64_t p_end_ns) {
+    _append(p_track, p_name, p_start_ns, p_end_ns);
+}
+
+void ProfileCapture::_append(ThreadBuffer *p_buffer, const char *p_name, uint64_t p_start_ns, uint64_t p_end_ns) {
+    const uint32_t current = epoch.load(std::memory_order_acquire);
+    if (p_buffer->epoch.load(std::memory_order_relaxed) != current) {
+        p_buffer->count.store(0, std::memory_order_relaxed);
+        p_buffer->dropped.store(0, std::memory_order_relaxed);
+        p_buffer->epoch.store(current, std::memory_order_release);
+    }
+
+    const uint32_t index = p_buffer->count.load(std::memory_order_relaxed);
+    if (index >= EVENTS_PER_THREAD) {
+        p_buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ProfileEvent &event = p_buffer->events[index];
+    event.name = p_name;
+    event.start_ns = p_start_ns;
+    event.end_ns = p_end_ns;
+    p_buffer->count.store(index + 1, std::memory_order_release);
+}
+
+uint64_t ProfileCapture::get_event_count() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    const uint32_t current = epoch.load(std::memory_order_acquire);
+    uint64_t total = 0;
+    for (ThreadBuffer *buffer : buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) == current) {
+            total += buffer->count.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+uint64_t ProfileCapture::get_dropped_count() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    const uint32_t current = epoch.load(std::memory_order_acquire);
+    uint64_t total = 0;
+    for (ThreadBuffer *buffer : buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) == current) {
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+void ProfileCapture::copy_events(std::vector<ProfileEvent> &r_events) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    const uint32_t current = epoch.load(std::memory_order_acquire);
+    for (ThreadBuffer *buffer : buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) != current) continue;
+        const uint32_t count = buffer->count.load(std::memory_order_acquire);
+        r_events.insert(r_events.end(), buffer->events.get(), buffer->events.get() + count);
+    }
+}
+
+static void append_json_string(std::string &r_out, const char *p_text) {
+    r_out += '"';
+    for (const char *c = p_text; *c; c++) {
+        if (*c == '"' || *c == '\\') r_out += '\\';
+        r_out += *c;
+    }
+    r_out += '"';
+}
+
+std::string ProfileCapture::export_chrome_json() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    const uint32_t current = epoch.load(std::memory_order_acquire);
+    const uint64_t origin = origin_ns.load(std::memory_order_relaxed);
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    char number[96];
+
+    for (ThreadBuffer *buffer : buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) != current) continue;
+        const uint32_t count = buffer->count.load(std::memory_order_acquire);
+
+        // Thread name metadata so the viewer labels the track
+        if (!first) out += ",\n";
+        first = false;
+        snprintf(number, sizeof(number), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", buffer->thread_index);
+        out += number;
+        append_json_string(out, buffer->thread_name.c_str());
+        out += "}}";
+
+        for (uint32_t i = 0; i < count; i++) {
+            const ProfileEvent &event = buffer->events[i];
+            const uint64_t start = event.start_ns > origin ? event.start_ns - origin : 0;
+            const uint64_t duration = event.end_ns > event.start_ns ? event.end_ns - event.start_ns : 0;
+
+            out += ",\n{\"ph\":\"X\",\"pid\":1,\"name\":";
+            append_json_string(out, event.name);
+            snprintf(number, sizeof(number), ",\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    buffer->thread_index, start / 1000.0, duration / 1000.0);
+            out += number;
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
@@ -0,0 +1,115 @@
+#ifndef PROFILE_ZONE_H
+#define PROFILE_ZONE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// PROFILE_ZONE("name") times the enclosing scope while a capture is running.
+// The name must be a string literal (only the pointer is stored).
+// Build with profiling=no to compile every zone out.
+#ifdef GDE_PROFILING_ENABLED
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ::godot::ProfileZone PROFILE_ZONE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) ::godot::ProfileCapture::set_thread_name(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+namespace godot {
+
+struct ProfileEvent {
+    const char *name = nullptr;
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+};
+
+// Global capture state plus one event buffer per thread.
+// Recording never locks: each thread appends to its own buffer and publishes the
+// new count with a release store. The mutex is only taken the first time a
+// thread records, when a track is looked up and when exporting.
+class ProfileCapture {
+    struct ThreadBuffer;
+
+public:
+    static const uint32_t EVENTS_PER_THREAD = 1 << 16;
+
+    // A named track from get_track(); valid for the rest of the process
+    typedef ThreadBuffer *Track;
+
+    static bool is_active() { return active.load(std::memory_order_relaxed); }
+
+    // Starting a capture discards the previous one
+    static void start();
+    static void stop();
+
+    static uint64_t now_ns();
+    static void record(const char *p_name, uint64_t p_start_ns, uint64_t p_end_ns);
+    // A track of its own instead of the calling thread's, for spans that don't
+    // nest with the thread's zones (latencies, async work). Tracks are matched by
+    // name, and looking one up locks, so resolve it once and keep the handle.
+    static Track get_track(const char *p_name);
+    // A track must only be written by one thread at a time
+    static void record_on_track(Track p_track, const char *p_name, uint64_t p_start_ns, uint64_t p_end_ns);
+    static void set_thread_name(const char *p_name);
+
+    static uint64_t get_event_count();
+    static uint64_t get_dropped_count();
+
+    // Appends every event of the current capture (all threads); times are absolute
+    static void copy_events(std::vector<ProfileEvent> &r_events);
+
+    // Chrome trace event format, also opened by ui.perfetto.dev and chrome://tracing
+    static std::string export_chrome_json();
+
+private:
+    struct ThreadBuffer {
+        std::unique_ptr<ProfileEvent[]> events;
+        std::atomic<uint32_t> count{ 0 };
+        std::atomic<uint32_t> dropped{ 0 };
+        std::atomic<uint32_t> epoch{ 0 };  // capture this buffer's events belong to
+        uint32_t thread_index = 0;
+        std::string thread_name;
+    };
+
+    static ThreadBuffer *_get_thread_buffer();
+    static void _append(ThreadBuffer *p_buffer, const char *p_name, uint64_t p_start_ns, uint64_t p_end_ns);
+
+    static std::atomic<bool> active;
+    static std::atomic<uint32_t> epoch;
+    static std::atomic<uint64_t> origin_ns;
+    static std::mutex registry_mutex;
+    static std::vector<ThreadBuffer *> buffers; // never freed; one per thread that ever recorded, and per track
+    static std::vector<std::pair<std::string, ThreadBuffer *>> tracks;
+};
+
+// RAII helper behind PROFILE_ZONE
+class ProfileZone {
+public:
+    explicit ProfileZone(const char *p_name) :
+            name(p_name), recording(ProfileCapture::is_active()) {
+        if (recording) start_ns = ProfileCapture::now_ns();
+    }
+
+    ~ProfileZone() {
+        if (recording) ProfileCapture::record(name, start_ns, ProfileCapture::now_ns());
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *name;
+    bool recording;
+    uint64_t start_ns = 0;
+};
+
+} // namespace godot
+
+#endif // PROFILE_ZONE_H
@@ -0,0 +1,95 @@
+#include "proximity_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+ProximityGrid::ProximityGrid(float p_cell_size) {
+    cell_size = std::max(p_cell_size, 0.001f);
+    inv_cell_size = 1.0f / cell_size;
+}
+
+void ProximityGrid::set_cell_size(float p_cell_size) {
+    cell_size = std::max(p_cell_size, 0.001f);
+    inv_cell_size = 1.0f / cell_size;
+
+    cells.clear();
+    item_cells.clear();
+    for (const auto &entry : item_points) {
+        const uint64_t key = cell_key(entry.second.first, entry.second.second);
+        cells[key].push_back(entry.first);
+        item_cells[entry.first] = key;
+    }
+}
+
+int32_t ProximityGrid::_coord(float p_v) const {
+    return (int32_t)std::floor(p_v * inv_cell_size);
+}
+
+uint64_t ProximityGrid::cell_key(float p_x, float p_y) const {
+    return _pack(_coord(p_x), _coord(p_y));
+}
+
+void ProximityGrid::insert(uint64_t p_id, float p_x, float p_y) {
+    if (item_cells.count(p_id)) {
+        move(p_id, p_x, p_y);
+        return;
+    }
+    const uint64_t key = cell_key(p_x, p_y);
+    cells[key].push_back(p_id);
+    item_cells[p_id] = key;
+    item_points[p_id] = { p_x, p_y };
+}
+
+void ProximityGrid::move(uint64_t p_id, float p_x, float p_y) {
+    auto it = item_cells.find(p_id);
+    if (it == item_cells.end()) {
+        insert(p_id, p_x, p_y);
+        return;
+    }
+    item_points[p_id] = { p_x, p_y };
+
+    const uint64_t key = cell_key(p_x, p_y);
+    if (key == it->second) return;
+
+    std::vector<uint64_t> &old_cell = cells[it->second];
+    old_cell.erase(std::find(old_cell.begin(), old_cell.end(), p_id));
+    if (old_cell.empty()) cells.erase(it->second);
+
+    cells[key].push_back(p_id);
+    it->second = key;
+}
+
+void ProximityGrid::remove(uint64_t p_id) {
+    auto it = item_cells.find(p_id);
+    if (it == item_cells.end()) return;
+
+    std::vector<uint64_t> &cell = cells[it->second];
+    auto pos = std::find(cell.begin(), cell.end(), p_id);
+    *pos = cell.back();
+    cell.pop_back();
+    if (cell.empty()) cells.erase(it->second);
+
+    item_cells.erase(it);
+    item_points.erase(p_id);
+}
+
+void ProximityGrid::clear() {
+    cells.clear();
+    item_cells.clear();
+    item_points.clear();
+}
+
+void ProximityGrid::gather(float p_x, float p_y, int p_radius_cells, std::vector<uint64_t> &r_ids) const {
+    const int32_t cx = _coord(p_x);
+    const int32_t cy = _coord(p_y);
+    for (int32_t y = cy - p_radius_cells; y <= cy + p_radius_cells; y++) {
+        for (int32_t x = cx - p_radius_cells; x <= cx + p_radius_cells; x++) {
+            auto it = cells.find(_pack(x, y));
+            if (it != cells.end()) {
+                r_ids.insert(r_ids.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+}
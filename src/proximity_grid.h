@@ -0,0 +1,49 @@
+#ifndef PROXIMITY_GRID_H
+#define PROXIMITY_GRID_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace godot {
+
+// Uniform hash grid of points, independent of the engine types.
+// Answers "which items are in the cells around this point" without looking at
+// the items anywhere else, so far away items cost nothing per query.
+class ProximityGrid {
+public:
+    explicit ProximityGrid(float p_cell_size = 8.0f);
+
+    // Changing the cell size re-buckets every item
+    void set_cell_size(float p_cell_size);
+    float get_cell_size() const { return cell_size; }
+
+    void insert(uint64_t p_id, float p_x, float p_y);
+    void move(uint64_t p_id, float p_x, float p_y);
+    void remove(uint64_t p_id);
+    void clear();
+
+    // Cell key of a point; two points share a key iff they share a cell
+    uint64_t cell_key(float p_x, float p_y) const;
+
+    // Appends the ids in the (2 * p_radius_cells + 1)^2 cells centered on the point's cell
+    void gather(float p_x, float p_y, int p_radius_cells, std::vector<uint64_t> &r_ids) const;
+
+    int size() const { return (int)item_cells.size(); }
+
+private:
+    static uint64_t _pack(int32_t p_cx, int32_t p_cy) {
+        return ((uint64_t)(uint32_t)p_cx << 32) | (uint32_t)p_cy;
+    }
+    int32_t _coord(float p_v) const;
+
+    float cell_size;
+    float inv_cell_size;
+    std::unordered_map<uint64_t, std::vector<uint64_t>> cells;
+    std::unordered_map<uint64_t, uint64_t> item_cells; // id -> cell key
+    std::unordered_map<uint64_t, std::pair<float, float>> item_points; // for re-bucketing
+};
+
+} // namespace godot
+
+#endif // PROXIMITY_GRID_H
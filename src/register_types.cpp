@@ -12,6 +12,23 @@
 #include "outline_controller_3d.h"
 #include "minimap3d.h"
 #include "ai_orchestrator.h"
+#include "debug_draw.h"
+#include "frame_recorder.h"
+#include "native_profiler.h"
+#include "native_monitors.h"
+#include "stress_harness.h"
+#include "hover_system.h"
+#include "collectible_pool.h"
+#include "gem_magnet_3d.h"
+#include "outline_manager.h"
+#include "surface_registry.h"
+#include "surface_map.h"
+#include "mover_server.h"
+#include "game_event_bus.h"
+#include "input_snapshot.h"
+#include "input_buffer.h"
+#include "input_latency.h"
+#include "input_replay.h"
 
 
 #include "gdexample.h"
@@ -19,9 +36,26 @@
 #include <gdextension_interface.h>
 #include <godot_cpp/core/defs.hpp>
 #include <godot_cpp/godot.hpp>
+#include <godot_cpp/classes/engine.hpp>
 
 using namespace godot;
 
+static DebugDraw *debug_draw_singleton = nullptr;
+static FrameRecorder *frame_recorder_singleton = nullptr;
+static NativeProfiler *native_profiler_singleton = nullptr;
+static NativeMonitors *native_monitors = nullptr;
+static HoverSystem *hover_system_singleton = nullptr;
+static CollectiblePool *collectible_pool_singleton = nullptr;
+static OutlineManager *outline_manager_singleton = nullptr;
+static SurfaceRegistry *surface_registry_singleton = nullptr;
+static SurfaceMap *surface_map_singleton = nullptr;
+static KinematicMoverServer *mover_server_singleton = nullptr;
+static GameEventBus *game_event_bus_singleton = nullptr;
+static InputSnapshot *input_snapshot_singleton = nullptr;
+static InputBuffer *input_buffer_singleton = nullptr;
+static InputLatency *input_latency_singleton = nullptr;
+static InputReplay *input_replay_singleton = nullptr;
+
 void initialize_example_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
@@ -39,13 +73,181 @@ void initialize_example_module(ModuleInitializationLevel p_level) {
 	GDREGISTER_CLASS(OutlineController3D);
 	GDREGISTER_CLASS(MiniMap3D);
 	GDREGISTER_CLASS(AIOrchestrator);
+	GDREGISTER_CLASS(DebugDraw);
+	GDREGISTER_CLASS(FrameRecorder);
+	GDREGISTER_CLASS(NativeProfiler);
+	GDREGISTER_CLASS(NativeMonitors);
+	GDREGISTER_CLASS(StressHarness);
+	GDREGISTER_CLASS(HoverSystem);
+	GDREGISTER_CLASS(CollectiblePool);
+	GDREGISTER_CLASS(GemMagnet3D);
+	GDREGISTER_CLASS(OutlineManager);
+	GDREGISTER_CLASS(SurfaceLibrary);
+	GDREGISTER_CLASS(SurfaceRegistry);
+	GDREGISTER_CLASS(SurfaceMap);
+	GDREGISTER_CLASS(KinematicMoverServer);
+	GDREGISTER_CLASS(GameEventBus);
+	GDREGISTER_CLASS(InputSnapshot);
+	GDREGISTER_CLASS(InputBuffer);
+	GDREGISTER_CLASS(InputBufferListener);
+	GDREGISTER_CLASS(InputLatency);
+	GDREGISTER_CLASS(InputReplay);
+
+	// Global immediate-mode debug drawing, reachable from GDScript as DebugDraw
+	debug_draw_singleton = memnew(DebugDraw);
+	Engine::get_singleton()->register_singleton("DebugDraw", debug_draw_singleton);
+
+	// Ring of recent frame timings, dumps spikes to user://frame_spikes
+	frame_recorder_singleton = memnew(FrameRecorder);
+	Engine::get_singleton()->register_singleton("FrameRecorder", frame_recorder_singleton);
+
+	// Start/stop/save of PROFILE_ZONE captures from scripts
+	native_profiler_singleton = memnew(NativeProfiler);
+	Engine::get_singleton()->register_singleton("NativeProfiler", native_profiler_singleton);
+
+	// Native counters in the editor's Monitors tab
+	native_monitors = memnew(NativeMonitors);
+	native_monitors->add_monitors();
+
+	// Batched bobbing of FloatingItem and gem visuals
+	hover_system_singleton = memnew(HoverSystem);
+	Engine::get_singleton()->register_singleton("HoverSystem", hover_system_singleton);
+
+	// Recycled gems, FloatingItems and pickup particles
+	collectible_pool_singleton = memnew(CollectiblePool);
+	Engine::get_singleton()->register_singleton("CollectiblePool", collectible_pool_singleton);
+
+	// Shared-material outlines with per-instance uniforms and distance LOD
+	outline_manager_singleton = memnew(OutlineManager);
+	Engine::get_singleton()->register_singleton("OutlineManager", outline_manager_singleton);
+
+	// One shared PhysicsMaterial per CustomSurface type
+	surface_registry_singleton = memnew(SurfaceRegistry);
+	Engine::get_singleton()->register_singleton("SurfaceRegistry", surface_registry_singleton);
+
+	// Surface type at a world position, baked from CustomSurface bodies
+	surface_map_singleton = memnew(SurfaceMap);
+	Engine::get_singleton()->register_singleton("SurfaceMap", surface_map_singleton);
+
+	// Batched AutoMover and other patrol movement, written straight to the servers
+	mover_server_singleton = memnew(KinematicMoverServer);
+	Engine::get_singleton()->register_singleton("KinematicMoverServer", mover_server_singleton);
+
+	// Score/pickup/damage events from any thread, dispatched on the main thread
+	game_event_bus_singleton = memnew(GameEventBus);
+	Engine::get_singleton()->register_singleton("GameEventBus", game_event_bus_singleton);
 
+	// Action bitmasks and axes polled once per frame and physics tick for all input nodes
+	input_snapshot_singleton = memnew(InputSnapshot);
+	Engine::get_singleton()->register_singleton("InputSnapshot", input_snapshot_singleton);
+
+	// Timestamped input events folded into one command per physics tick
+	input_buffer_singleton = memnew(InputBuffer);
+	Engine::get_singleton()->register_singleton("InputBuffer", input_buffer_singleton);
+
+	// Input to drawn frame latency histograms
+	input_latency_singleton = memnew(InputLatency);
+	Engine::get_singleton()->register_singleton("InputLatency", input_latency_singleton);
+
+	// Per-tick input recording and headless replay (--record= / --replay=)
+	input_replay_singleton = memnew(InputReplay);
+	Engine::get_singleton()->register_singleton("InputReplay", input_replay_singleton);
 }
 
 void uninitialize_example_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+	if (input_replay_singleton) {
+		Engine::get_singleton()->unregister_singleton("InputReplay");
+		memdelete(input_replay_singleton);
+		input_replay_singleton = nullptr;
+	}
+
+	if (input_latency_singleton) {
+		Engine::get_singleton()->unregister_singleton("InputLatency");
+		memdelete(input_latency_singleton);
+		input_latency_singleton = nullptr;
+	}
+
+	if (input_buffer_singleton) {
+		Engine::get_singleton()->unregister_singleton("InputBuffer");
+		memdelete(input_buffer_singleton);
+		input_buffer_singleton = nullptr;
+	}
+
+	if (input_snapshot_singleton) {
+		Engine::get_singleton()->unregister_singleton("InputSnapshot");
+		memdelete(input_snapshot_singleton);
+		input_snapshot_singleton = nullptr;
+	}
+
+	if (game_event_bus_singleton) {
+		Engine::get_singleton()->unregister_singleton("GameEventBus");
+		memdelete(game_event_bus_singleton);
+		game_event_bus_singleton = nullptr;
+	}
+
+	if (mover_server_singleton) {
+		Engine::get_singleton()->unregister_singleton("KinematicMoverServer");
+		memdelete(mover_server_singleton);
+		mover_server_singleton = nullptr;
+	}
+
+	if (surface_map_singleton) {
+		Engine::get_singleton()->unregister_singleton("SurfaceMap");
+		memdelete(surface_map_singleton);
+		surface_map_singleton = nullptr;
+	}
+
+	if (surface_registry_singleton) {
+		Engine::get_singleton()->unregister_singleton("SurfaceRegistry");
+		memdelete(surface_registry_singleton);
+		surface_registry_singleton = nullptr;
+	}
+
+	if (outline_manager_singleton) {
+		Engine::get_singleton()->unregister_singleton("OutlineManager");
+		memdelete(outline_manager_singleton);
+		outline_manager_singleton = nullptr;
+	}
+
+	if (collectible_pool_singleton) {
+		Engine::get_singleton()->unregister_singleton("CollectiblePool");
+		memdelete(collectible_pool_singleton);
+		collectible_pool_singleton = nullptr;
+	}
+
+	if (hover_system_singleton) {
+		Engine::get_singleton()->unregister_singleton("HoverSystem");
+		memdelete(hover_system_singleton);
+		hover_system_singleton = nullptr;
+	}
+
+	if (native_monitors) {
+		native_monitors->remove_monitors();
+		memdelete(native_monitors);
+		native_monitors = nullptr;
+	}
+
+	if (native_profiler_singleton) {
+		Engine::get_singleton()->unregister_singleton("NativeProfiler");
+		memdelete(native_profiler_singleton);
+		native_profiler_singleton = nullptr;
+	}
+
+	if (frame_recorder_singleton) {
+		Engine::get_singleton()->unregister_singleton("FrameRecorder");
+		memdelete(frame_recorder_singleton);
+		frame_recorder_singleton = nullptr;
+	}
+
+	if (debug_draw_singleton) {
+		Engine::get_singleton()->unregister_singleton("DebugDraw");
+		memdelete(debug_draw_singleton);
+		debug_draw_singleton = nullptr;
+	}
 }
 
 extern "C" {
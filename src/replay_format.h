@@ -0,0 +1,176 @@
+#ifndef REPLAY_FORMAT_H
+#define REPLAY_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace godot {
+
+// One input command in an InputReplay file, repeated for `run` physics ticks.
+// Amounts are quantized to 16 bits and only stored for the actions in
+// amount_mask, so an idle or steadily held tick costs 40 bytes however many
+// ticks it lasts. Everything is little-endian.
+struct ReplayRecord {
+    static const int MAX_ACTIONS = 64;
+
+    uint32_t run = 1;
+    uint64_t held = 0;
+    uint64_t pressed = 0;
+    uint64_t released = 0;
+    uint64_t amount_mask = 0;
+    uint16_t amounts[MAX_ACTIONS] = {};
+    float look_x = 0.0f;
+    float look_y = 0.0f;
+
+    static uint16_t quantize(float p_amount) {
+        if (p_amount <= 0.0f) return 0;
+        if (p_amount >= 1.0f) return 65535;
+        return (uint16_t)(p_amount * 65535.0f + 0.5f);
+    }
+
+    static float dequantize(uint16_t p_amount) {
+        return (float)p_amount / 65535.0f;
+    }
+
+    // Whether p_next can be folded into this record by bumping the run
+    bool continues_with(const ReplayRecord &p_next) const {
+        if (pressed || released || p_next.pressed || p_next.released) return false;
+        if (look_x != 0.0f || look_y != 0.0f || p_next.look_x != 0.0f || p_next.look_y != 0.0f) return false;
+        if (held != p_next.held || amount_mask != p_next.amount_mask) return false;
+        for (int i = 0; i < MAX_ACTIONS; i++) {
+            if (((amount_mask >> i) & 1) && amounts[i] != p_next.amounts[i]) return false;
+        }
+        return true;
+    }
+};
+
+class ReplayWriter {
+public:
+    static void put_u16(std::vector<uint8_t> &r_out, uint16_t p_value) {
+        r_out.push_back((uint8_t)p_value);
+        r_out.push_back((uint8_t)(p_value >> 8));
+    }
+
+    static void put_u32(std::vector<uint8_t> &r_out, uint32_t p_value) {
+        for (int i = 0; i < 4; i++) r_out.push_back((uint8_t)(p_value >> (8 * i)));
+    }
+
+    static void put_u64(std::vector<uint8_t> &r_out, uint64_t p_value) {
+        for (int i = 0; i < 8; i++) r_out.push_back((uint8_t)(p_value >> (8 * i)));
+    }
+
+    static void put_f32(std::vector<uint8_t> &r_out, float p_value) {
+        uint32_t bits;
+        memcpy(&bits, &p_value, 4);
+        put_u32(r_out, bits);
+    }
+
+    // Appends p_record, or lengthens the last record when it just repeats it
+    void add(const ReplayRecord &p_record) {
+        if (has_last && last.continues_with(p_record)) {
+            last.run++;
+            const uint32_t run = last.run;
+            for (int i = 0; i < 4; i++) bytes[last_offset + i] = (uint8_t)(run >> (8 * i));
+            return;
+        }
+
+        last = p_record;
+        last.run = 1;
+        has_last = true;
+        last_offset = bytes.size();
+
+        put_u32(bytes, last.run);
+        put_u64(bytes, last.held);
+        put_u64(bytes, last.pressed);
+        put_u64(bytes, last.released);
+        put_u64(bytes, last.amount_mask);
+        for (int i = 0; i < ReplayRecord::MAX_ACTIONS; i++) {
+            if ((last.amount_mask >> i) & 1) put_u16(bytes, last.amounts[i]);
+        }
+        const bool has_look = last.look_x != 0.0f || last.look_y != 0.0f;
+        bytes.push_back(has_look ? 1 : 0);
+        if (has_look) {
+            put_f32(bytes, last.look_x);
+            put_f32(bytes, last.look_y);
+        }
+    }
+
+    void clear() {
+        bytes.clear();
+        has_last = false;
+    }
+
+    const std::vector<uint8_t> &get_bytes() const { return bytes; }
+
+private:
+    std::vector<uint8_t> bytes;
+    ReplayRecord last;
+    size_t last_offset = 0;
+    bool has_last = false;
+};
+
+class ReplayReader {
+public:
+    ReplayReader(const uint8_t *p_data, size_t p_size) :
+            data(p_data), size(p_size) {}
+
+    bool get_u16(uint16_t &r_value) {
+        if (pos + 2 > size) return false;
+        r_value = (uint16_t)(data[pos] | (data[pos + 1] << 8));
+        pos += 2;
+        return true;
+    }
+
+    bool get_u32(uint32_t &r_value) {
+        if (pos + 4 > size) return false;
+        r_value = 0;
+        for (int i = 0; i < 4; i++) r_value |= (uint32_t)data[pos + i] << (8 * i);
+        pos += 4;
+        return true;
+    }
+
+    bool get_u64(uint64_t &r_value) {
+        if (pos + 8 > size) return false;
+        r_value = 0;
+        for (int i = 0; i < 8; i++) r_value |= (uint64_t)data[pos + i] << (8 * i);
+        pos += 8;
+        return true;
+    }
+
+    bool get_f32(float &r_value) {
+        uint32_t bits;
+        if (!get_u32(bits)) return false;
+        memcpy(&r_value, &bits, 4);
+        return true;
+    }
+
+    // False at the end of the data or on a truncated record
+    bool get_record(ReplayRecord &r_record) {
+        r_record = ReplayRecord();
+        if (!get_u32(r_record.run) || !get_u64(r_record.held) || !get_u64(r_record.pressed) ||
+                !get_u64(r_record.released) || !get_u64(r_record.amount_mask)) {
+            return false;
+        }
+        for (int i = 0; i < ReplayRecord::MAX_ACTIONS; i++) {
+            if (((r_record.amount_mask >> i) & 1) && !get_u16(r_record.amounts[i])) return false;
+        }
+        if (pos >= size) return false;
+        const bool has_look = data[pos++] != 0;
+        if (has_look && (!get_f32(r_record.look_x) || !get_f32(r_record.look_y))) return false;
+        return r_record.run > 0;
+    }
+
+    size_t get_position() const { return pos; }
+    void set_position(size_t p_pos) { pos = p_pos; }
+    bool at_end() const { return pos >= size; }
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t pos = 0;
+};
+
+} // namespace godot
+
+#endif // REPLAY_FORMAT_H
@@ -0,0 +1,654 @@
+#include "stress_harness.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/classes/node2d.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/viewport.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "profile_zone.h"
+
+using namespace godot;
+
+void StressHarness::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_target_scene", "path"), &StressHarness::set_target_scene);
+    ClassDB::bind_method(D_METHOD("get_target_scene"), &StressHarness::get_target_scene);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "target_scene", PROPERTY_HINT_FILE, "*.tscn"), "set_target_scene", "get_target_scene");
+
+    ClassDB::bind_method(D_METHOD("set_enemy_scene", "path"), &StressHarness::set_enemy_scene);
+    ClassDB::bind_method(D_METHOD("get_enemy_scene"), &StressHarness::get_enemy_scene);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "enemy_scene", PROPERTY_HINT_FILE, "*.tscn"), "set_enemy_scene", "get_enemy_scene");
+
+    ClassDB::bind_method(D_METHOD("set_gem_scene", "path"), &StressHarness::set_gem_scene);
+    ClassDB::bind_method(D_METHOD("get_gem_scene"), &StressHarness::get_gem_scene);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "gem_scene", PROPERTY_HINT_FILE, "*.tscn"), "set_gem_scene", "get_gem_scene");
+
+    ClassDB::bind_method(D_METHOD("set_projectile_scene", "path"), &StressHarness::set_projectile_scene);
+    ClassDB::bind_method(D_METHOD("get_projectile_scene"), &StressHarness::get_projectile_scene);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "projectile_scene", PROPERTY_HINT_FILE, "*.tscn"), "set_projectile_scene", "get_projectile_scene");
+
+    ClassDB::bind_method(D_METHOD("set_floating_item_scene", "path"), &StressHarness::set_floating_item_scene);
+    ClassDB::bind_method(D_METHOD("get_floating_item_scene"), &StressHarness::get_floating_item_scene);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "floating_item_scene", PROPERTY_HINT_FILE, "*.tscn"), "set_floating_item_scene", "get_floating_item_scene");
+
+    ClassDB::bind_method(D_METHOD("set_enemy_count", "count"), &StressHarness::set_enemy_count);
+    ClassDB::bind_method(D_METHOD("get_enemy_count"), &StressHarness::get_enemy_count);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "enemy_count", PROPERTY_HINT_RANGE, "0,2000,1,or_greater"), "set_enemy_count", "get_enemy_count");
+
+    ClassDB::bind_method(D_METHOD("set_gem_count", "count"), &StressHarness::set_gem_count);
+    ClassDB::bind_method(D_METHOD("get_gem_count"), &StressHarness::get_gem_count);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "gem_count", PROPERTY_HINT_RANGE, "0,5000,1,or_greater"), "set_gem_count", "get_gem_count");
+
+    ClassDB::bind_method(D_METHOD("set_projectile_count", "count"), &StressHarness::set_projectile_count);
+    ClassDB::bind_method(D_METHOD("get_projectile_count"), &StressHarness::get_projectile_count);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "projectile_count", PROPERTY_HINT_RANGE, "0,5000,1,or_greater"), "set_projectile_count", "get_projectile_count");
+
+    ClassDB::bind_method(D_METHOD("set_floating_item_count", "count"), &StressHarness::set_floating_item_count);
+    ClassDB::bind_method(D_METHOD("get_floating_item_count"), &StressHarness::get_floating_item_count);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "floating_item_count", PROPERTY_HINT_RANGE, "0,5000,1,or_greater"), "set_floating_item_count", "get_floating_item_count");
+
+    ClassDB::bind_method(D_METHOD("set_spawn_radius", "radius"), &StressHarness::set_spawn_radius);
+    ClassDB::bind_method(D_METHOD("get_spawn_radius"), &StressHarness::get_spawn_radius);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "spawn_radius"), "set_spawn_radius", "get_spawn_radius");
+
+    ClassDB::bind_method(D_METHOD("set_path_points", "points"), &StressHarness::set_path_points);
+    ClassDB::bind_method(D_METHOD("get_path_points"), &StressHarness::get_path_points);
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR3_ARRAY, "path_points"), "set_path_points", "get_path_points");
+
+    ClassDB::bind_method(D_METHOD("set_path_radius", "radius"), &StressHarness::set_path_radius);
+    ClassDB::bind_method(D_METHOD("get_path_radius"), &StressHarness::get_path_radius);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "path_radius"), "set_path_radius", "get_path_radius");
+
+    ClassDB::bind_method(D_METHOD("set_path_speed", "speed"), &StressHarness::set_path_speed);
+    ClassDB::bind_method(D_METHOD("get_path_speed"), &StressHarness::get_path_speed);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "path_speed"), "set_path_speed", "get_path_speed");
+
+    ClassDB::bind_method(D_METHOD("set_warmup_frames", "frames"), &StressHarness::set_warmup_frames);
+    ClassDB::bind_method(D_METHOD("get_warmup_frames"), &StressHarness::get_warmup_frames);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "warmup_frames"), "set_warmup_frames", "get_warmup_frames");
+
+    ClassDB::bind_method(D_METHOD("set_sample_frames", "frames"), &StressHarness::set_sample_frames);
+    ClassDB::bind_method(D_METHOD("get_sample_frames"), &StressHarness::get_sample_frames);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "sample_frames"), "set_sample_frames", "get_sample_frames");
+
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &StressHarness::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &StressHarness::get_seed);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+
+    ClassDB::bind_method(D_METHOD("set_output_path", "path"), &StressHarness::set_output_path);
+    ClassDB::bind_method(D_METHOD("get_output_path"), &StressHarness::get_output_path);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "output_path"), "set_output_path", "get_output_path");
+
+    ClassDB::bind_method(D_METHOD("set_quit_when_done", "quit"), &StressHarness::set_quit_when_done);
+    ClassDB::bind_method(D_METHOD("get_quit_when_done"), &StressHarness::get_quit_when_done);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quit_when_done"), "set_quit_when_done", "get_quit_when_done");
+
+    ClassDB::bind_method(D_METHOD("is_finished"), &StressHarness::is_finished);
+    ClassDB::bind_method(D_METHOD("get_summary"), &StressHarness::get_summary);
+}
+
+StressHarness::StressHarness() {
+}
+
+StressHarness::~StressHarness() {
+}
+
+void StressHarness::_ready() {
+    if (Engine::get_singleton()->is_editor_hint()) {
+        set_process(false);
+        set_physics_process(false);
+        return;
+    }
+
+    _apply_cmdline();
+
+    rng.instantiate();
+    rng->set_seed((uint64_t)seed);
+
+    Ref<PackedScene> level_packed = ResourceLoader::get_singleton()->load(target_scene);
+    if (level_packed.is_null()) {
+        _fail("StressHarness: cannot load target scene " + target_scene);
+        return;
+    }
+    level = level_packed->instantiate();
+    add_child(level);
+
+    player = Object::cast_to<Node3D>(get_tree()->get_first_node_in_group("Player"));
+    if (player) {
+        path_origin = player->get_global_position();
+    } else {
+        UtilityFunctions::push_warning("StressHarness: no node in group Player, the player path is disabled");
+    }
+
+    // A scene that doesn't load would measure an emptier fight than asked for
+    if (!_spawn_3d(enemy_scene, enemy_count, 6.0f, 1.0f) || !_spawn_3d(gem_scene, gem_count, 2.0f, 0.5f) ||
+            !_spawn_floating_items()) {
+        return;
+    }
+    if (projectile_count > 0) {
+        projectile_packed = ResourceLoader::get_singleton()->load(projectile_scene);
+        if (projectile_packed.is_null()) {
+            _fail("StressHarness: cannot load " + projectile_scene);
+            return;
+        }
+    }
+
+    rows.reserve(sample_frames);
+    running = true;
+    UtilityFunctions::print("StressHarness: ", target_scene, " with ", enemy_count, " enemies, ", gem_count, " gems, ",
+            projectile_count, " projectiles, ", floating_item_count, " floating items");
+}
+
+void StressHarness::_physics_process(double delta) {
+    if (!running || !player) return;
+
+    path_distance += path_speed * (float)delta;
+
+    // Loop through the waypoints at a constant speed
+    if (path_points.size() >= 2) {
+        float loop_length = 0.0f;
+        for (int i = 0; i < path_points.size(); i++) {
+            loop_length += path_points[i].distance_to(path_points[(i + 1) % path_points.size()]);
+        }
+        if (loop_length <= 0.0f) return;
+
+        float along = std::fmod(path_distance, loop_length);
+        for (int i = 0; i < path_points.size(); i++) {
+            const Vector3 a = path_points[i];
+            const Vector3 b = path_points[(i + 1) % path_points.size()];
+            const float length = a.distance_to(b);
+            if (along <= length) {
+                player->set_global_position(a.lerp(b, length > 0.0f ? along / length : 0.0f));
+                return;
+            }
+            along -= length;
+        }
+        return;
+    }
+
+    const float angle = path_distance / MAX(path_radius, 0.1f);
+    player->set_global_position(path_origin + Vector3(std::cos(angle), 0.0f, std::sin(angle)) * path_radius);
+}
+
+void StressHarness::_process(double delta) {
+    if (!running) return;
+
+    _top_up_projectiles();
+    _record_frame();
+    frames_seen++;
+
+    // Zones are only captured for the measured frames
+    if (frames_seen >= warmup_frames && !ProfileCapture::is_active()) {
+        ProfileCapture::start();
+    }
+
+    if ((int)rows.size() >= sample_frames) {
+        _finish();
+    }
+}
+
+// Overrides from the user arguments after "--", e.g. --enemies=200 --out=user://stress/big
+void StressHarness::_apply_cmdline() {
+    PackedStringArray args = OS::get_singleton()->get_cmdline_user_args();
+    for (int i = 0; i < args.size(); i++) {
+        const String arg = args[i];
+        const int eq = arg.find("=");
+        if (!arg.begins_with("--") || eq < 0) continue;
+
+        const String key = arg.substr(2, eq - 2);
+        const String value = arg.substr(eq + 1);
+        if (key == "scene") target_scene = value;
+        else if (key == "enemies") enemy_count = MAX(value.to_int(), 0);
+        else if (key == "gems") gem_count = MAX(value.to_int(), 0);
+        else if (key == "projectiles") projectile_count = MAX(value.to_int(), 0);
+        else if (key == "floating_items") floating_item_count = MAX(value.to_int(), 0);
+        else if (key == "radius") spawn_radius = value.to_float();
+        else if (key == "warmup") warmup_frames = MAX(value.to_int(), 0);
+        else if (key == "frames") sample_frames = MAX(value.to_int(), 1);
+        else if (key == "seed") seed = value.to_int();
+        else if (key == "out") output_path = value;
+        else if (key == "quit") quit_when_done = value != "false" && value != "0";
+        else UtilityFunctions::push_warning("StressHarness: unknown argument ", arg);
+    }
+}
+
+// Uniform over the ring between p_min_radius and spawn_radius
+Vector3 StressHarness::_random_ring_point(const Vector3 &p_center, float p_min_radius) {
+    const float outer = MAX(spawn_radius, p_min_radius);
+    const float angle = rng->randf_range(0.0f, Math_TAU);
+    const float r = std::sqrt(rng->randf_range(p_min_radius * p_min_radius, outer * outer));
+    return p_center + Vector3(std::cos(angle) * r, 0.0f, std::sin(angle) * r);
+}
+
+void StressHarness::_fail(const String &p_message) {
+    UtilityFunctions::push_error(p_message);
+    running = false;
+    set_process(false);
+    set_physics_process(false);
+    get_tree()->quit(1);
+}
+
+bool StressHarness::_spawn_3d(const String &p_scene, int p_count, float p_min_radius, float p_height) {
+    if (p_count <= 0) return true;
+
+    Ref<PackedScene> packed = ResourceLoader::get_singleton()->load(p_scene);
+    if (packed.is_null()) {
+        _fail("StressHarness: cannot load " + p_scene);
+        return false;
+    }
+
+    for (int i = 0; i < p_count; i++) {
+        Node *instance = packed->instantiate();
+        Node3D *node = Object::cast_to<Node3D>(instance);
+        if (!node) {
+            if (instance) memdelete(instance);
+            _fail("StressHarness: " + p_scene + " is not a 3D scene");
+            return false;
+        }
+        node->set_position(_random_ring_point(path_origin, p_min_radius) + Vector3(0.0f, p_height, 0.0f));
+        level->add_child(node);
+    }
+    return true;
+}
+
+// 2D pickups scattered over the visible canvas
+bool StressHarness::_spawn_floating_items() {
+    if (floating_item_count <= 0) return true;
+
+    Ref<PackedScene> packed = ResourceLoader::get_singleton()->load(floating_item_scene);
+    if (packed.is_null()) {
+        _fail("StressHarness: cannot load " + floating_item_scene);
+        return false;
+    }
+
+    const Rect2 view = get_viewport()->get_visible_rect();
+    for (int i = 0; i < floating_item_count; i++) {
+        Node *instance = packed->instantiate();
+        Node2D *item = Object::cast_to<Node2D>(instance);
+        if (!item) {
+            if (instance) memdelete(instance);
+            _fail("StressHarness: " + floating_item_scene + " is not a 2D scene");
+            return false;
+        }
+        item->set_position(view.position + Vector2(rng->randf() * view.size.x, rng->randf() * view.size.y));
+        level->add_child(item);
+    }
+    return true;
+}
+
+// Projectiles free themselves after their lifetime; replace the expired ones
+void StressHarness::_top_up_projectiles() {
+    if (projectile_packed.is_null()) return;
+
+    live_projectiles.erase(std::remove_if(live_projectiles.begin(), live_projectiles.end(),
+                                   [](uint64_t id) { return ObjectDB::get_instance(id) == nullptr; }),
+            live_projectiles.end());
+
+    const Vector3 target = player ? player->get_global_position() : path_origin;
+    while ((int)live_projectiles.size() < projectile_count) {
+        Node3D *projectile = Object::cast_to<Node3D>(projectile_packed->instantiate());
+        ERR_FAIL_NULL_MSG(projectile, "StressHarness: " + projectile_scene + " is not a 3D scene");
+
+        const Vector3 from = _random_ring_point(target, spawn_radius * 0.5f) + Vector3(0.0f, 1.0f, 0.0f);
+        Vector3 direction = target + Vector3(0.0f, 1.0f, 0.0f) - from;
+        projectile->set_position(from);
+        projectile->set("direction", direction.length_squared() > 0.0f ? direction.normalized() : Vector3(0, 0, -1));
+        level->add_child(projectile);
+        live_projectiles.push_back(projectile->get_instance_id());
+    }
+}
+
+void StressHarness::_record_frame() {
+    const uint64_t now = Time::get_singleton()->get_ticks_usec();
+    Performance *perf = Performance::get_singleton();
+
+    // Native counters are totals; keep the deltas current during warmup too
+    uint64_t delta[NativeStats::COUNTER_MAX];
+    for (int i = 0; i < NativeStats::COUNTER_MAX; i++) {
+        uint64_t total = NativeStats::get((NativeStats::Counter)i);
+        delta[i] = total - last_native[i];
+        last_native[i] = total;
+    }
+
+    // A row covers the time since the previous _process call
+    const uint64_t previous_usec = last_frame_usec;
+    const uint64_t previous_ns = last_frame_ns;
+    last_frame_usec = now;
+    last_frame_ns = ProfileCapture::now_ns();
+    if (frames_seen < warmup_frames || previous_usec == 0) return;
+
+    FrameRow row;
+    row.frame = Engine::get_singleton()->get_process_frames();
+    row.start_ns = previous_ns;
+    row.end_ns = last_frame_ns;
+    row.frame_ms = (float)(now - previous_usec) * 0.001f;
+    row.process_ms = (float)perf->get_monitor(Performance::TIME_PROCESS) * 1000.0f;
+    row.physics_ms = (float)perf->get_monitor(Performance::TIME_PHYSICS_PROCESS) * 1000.0f;
+    row.ai_ms = (float)delta[NativeStats::AI_DECISION_NSEC] * 1e-6f;
+    row.ai_decisions = (uint32_t)delta[NativeStats::AI_DECISIONS];
+    row.minimap_markers = (uint32_t)delta[NativeStats::MINIMAP_MARKERS];
+    row.orbit_bodies = (uint32_t)delta[NativeStats::ORBIT_BODIES];
+    row.debug_shapes = (uint32_t)delta[NativeStats::DEBUG_SHAPES];
+    row.projectiles = (uint32_t)live_projectiles.size();
+    row.physics_objects = (uint32_t)(perf->get_monitor(Performance::PHYSICS_2D_ACTIVE_OBJECTS) +
+                                     perf->get_monitor(Performance::PHYSICS_3D_ACTIVE_OBJECTS));
+    row.draw_calls = (uint32_t)perf->get_monitor(Performance::RENDER_TOTAL_DRAW_CALLS_IN_FRAME);
+    row.nodes = (uint32_t)perf->get_monitor(Performance::OBJECT_NODE_COUNT);
+    rows.push_back(row);
+}
+
+void StressHarness::_finish() {
+    running = false;
+    finished = true;
+    set_process(false);
+    set_physics_process(false);
+
+    _build_summary();
+    if (ProfileCapture::is_active()) {
+        ProfileCapture::stop();
+    }
+    _write_reports();
+
+    const Dictionary frame_ms = summary["frame_ms"];
+    UtilityFunctions::print("StressHarness: frame ms p50 ", frame_ms["p50"], "  p95 ", frame_ms["p95"], "  p99 ",
+            frame_ms["p99"], "  max ", frame_ms["max"]);
+
+    if (quit_when_done) {
+        get_tree()->quit();
+    }
+}
+
+// Nearest-rank percentiles; sorts p_values
+static Dictionary distribution(std::vector<double> &p_values) {
+    Dictionary result;
+    if (p_values.empty()) return result;
+
+    std::sort(p_values.begin(), p_values.end());
+    double sum = 0.0;
+    for (double v : p_values) sum += v;
+
+    auto rank = [&](double p_fraction) {
+        size_t index = (size_t)std::ceil(p_fraction * p_values.size());
+        return p_values[std::min(std::max(index, (size_t)1), p_values.size()) - 1];
+    };
+    result["mean"] = sum / p_values.size();
+    result["p50"] = rank(0.50);
+    result["p95"] = rank(0.95);
+    result["p99"] = rank(0.99);
+    result["max"] = p_values.back();
+    return result;
+}
+
+void StressHarness::_build_summary() {
+    summary.clear();
+    summary["scene"] = target_scene;
+    summary["seed"] = seed;
+    summary["enemies"] = enemy_count;
+    summary["gems"] = gem_count;
+    summary["projectiles"] = projectile_count;
+    summary["floating_items"] = floating_item_count;
+    summary["warmup_frames"] = warmup_frames;
+    summary["frames"] = (int64_t)rows.size();
+
+    std::vector<double> values(rows.size());
+    auto column = [&](const char *p_name, auto p_field) {
+        for (size_t i = 0; i < rows.size(); i++) values[i] = (double)(rows[i].*p_field);
+        summary[p_name] = distribution(values);
+    };
+    column("frame_ms", &FrameRow::frame_ms);
+    column("process_ms", &FrameRow::process_ms);
+    column("physics_ms", &FrameRow::physics_ms);
+    column("ai_ms", &FrameRow::ai_ms);
+
+    // Per-frame means are enough for the counters
+    Dictionary counters;
+    auto mean = [&](const char *p_name, uint32_t FrameRow::*p_field) {
+        double sum = 0.0;
+        for (const FrameRow &row : rows) sum += row.*p_field;
+        counters[p_name] = rows.empty() ? 0.0 : sum / rows.size();
+    };
+    mean("ai_decisions", &FrameRow::ai_decisions);
+    mean("minimap_markers", &FrameRow::minimap_markers);
+    mean("orbit_bodies", &FrameRow::orbit_bodies);
+    mean("debug_shapes", &FrameRow::debug_shapes);
+    mean("projectiles", &FrameRow::projectiles);
+    mean("physics_objects", &FrameRow::physics_objects);
+    mean("draw_calls", &FrameRow::draw_calls);
+    mean("nodes", &FrameRow::nodes);
+    summary["counters"] = counters;
+
+    summary["zones"] = _zone_breakdown();
+    summary["dropped_zone_events"] = (int64_t)ProfileCapture::get_dropped_count();
+}
+
+// Sums each PROFILE_ZONE name per measured frame, then takes percentiles over frames.
+// Empty unless the extension was built with profiling=yes.
+Dictionary StressHarness::_zone_breakdown() {
+    Dictionary zones;
+    std::vector<ProfileEvent> events;
+    ProfileCapture::copy_events(events);
+    if (events.empty() || rows.empty()) return zones;
+
+    std::vector<uint64_t> starts(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) starts[i] = rows[i].start_ns;
+
+    std::map<std::string, std::vector<double>> per_frame;
+    std::map<std::string, int64_t> calls;
+    for (const ProfileEvent &event : events) {
+        auto it = std::upper_bound(starts.begin(), starts.end(), event.start_ns);
+        if (it == starts.begin() || event.start_ns >= rows.back().end_ns) continue; // outside the measured frames
+
+        std::vector<double> &frames = per_frame[event.name];
+        if (frames.empty()) frames.resize(rows.size(), 0.0);
+        frames[(it - starts.begin()) - 1] += (double)(event.end_ns - event.start_ns) * 1e-6;
+        calls[event.name]++;
+    }
+
+    for (auto &entry : per_frame) {
+        Dictionary zone = distribution(entry.second);
+        zone["calls"] = calls[entry.first];
+        zones[String::utf8(entry.first.c_str())] = zone;
+    }
+    return zones;
+}
+
+void StressHarness::_write_reports() {
+    DirAccess::make_dir_recursive_absolute(output_path.get_base_dir());
+
+    const String csv_path = output_path + ".csv";
+    Ref<FileAccess> csv = FileAccess::open(csv_path, FileAccess::WRITE);
+    if (csv.is_null()) {
+        UtilityFunctions::push_warning("StressHarness: could not write ", csv_path);
+    } else {
+        csv->store_line("frame,frame_ms,process_ms,physics_ms,ai_ms,ai_decisions,minimap_markers,orbit_bodies,"
+                        "debug_shapes,projectiles,physics_objects,draw_calls,nodes");
+        for (const FrameRow &row : rows) {
+            csv->store_line(String::num_uint64(row.frame) + "," + String::num(row.frame_ms, 3) + "," +
+                            String::num(row.process_ms, 3) + "," + String::num(row.physics_ms, 3) + "," +
+                            String::num(row.ai_ms, 3) + "," + String::num_uint64(row.ai_decisions) + "," +
+                            String::num_uint64(row.minimap_markers) + "," + String::num_uint64(row.orbit_bodies) + "," +
+                            String::num_uint64(row.debug_shapes) + "," + String::num_uint64(row.projectiles) + "," +
+                            String::num_uint64(row.physics_objects) + "," + String::num_uint64(row.draw_calls) + "," +
+                            String::num_uint64(row.nodes));
+        }
+        csv->close();
+    }
+
+    const String json_path = output_path + ".json";
+    Ref<FileAccess> json = FileAccess::open(json_path, FileAccess::WRITE);
+    if (json.is_null()) {
+        UtilityFunctions::push_warning("StressHarness: could not write ", json_path);
+        return;
+    }
+    json->store_string(JSON::stringify(summary, "  "));
+    json->close();
+
+    UtilityFunctions::print("StressHarness: report written to ", ProjectSettings::get_singleton()->globalize_path(json_path));
+}
+
+bool StressHarness::is_finished() const {
+    return finished;
+}
+
+Dictionary StressHarness::get_summary() const {
+    return summary;
+}
+
+void StressHarness::set_target_scene(const String &p_path) {
+    target_scene = p_path;
+}
+
+String StressHarness::get_target_scene() const {
+    return target_scene;
+}
+
+void StressHarness::set_enemy_scene(const String &p_path) {
+    enemy_scene = p_path;
+}
+
+String StressHarness::get_enemy_scene() const {
+    return enemy_scene;
+}
+
+void StressHarness::set_gem_scene(const String &p_path) {
+    gem_scene = p_path;
+}
+
+String StressHarness::get_gem_scene() const {
+    return gem_scene;
+}
+
+void StressHarness::set_projectile_scene(const String &p_path) {
+    projectile_scene = p_path;
+}
+
+String StressHarness::get_projectile_scene() const {
+    return projectile_scene;
+}
+
+void StressHarness::set_floating_item_scene(const String &p_path) {
+    floating_item_scene = p_path;
+}
+
+String StressHarness::get_floating_item_scene() const {
+    return floating_item_scene;
+}
+
+void StressHarness::set_enemy_count(int p_count) {
+    enemy_count = MAX(p_count, 0);
+}
+
+int StressHarness::get_enemy_count() const {
+    return enemy_count;
+}
+
+void StressHarness::set_gem_count(int p_count) {
+    gem_count = MAX(p_count, 0);
+}
+
+int StressHarness::get_gem_count() const {
+    return gem_count;
+}
+
+void StressHarness::set_projectile_count(int p_count) {
+    projectile_count = MAX(p_count, 0);
+}
+
+int StressHarness::get_projectile_count() const {
+    return projectile_count;
+}
+
+void StressHarness::set_floating_item_count(int p_count) {
+    floating_item_count = MAX(p_count, 0);
+}
+
+int StressHarness::get_floating_item_count() const {
+    return floating_item_count;
+}
+
+void StressHarness::set_spawn_radius(float p_radius) {
+    spawn_radius = MAX(p_radius, 1.0f);
+}
+
+float StressHarness::get_spawn_radius() const {
+    return spawn_radius;
+}
+
+void StressHarness::set_path_points(const PackedVector3Array &p_points) {
+    path_points = p_points;
+}
+
+PackedVector3Array StressHarness::get_path_points() const {
+    return path_points;
+}
+
+void StressHarness::set_path_radius(float p_radius) {
+    path_radius = MAX(p_radius, 0.0f);
+}
+
+float StressHarness::get_path_radius() const {
+    return path_radius;
+}
+
+void StressHarness::set_path_speed(float p_speed) {
+    path_speed = p_speed;
+}
+
+float StressHarness::get_path_speed() const {
+    return path_speed;
+}
+
+void StressHarness::set_warmup_frames(int p_frames) {
+    warmup_frames = MAX(p_frames, 0);
+}
+
+int StressHarness::get_warmup_frames() const {
+    return warmup_frames;
+}
+
+void StressHarness::set_sample_frames(int p_frames) {
+    sample_frames = MAX(p_frames, 1);
+}
+
+int StressHarness::get_sample_frames() const {
+    return sample_frames;
+}
+
+void StressHarness::set_seed(int p_seed) {
+    seed = p_seed;
+}
+
+int StressHarness::get_seed() const {
+    return seed;
+}
+
+void StressHarness::set_output_path(const String &p_path) {
+    output_path = p_path;
+}
+
+String StressHarness::get_output_path() const {
+    return output_path;
+}
+
+void StressHarness::set_quit_when_done(bool p_quit) {
+    quit_when_done = p_quit;
+}
+
+bool StressHarness::get_quit_when_done() const {
+    return quit_when_done;
+}
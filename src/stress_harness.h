@@ -0,0 +1,162 @@
+#ifndef STRESS_HARNESS_H
+#define STRESS_HARNESS_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/packed_scene.hpp>
+#include <godot_cpp/classes/random_number_generator.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <vector>
+
+#include "native_stats.h"
+
+namespace godot {
+
+// Repeatable load test for the game scenes.
+// Instances a level, floods it with enemies, gems, projectiles and floating
+// items, walks the player along a scripted path and records per-frame timings.
+// After warmup_frames + sample_frames it writes <output_path>.csv (one row per
+// frame) and <output_path>.json (p50/p95/p99/max summary plus a per-zone
+// breakdown when built with profiling=yes) and quits.
+//
+// Headless run, every property can be overridden after "--":
+//   godot --headless --path game-engine-assignment res://scenes/stress_test.tscn -- --enemies=100 --frames=2000
+class StressHarness : public Node {
+    GDCLASS(StressHarness, Node);
+
+public:
+    struct FrameRow {
+        uint64_t frame = 0;
+        uint64_t start_ns = 0;      // ProfileCapture clock, used to bucket zones per frame
+        uint64_t end_ns = 0;
+        float frame_ms = 0.0f;
+        float process_ms = 0.0f;
+        float physics_ms = 0.0f;
+        float ai_ms = 0.0f;         // time spent in AIOrchestrator decisions
+        uint32_t ai_decisions = 0;
+        uint32_t minimap_markers = 0;
+        uint32_t orbit_bodies = 0;
+        uint32_t debug_shapes = 0;
+        uint32_t projectiles = 0;
+        uint32_t physics_objects = 0;
+        uint32_t draw_calls = 0;
+        uint32_t nodes = 0;
+    };
+
+private:
+    String target_scene = "res://scenes/main.tscn";
+    String enemy_scene = "res://scenes/mage.tscn";   // the enemy3d.gd enemy
+    String gem_scene = "res://scenes/magic_gem.tscn";
+    String projectile_scene = "res://scenes/mage_projectile.tscn";
+    String floating_item_scene = "res://scenes/floating_item.tscn";
+
+    int enemy_count = 50;
+    int gem_count = 200;
+    int projectile_count = 100;     // kept topped up, projectiles expire on their own
+    int floating_item_count = 100;
+    float spawn_radius = 20.0f;
+
+    // Player path: loops through path_points, or circles the spawn point when empty
+    PackedVector3Array path_points;
+    float path_radius = 8.0f;
+    float path_speed = 4.0f;
+
+    int warmup_frames = 60;
+    int sample_frames = 1200;
+    int seed = 12345;
+    String output_path = "user://stress/report";
+    bool quit_when_done = true;
+
+    Ref<RandomNumberGenerator> rng;
+    Ref<PackedScene> projectile_packed;
+    Node *level = nullptr;
+    Node3D *player = nullptr;
+    Vector3 path_origin;
+    float path_distance = 0.0f;
+    std::vector<uint64_t> live_projectiles; // instance ids
+
+    int frames_seen = 0;
+    bool running = false;
+    bool finished = false;
+    uint64_t last_frame_usec = 0;
+    uint64_t last_frame_ns = 0;
+    uint64_t last_native[NativeStats::COUNTER_MAX] = {};
+    std::vector<FrameRow> rows;
+    Dictionary summary;
+
+protected:
+    static void _bind_methods();
+
+public:
+    StressHarness();
+    ~StressHarness();
+
+    void _ready() override;
+    void _process(double delta) override;
+    void _physics_process(double delta) override;
+
+    void set_target_scene(const String &p_path);
+    String get_target_scene() const;
+    void set_enemy_scene(const String &p_path);
+    String get_enemy_scene() const;
+    void set_gem_scene(const String &p_path);
+    String get_gem_scene() const;
+    void set_projectile_scene(const String &p_path);
+    String get_projectile_scene() const;
+    void set_floating_item_scene(const String &p_path);
+    String get_floating_item_scene() const;
+
+    void set_enemy_count(int p_count);
+    int get_enemy_count() const;
+    void set_gem_count(int p_count);
+    int get_gem_count() const;
+    void set_projectile_count(int p_count);
+    int get_projectile_count() const;
+    void set_floating_item_count(int p_count);
+    int get_floating_item_count() const;
+    void set_spawn_radius(float p_radius);
+    float get_spawn_radius() const;
+
+    void set_path_points(const PackedVector3Array &p_points);
+    PackedVector3Array get_path_points() const;
+    void set_path_radius(float p_radius);
+    float get_path_radius() const;
+    void set_path_speed(float p_speed);
+    float get_path_speed() const;
+
+    void set_warmup_frames(int p_frames);
+    int get_warmup_frames() const;
+    void set_sample_frames(int p_frames);
+    int get_sample_frames() const;
+    void set_seed(int p_seed);
+    int get_seed() const;
+    void set_output_path(const String &p_path);
+    String get_output_path() const;
+    void set_quit_when_done(bool p_quit);
+    bool get_quit_when_done() const;
+
+    bool is_finished() const;
+    // Same content as the JSON report, empty until the run is done
+    Dictionary get_summary() const;
+
+private:
+    void _apply_cmdline();
+    Vector3 _random_ring_point(const Vector3 &p_center, float p_min_radius);
+    // Stop the run without a report and exit non-zero
+    void _fail(const String &p_message);
+    bool _spawn_3d(const String &p_scene, int p_count, float p_min_radius, float p_height);
+    bool _spawn_floating_items();
+    void _top_up_projectiles();
+    void _record_frame();
+    void _finish();
+    void _build_summary();
+    Dictionary _zone_breakdown();
+    void _write_reports();
+};
+
+} // namespace godot
+
+#endif // STRESS_HARNESS_H
@@ -0,0 +1,226 @@
+#include "surface_map.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/collision_polygon2d.hpp>
+#include <godot_cpp/classes/collision_shape2d.hpp>
+#include <godot_cpp/classes/shape2d.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "profile_zone.h"
+
+using namespace godot;
+
+SurfaceMap *SurfaceMap::singleton = nullptr;
+
+void SurfaceMap::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &SurfaceMap::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &SurfaceMap::get_cell_size);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size"), "set_cell_size", "get_cell_size");
+
+    ClassDB::bind_method(D_METHOD("set_skin", "skin"), &SurfaceMap::set_skin);
+    ClassDB::bind_method(D_METHOD("get_skin"), &SurfaceMap::get_skin);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "skin"), "set_skin", "get_skin");
+
+    ClassDB::bind_method(D_METHOD("add_body", "body", "type"), &SurfaceMap::add_body);
+    ClassDB::bind_method(D_METHOD("remove_body", "body"), &SurfaceMap::remove_body);
+    ClassDB::bind_method(D_METHOD("add_rect", "owner", "rect", "type"), &SurfaceMap::add_rect);
+    ClassDB::bind_method(D_METHOD("remove_owner", "owner"), &SurfaceMap::remove_owner);
+    ClassDB::bind_method(D_METHOD("clear"), &SurfaceMap::clear);
+
+    ClassDB::bind_method(D_METHOD("surface_at", "position"), &SurfaceMap::surface_at);
+    ClassDB::bind_method(D_METHOD("surface_at_3d", "position"), &SurfaceMap::surface_at_3d);
+    ClassDB::bind_method(D_METHOD("surfaces_at", "positions"), &SurfaceMap::surfaces_at);
+    ClassDB::bind_method(D_METHOD("get_cell_count"), &SurfaceMap::get_cell_count);
+}
+
+SurfaceMap *SurfaceMap::get_singleton() {
+    return singleton;
+}
+
+SurfaceMap::SurfaceMap() {
+    singleton = this;
+}
+
+SurfaceMap::~SurfaceMap() {
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void SurfaceMap::set_cell_size(float p_size) {
+    cell_size = MAX(p_size, 0.01f);
+    inv_cell_size = 1.0f / cell_size;
+    _rebake_all();
+}
+
+float SurfaceMap::get_cell_size() const {
+    return cell_size;
+}
+
+void SurfaceMap::set_skin(float p_skin) {
+    skin = MAX(p_skin, 0.0f);
+    _rebake_all();
+}
+
+float SurfaceMap::get_skin() const {
+    return skin;
+}
+
+uint64_t SurfaceMap::_key(float p_x, float p_y) const {
+    const int32_t cx = (int32_t)std::floor(p_x * inv_cell_size);
+    const int32_t cy = (int32_t)std::floor(p_y * inv_cell_size);
+    return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+}
+
+// Marks every cell the owner's (grown) rectangles touch
+void SurfaceMap::_bake(uint64_t p_owner, Owner &r_owner) {
+    r_owner.cells.clear();
+    for (const Rect2 &rect : r_owner.rects) {
+        const Rect2 grown = rect.grow(skin);
+        const int32_t x0 = (int32_t)std::floor(grown.position.x * inv_cell_size);
+        const int32_t y0 = (int32_t)std::floor(grown.position.y * inv_cell_size);
+        const int32_t x1 = (int32_t)std::floor(grown.get_end().x * inv_cell_size);
+        const int32_t y1 = (int32_t)std::floor(grown.get_end().y * inv_cell_size);
+        for (int32_t cy = y0; cy <= y1; cy++) {
+            for (int32_t cx = x0; cx <= x1; cx++) {
+                const uint64_t key = ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+                std::vector<uint64_t> &cell = cells[key];
+                if (std::find(cell.begin(), cell.end(), p_owner) != cell.end()) continue;
+                cell.push_back(p_owner);
+                r_owner.cells.push_back(key);
+            }
+        }
+    }
+}
+
+void SurfaceMap::_unbake(uint64_t p_owner, Owner &r_owner) {
+    for (uint64_t key : r_owner.cells) {
+        auto it = cells.find(key);
+        if (it == cells.end()) continue;
+        std::vector<uint64_t> &cell = it->second;
+        cell.erase(std::remove(cell.begin(), cell.end(), p_owner), cell.end());
+        if (cell.empty()) cells.erase(it);
+    }
+    r_owner.cells.clear();
+}
+
+// Oldest owner first, so each cell lists its owners in the order they were added
+void SurfaceMap::_rebake_all() {
+    std::vector<std::pair<uint64_t, uint64_t>> by_order;  // (order, owner)
+    by_order.reserve(owners.size());
+    for (const auto &entry : owners) {
+        by_order.emplace_back(entry.second.order, entry.first);
+    }
+    std::sort(by_order.begin(), by_order.end());
+
+    cells.clear();
+    for (const auto &entry : by_order) {
+        _bake(entry.second, owners[entry.second]);
+    }
+}
+
+// Whether the point is inside one of the owner's grown rectangles, edges included
+bool SurfaceMap::_covers(const Owner &p_owner, const Vector2 &p_position) const {
+    for (const Rect2 &rect : p_owner.rects) {
+        const Rect2 grown = rect.grow(skin);
+        const Vector2 end = grown.get_end();
+        if (p_position.x >= grown.position.x && p_position.x <= end.x && p_position.y >= grown.position.y &&
+                p_position.y <= end.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// World-space bounds of the body's collision shapes and polygons
+void SurfaceMap::_collect_rects(Node *p_body, std::vector<Rect2> &r_rects) {
+    for (int i = 0; i < p_body->get_child_count(); i++) {
+        Node *child = p_body->get_child(i);
+        if (CollisionShape2D *shape_node = Object::cast_to<CollisionShape2D>(child)) {
+            if (shape_node->is_disabled() || shape_node->get_shape().is_null()) continue;
+            r_rects.push_back(shape_node->get_global_transform().xform(shape_node->get_shape()->get_rect()));
+        } else if (CollisionPolygon2D *polygon_node = Object::cast_to<CollisionPolygon2D>(child)) {
+            const PackedVector2Array polygon = polygon_node->get_polygon();
+            if (polygon_node->is_disabled() || polygon.is_empty()) continue;
+            const Transform2D xform = polygon_node->get_global_transform();
+            Rect2 bounds(xform.xform(polygon[0]), Vector2());
+            for (int j = 1; j < polygon.size(); j++) {
+                bounds.expand_to(xform.xform(polygon[j]));
+            }
+            r_rects.push_back(bounds);
+        }
+    }
+}
+
+void SurfaceMap::add_body(Node *p_body, int p_type) {
+    ERR_FAIL_NULL(p_body);
+    PROFILE_ZONE("SurfaceMap::add_body");
+    const uint64_t id = p_body->get_instance_id();
+    remove_owner((int64_t)id);
+
+    Owner &owner = owners[id];
+    owner.type = p_type;
+    owner.order = next_order++;
+    _collect_rects(p_body, owner.rects);
+    _bake(id, owner);
+}
+
+void SurfaceMap::remove_body(Node *p_body) {
+    if (!p_body) return;
+    remove_owner((int64_t)p_body->get_instance_id());
+}
+
+void SurfaceMap::add_rect(int64_t p_owner, const Rect2 &p_rect, int p_type) {
+    Owner &owner = owners[(uint64_t)p_owner];
+    _unbake((uint64_t)p_owner, owner);
+    owner.type = p_type;
+    owner.order = next_order++;
+    owner.rects.push_back(p_rect.abs());
+    _bake((uint64_t)p_owner, owner);
+}
+
+void SurfaceMap::remove_owner(int64_t p_owner) {
+    auto it = owners.find((uint64_t)p_owner);
+    if (it == owners.end()) return;
+    _unbake(it->first, it->second);
+    owners.erase(it);
+}
+
+void SurfaceMap::clear() {
+    cells.clear();
+    owners.clear();
+}
+
+int SurfaceMap::surface_at(const Vector2 &p_position) const {
+    auto it = cells.find(_key(p_position.x, p_position.y));
+    if (it == cells.end()) return -1;
+    // A cell on a border is shared by both sides; newest first, the first that
+    // actually covers the point decides
+    const std::vector<uint64_t> &cell = it->second;
+    for (auto owner_it = cell.rbegin(); owner_it != cell.rend(); ++owner_it) {
+        const Owner &owner = owners.find(*owner_it)->second;
+        if (_covers(owner, p_position)) return owner.type;
+    }
+    return -1;
+}
+
+int SurfaceMap::surface_at_3d(const Vector3 &p_position) const {
+    return surface_at(Vector2(p_position.x, p_position.z));
+}
+
+PackedInt32Array SurfaceMap::surfaces_at(const PackedVector2Array &p_positions) const {
+    PackedInt32Array result;
+    result.resize(p_positions.size());
+    const Vector2 *src = p_positions.ptr();
+    int32_t *dst = result.ptrw();
+    for (int64_t i = 0; i < p_positions.size(); i++) {
+        dst[i] = surface_at(src[i]);
+    }
+    return result;
+}
+
+int SurfaceMap::get_cell_count() const {
+    return (int)cells.size();
+}
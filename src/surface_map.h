@@ -0,0 +1,87 @@
+#ifndef SURFACE_MAP_H
+#define SURFACE_MAP_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace godot {
+
+// Which surface type (SurfaceRegistry id) is at a world position, without a
+// physics query. CustomSurface bodies bake the cells touched by their collision
+// shapes' bounds (grown by `skin`, so something standing on top still counts)
+// when they enter the tree and un-bake them when they leave; surface_at() is
+// then a hash lookup plus a bounds test against the few owners of that cell. 3D floors or scripts can add rectangles on the
+// XZ plane through add_rect() and query with surface_at_3d().
+//
+// Where owners' grown bounds overlap the one added last wins. -1 means no surface.
+class SurfaceMap : public Object {
+    GDCLASS(SurfaceMap, Object);
+
+private:
+    static SurfaceMap *singleton;
+
+    float cell_size = 16.0f;
+    float inv_cell_size = 1.0f / 16.0f;
+    float skin = 4.0f;
+
+    struct Owner {
+        int type = -1;
+        uint64_t order = 0;             // when it was last added; re-bakes go oldest first
+        std::vector<Rect2> rects;
+        std::vector<uint64_t> cells;
+    };
+
+    // Owners covering each cell, most recent last
+    std::unordered_map<uint64_t, std::vector<uint64_t>> cells;
+    std::unordered_map<uint64_t, Owner> owners;
+    uint64_t next_order = 0;
+
+    uint64_t _key(float p_x, float p_y) const;
+    void _bake(uint64_t p_owner, Owner &r_owner);
+    void _unbake(uint64_t p_owner, Owner &r_owner);
+    void _rebake_all();
+    bool _covers(const Owner &p_owner, const Vector2 &p_position) const;
+    static void _collect_rects(Node *p_body, std::vector<Rect2> &r_rects);
+
+protected:
+    static void _bind_methods();
+
+public:
+    static SurfaceMap *get_singleton();
+
+    SurfaceMap();
+    ~SurfaceMap();
+
+    // Changing these re-bakes everything
+    void set_cell_size(float p_size);
+    float get_cell_size() const;
+    void set_skin(float p_skin);
+    float get_skin() const;
+
+    // Bakes a CustomSurface (or any CollisionObject2D) under the given type
+    void add_body(Node *p_body, int p_type);
+    void remove_body(Node *p_body);
+    // World-space rectangles for anything that isn't a 2D body (x/y or x/z)
+    void add_rect(int64_t p_owner, const Rect2 &p_rect, int p_type);
+    void remove_owner(int64_t p_owner);
+    void clear();
+
+    int surface_at(const Vector2 &p_position) const;
+    int surface_at_3d(const Vector3 &p_position) const;
+    PackedInt32Array surfaces_at(const PackedVector2Array &p_positions) const;
+
+    int get_cell_count() const;
+};
+
+} // namespace godot
+
+#endif // SURFACE_MAP_H
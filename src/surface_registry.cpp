@@ -0,0 +1,172 @@
+#include "surface_registry.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+
+#include <algorithm>
+
+using namespace godot;
+
+void SurfaceLibrary::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_materials", "materials"), &SurfaceLibrary::set_materials);
+    ClassDB::bind_method(D_METHOD("get_materials"), &SurfaceLibrary::get_materials);
+    ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "materials", PROPERTY_HINT_ARRAY_TYPE, "PhysicsMaterial"),
+            "set_materials", "get_materials");
+}
+
+void SurfaceLibrary::set_materials(const TypedArray<PhysicsMaterial> &p_materials) {
+    materials = p_materials;
+}
+
+TypedArray<PhysicsMaterial> SurfaceLibrary::get_materials() const {
+    return materials;
+}
+
+SurfaceRegistry *SurfaceRegistry::singleton = nullptr;
+
+void SurfaceRegistry::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_library_path", "path"), &SurfaceRegistry::set_library_path);
+    ClassDB::bind_method(D_METHOD("get_library_path"), &SurfaceRegistry::get_library_path);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "library_path", PROPERTY_HINT_FILE, "*.tres"), "set_library_path", "get_library_path");
+
+    ClassDB::bind_method(D_METHOD("load_library", "library"), &SurfaceRegistry::load_library);
+    ClassDB::bind_method(D_METHOD("register_type", "name", "friction", "bounce"), &SurfaceRegistry::register_type);
+    ClassDB::bind_method(D_METHOD("find_type", "name"), &SurfaceRegistry::find_type);
+    ClassDB::bind_method(D_METHOD("get_type_count"), &SurfaceRegistry::get_type_count);
+    ClassDB::bind_method(D_METHOD("get_type_name", "type"), &SurfaceRegistry::get_type_name);
+    ClassDB::bind_method(D_METHOD("get_friction", "type"), &SurfaceRegistry::get_friction);
+    ClassDB::bind_method(D_METHOD("get_bounce", "type"), &SurfaceRegistry::get_bounce);
+    ClassDB::bind_method(D_METHOD("get_material", "type"), &SurfaceRegistry::get_material);
+}
+
+SurfaceRegistry *SurfaceRegistry::get_singleton() {
+    return singleton;
+}
+
+SurfaceRegistry::SurfaceRegistry() {
+    singleton = this;
+}
+
+SurfaceRegistry::~SurfaceRegistry() {
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
+void SurfaceRegistry::set_library_path(const String &p_path) {
+    library_path = p_path;
+    library_loaded = false;
+    types.erase(std::remove_if(types.begin(), types.end(), [](const SurfaceType &p_type) { return p_type.from_library; }),
+            types.end());
+}
+
+String SurfaceRegistry::get_library_path() const {
+    return library_path;
+}
+
+// Materials are made on first use rather than at extension init
+void SurfaceRegistry::_ensure_types() {
+    if (types.empty()) {
+        // Same values CustomSurface always used
+        _add_type("Ice", 0.1f, 0.1f, Ref<PhysicsMaterial>());
+        _add_type("Sand", 0.9f, 0.0f, Ref<PhysicsMaterial>());
+        _add_type("Metal", 0.4f, 0.2f, Ref<PhysicsMaterial>());
+        _add_type("Rubber", 0.2f, 0.8f, Ref<PhysicsMaterial>());
+
+        fallback.name = "Default";
+        fallback.material.instantiate();
+        fallback.material->set_friction(fallback.friction);
+        fallback.material->set_bounce(fallback.bounce);
+    }
+
+    if (!library_loaded) {
+        library_loaded = true;
+        // Not FileAccess: exported builds only have the remapped/converted file
+        if (!library_path.is_empty() && ResourceLoader::get_singleton()->exists(library_path)) {
+            load_library(ResourceLoader::get_singleton()->load(library_path));
+        }
+    }
+}
+
+int SurfaceRegistry::_add_type(const StringName &p_name, float p_friction, float p_bounce, const Ref<PhysicsMaterial> &p_material) {
+    SurfaceType type;
+    type.name = p_name;
+    type.friction = p_friction;
+    type.bounce = p_bounce;
+    type.material = p_material;
+    if (type.material.is_null()) {
+        type.material.instantiate();
+        type.material->set_friction(p_friction);
+        type.material->set_bounce(p_bounce);
+        type.material->set_name(p_name);
+    }
+    types.push_back(type);
+    return (int)types.size() - 1;
+}
+
+const SurfaceRegistry::SurfaceType &SurfaceRegistry::_get(int p_type) {
+    _ensure_types();
+    // Unknown ids get the old default friction/bounce, as CustomSurface always did
+    if (p_type < 0 || p_type >= (int)types.size()) {
+        return fallback;
+    }
+    return types[p_type];
+}
+
+int SurfaceRegistry::load_library(const Ref<SurfaceLibrary> &p_library) {
+    ERR_FAIL_COND_V(p_library.is_null(), 0);
+    _ensure_types();
+
+    int added = 0;
+    TypedArray<PhysicsMaterial> materials = p_library->get_materials();
+    for (int i = 0; i < materials.size(); i++) {
+        Ref<PhysicsMaterial> material = materials[i];
+        if (material.is_null()) continue;
+        const StringName name = material->get_name();
+        ERR_CONTINUE_MSG(name.is_empty(), "SurfaceRegistry: library material without a resource_name");
+        if (find_type(name) >= 0) continue;
+
+        // The designer's material is the shared one
+        const int type = _add_type(name, material->get_friction(), material->get_bounce(), material);
+        types[type].from_library = true;
+        added++;
+    }
+    return added;
+}
+
+int SurfaceRegistry::register_type(const StringName &p_name, float p_friction, float p_bounce) {
+    const int existing = find_type(p_name);
+    if (existing >= 0) {
+        return existing;
+    }
+    return _add_type(p_name, p_friction, p_bounce, Ref<PhysicsMaterial>());
+}
+
+int SurfaceRegistry::find_type(const StringName &p_name) {
+    _ensure_types();
+    for (int i = 0; i < (int)types.size(); i++) {
+        if (types[i].name == p_name) return i;
+    }
+    return -1;
+}
+
+int SurfaceRegistry::get_type_count() {
+    _ensure_types();
+    return (int)types.size();
+}
+
+StringName SurfaceRegistry::get_type_name(int p_type) {
+    return _get(p_type).name;
+}
+
+float SurfaceRegistry::get_friction(int p_type) {
+    return _get(p_type).friction;
+}
+
+float SurfaceRegistry::get_bounce(int p_type) {
+    return _get(p_type).bounce;
+}
+
+Ref<PhysicsMaterial> SurfaceRegistry::get_material(int p_type) {
+    return _get(p_type).material;
+}
@@ -0,0 +1,90 @@
+#ifndef SURFACE_REGISTRY_H
+#define SURFACE_REGISTRY_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/classes/physics_material.hpp>
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include <vector>
+
+namespace godot {
+
+// Designer-made surface types: each PhysicsMaterial's resource_name is the type
+// name, its friction/bounce the type's values. Saved as a .tres and loaded by
+// SurfaceRegistry.
+class SurfaceLibrary : public Resource {
+    GDCLASS(SurfaceLibrary, Resource);
+
+private:
+    TypedArray<PhysicsMaterial> materials;
+
+protected:
+    static void _bind_methods();
+
+public:
+    void set_materials(const TypedArray<PhysicsMaterial> &p_materials);
+    TypedArray<PhysicsMaterial> get_materials() const;
+};
+
+// One shared PhysicsMaterial per surface type (flyweight). Ids 0-3 are the
+// built-in CustomSurface types (Ice, Sand, Metal, Rubber); custom types from
+// library_path or register_type() follow. Every body of a type uses the same
+// material, so the materials must be treated as read-only.
+class SurfaceRegistry : public Object {
+    GDCLASS(SurfaceRegistry, Object);
+
+public:
+    static const int BUILTIN_TYPE_COUNT = 4;
+
+private:
+    struct SurfaceType {
+        StringName name;
+        float friction = 0.5f;
+        float bounce = 0.3f;
+        Ref<PhysicsMaterial> material;
+        bool from_library = false;
+    };
+
+    static SurfaceRegistry *singleton;
+
+    String library_path = "res://surfaces/surface_library.tres";
+    std::vector<SurfaceType> types;
+    SurfaceType fallback;   // unknown ids
+    bool library_loaded = false;
+
+    void _ensure_types();
+    int _add_type(const StringName &p_name, float p_friction, float p_bounce, const Ref<PhysicsMaterial> &p_material);
+    const SurfaceType &_get(int p_type);
+
+protected:
+    static void _bind_methods();
+
+public:
+    static SurfaceRegistry *get_singleton();
+
+    SurfaceRegistry();
+    ~SurfaceRegistry();
+
+    // Drops the types the previous library added; the next lookup loads the
+    // new one. Ids of custom types after the built-ins can change
+    void set_library_path(const String &p_path);
+    String get_library_path() const;
+    // Adds the library's types; returns how many were new
+    int load_library(const Ref<SurfaceLibrary> &p_library);
+
+    // Returns the existing id when the name is taken
+    int register_type(const StringName &p_name, float p_friction, float p_bounce);
+    int find_type(const StringName &p_name);
+    int get_type_count();
+    StringName get_type_name(int p_type);
+    float get_friction(int p_type);
+    float get_bounce(int p_type);
+    Ref<PhysicsMaterial> get_material(int p_type);
+};
+
+} // namespace godot
+
+#endif // SURFACE_REGISTRY_H